@@ -38,6 +38,11 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
+/* Max number of frames read from the TAP device before they are handed
+ * to the stack
+ */
+#define RX_BURST 8
+
 #if defined(CONFIG_NET_VLAN)
 #define ETH_HDR_LEN sizeof(struct net_eth_vlan_hdr)
 #else
@@ -198,6 +203,20 @@ static int eth_send(struct device *dev, struct net_pkt *pkt)
 	return ret < 0 ? ret : 0;
 }
 
+static int eth_send_burst(struct device *dev, struct net_pkt **pkts,
+			  int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (eth_send(dev, pkts[i]) < 0) {
+			break;
+		}
+	}
+
+	return i;
+}
+
 static int eth_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -231,26 +250,27 @@ static inline struct net_if *get_iface(struct eth_context *ctx,
 #endif
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+static struct net_pkt *read_data(struct eth_context *ctx, int fd,
+				 struct net_if **iface)
 {
 	u16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-	struct net_if *iface;
 	struct net_pkt *pkt;
 	int count;
 
 	count = eth_read_data(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		return NULL;
 	}
 
 	pkt = net_pkt_rx_alloc_with_buffer(ctx->iface, count,
 					   AF_UNSPEC, 0, NET_BUF_TIMEOUT);
 	if (!pkt) {
-		return -ENOMEM;
+		return NULL;
 	}
 
 	if (net_pkt_write(pkt, ctx->recv, count)) {
-		return -ENOBUFS;
+		net_pkt_unref(pkt);
+		return NULL;
 	}
 
 #if defined(CONFIG_NET_VLAN)
@@ -276,33 +296,83 @@ static int read_data(struct eth_context *ctx, int fd)
 	}
 #endif
 
-	iface = get_iface(ctx, vlan_tag);
+	*iface = get_iface(ctx, vlan_tag);
 
 	LOG_DBG("Recv pkt %p len %d", pkt, count);
 
-	update_gptp(iface, pkt, false);
+	update_gptp(*iface, pkt, false);
 
-	if (net_recv_data(iface, pkt) < 0) {
-		net_pkt_unref(pkt);
+	return pkt;
+}
+
+static void deliver_data(struct net_if *iface, struct net_pkt **pkts,
+			 int count)
+{
+	int ret;
+
+	ret = net_recv_data_batch(iface, pkts, count);
+	if (ret < 0) {
+		ret = 0;
 	}
 
-	return 0;
+	while (ret < count) {
+		net_pkt_unref(pkts[ret++]);
+	}
+
+	/* Let the RX threads process them */
+	k_yield();
 }
 
-static void eth_rx(struct eth_context *ctx)
+/* Reads all the frames available, handing them to the stack in bursts
+ * of packets received on the same interface
+ */
+static void read_all_data(struct eth_context *ctx)
 {
+	struct net_pkt *pkts[RX_BURST];
+	struct net_if *burst_iface = NULL;
+	int count = 0;
 	int ret;
 
+	while (true) {
+		struct net_if *iface;
+		struct net_pkt *pkt;
+
+		ret = eth_wait_data(ctx->dev_fd);
+		if (ret < 0) {
+			if (ret != -EAGAIN) {
+				eth_stats_update_errors_rx(ctx->iface);
+			}
+
+			break;
+		}
+
+		pkt = read_data(ctx, ctx->dev_fd, &iface);
+		if (!pkt) {
+			break;
+		}
+
+		if (count == RX_BURST ||
+		    (count > 0 && iface != burst_iface)) {
+			deliver_data(burst_iface, pkts, count);
+			count = 0;
+		}
+
+		burst_iface = iface;
+		pkts[count++] = pkt;
+	}
+
+	if (count > 0) {
+		deliver_data(burst_iface, pkts, count);
+	}
+}
+
+static void eth_rx(struct eth_context *ctx)
+{
 	LOG_DBG("Starting ZETH RX thread");
 
 	while (1) {
 		if (net_if_is_up(ctx->iface)) {
-			ret = eth_wait_data(ctx->dev_fd);
-			if (!ret) {
-				read_data(ctx, ctx->dev_fd);
-			} else {
-				eth_stats_update_errors_rx(ctx->iface);
-			}
+			read_all_data(ctx);
 		}
 
 		k_sleep(K_MSEC(50));
@@ -490,6 +560,7 @@ static const struct ethernet_api eth_if_api = {
 	.start = eth_start_device,
 	.stop = eth_stop_device,
 	.send = eth_send,
+	.send_burst = eth_send_burst,
 
 #if defined(CONFIG_NET_VLAN)
 	.vlan_setup = vlan_setup,
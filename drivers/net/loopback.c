@@ -23,11 +23,116 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_if.h>
 
 #include <net/dummy.h>
+#include <net/loopback.h>
+#include <random/rand32.h>
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+static u32_t drop_ratio;
+
+int loopback_set_packet_drop_ratio(u32_t ratio)
+{
+	if (ratio > 1000) {
+		return -EINVAL;
+	}
+
+	drop_ratio = ratio;
+
+	return 0;
+}
+
+static bool loopback_drop(void)
+{
+	return drop_ratio && sys_rand32_get() % 1000 < drop_ratio;
+}
+#else
+#define loopback_drop() false
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_REORDER)
+/* How long a held packet waits for another one to overtake it */
+#define REORDER_TIMEOUT K_MSEC(10)
+
+static u32_t reorder_interval;
+static u32_t reorder_count;
+static struct net_pkt *held_pkt;
+static struct k_delayed_work reorder_timer;
+
+int loopback_set_packet_reorder_interval(u32_t interval)
+{
+	reorder_interval = interval;
+	reorder_count = 0U;
+
+	return 0;
+}
+
+static void loopback_release_held(void)
+{
+	struct net_pkt *pkt;
+	unsigned int key;
+
+	key = irq_lock();
+	pkt = held_pkt;
+	held_pkt = NULL;
+	irq_unlock(key);
+
+	if (!pkt) {
+		return;
+	}
+
+	k_delayed_work_cancel(&reorder_timer);
+
+	if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+		LOG_ERR("Data receive failed.");
+		net_pkt_unref(pkt);
+	}
+}
+
+static void reorder_timeout(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	loopback_release_held();
+}
+
+/* Holds back a packet so that the next one overtakes it */
+static bool loopback_reorder(struct net_pkt *pkt)
+{
+	bool hold = false;
+	unsigned int key;
+
+	if (!reorder_interval) {
+		return false;
+	}
+
+	key = irq_lock();
+
+	if (!held_pkt && ++reorder_count >= reorder_interval) {
+		reorder_count = 0U;
+		held_pkt = pkt;
+		hold = true;
+	}
+
+	irq_unlock(key);
+
+	if (hold) {
+		k_delayed_work_submit(&reorder_timer, REORDER_TIMEOUT);
+	}
+
+	return hold;
+}
+#else
+#define loopback_reorder(...) false
+#define loopback_release_held()
+#endif
 
 int loopback_dev_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_REORDER)
+	k_delayed_work_init(&reorder_timer, reorder_timeout);
+#endif
+
 	return 0;
 }
 
@@ -70,6 +175,12 @@ static int loopback_send(struct device *dev, struct net_pkt *pkt)
 		net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &addr);
 	}
 
+	/* A lost packet is still "sent" as far as the stack is concerned */
+	if (loopback_drop()) {
+		res = 0;
+		goto out;
+	}
+
 	/* We should simulate normal driver meaning that if the packet is
 	 * properly sent (which is always in this driver), then the packet
 	 * must be dropped. This is very much needed for TCP packets where
@@ -81,11 +192,19 @@ static int loopback_send(struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (loopback_reorder(cloned)) {
+		res = 0;
+		goto out;
+	}
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
 	}
 
+	/* Deliver the packet that was overtaken, if any */
+	loopback_release_held();
+
 out:
 	/* Let the receiving thread run now */
 	k_yield();
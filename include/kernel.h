@@ -453,6 +453,10 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	u8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds (or last held) the thread */
+	u8_t runq_cpu;
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -1565,6 +1569,33 @@ static inline u32_t z_impl_k_timer_remaining_get(struct k_timer *timer)
 	return (ticks > 0) ? (u32_t)__ticks_to_ms(ticks) : 0U;
 }
 
+/**
+ * @brief List the timeouts due to expire within a window.
+ *
+ * This routine collects the armed kernel timeouts (timers, sleeping or
+ * pending threads, delayed work...) that will expire within the next
+ * @a ticks system clock ticks, in a single pass under the timeout lock.
+ * It is intended for policy code such as tickless idle, power
+ * management or an application housekeeping thread that needs to know
+ * how busy the near future is, rather than only the next expiry.
+ *
+ * Timeouts are stored in expiry order with the default timeout queue,
+ * but in no particular order with CONFIG_TIMEOUT_WHEEL.  The pointers
+ * are only a snapshot: the timeouts may expire or be aborted as soon as
+ * this routine returns, so only use them for identification, e.g. by
+ * comparing them with the timeout of a k_timer and then calling
+ * k_timer_remaining_get().
+ *
+ * @param ticks Window length, in system clock ticks.
+ * @param list  Array receiving the timeouts found.
+ * @param max   Number of entries available in @a list.
+ *
+ * @return Number of timeouts expiring within the window, which may be
+ *         larger than @a max if @a list was too small to hold all of them.
+ */
+extern int k_timeout_expiring_within(s32_t ticks, struct _timeout **list,
+				     int max);
+
 /**
  * @brief Associate user-specific data with a timer.
  *
@@ -3817,6 +3848,17 @@ extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Per-CPU cache of free blocks, chained through the blocks themselves
+ * like the slab free list
+ */
+struct z_mem_slab_mag {
+	struct k_spinlock lock;
+	char *list;
+	u32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	u32_t num_blocks;
@@ -3824,6 +3866,11 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	u32_t num_used;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct z_mem_slab_mag mag[CONFIG_MP_NUM_CPUS];
+	/* Threads about to wait or waiting for a block */
+	u32_t mag_waiters;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 };
@@ -3842,6 +3889,10 @@ struct k_mem_slab {
 
 #define K_MEM_SLAB_INITIALIZER DEPRECATED_MACRO _K_MEM_SLAB_INITIALIZER
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+extern u32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -3950,7 +4001,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	return slab->num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -3966,7 +4021,7 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
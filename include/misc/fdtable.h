@@ -140,6 +140,7 @@ enum {
 	ZFD_IOCTL_LSEEK,
 	ZFD_IOCTL_POLL_PREPARE,
 	ZFD_IOCTL_POLL_UPDATE,
+	ZFD_IOCTL_EPOLL_SUPPORTED,
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_TLSF_H_
+#define ZEPHYR_INCLUDE_MISC_TLSF_H_
+
+/**
+ * @file
+ * @brief Two-Level Segregated Fit (TLSF) heap
+ *
+ * A general purpose allocator for arbitrary block sizes with O(1)
+ * allocation and free, and low fragmentation: unlike the buddy
+ * allocator behind sys_mem_pool, blocks are not rounded up to a power
+ * of four, and freed blocks are immediately merged with their free
+ * neighbors.
+ *
+ * Free blocks are kept in segregated lists: a first level per power
+ * of two, each split in Z_TLSF_SL_COUNT linear second level ranges.
+ * Two levels of bitmaps locate a suitable non-empty list with a
+ * couple of find-first-set operations.  Each block carries a single
+ * word of overhead while allocated.
+ *
+ * The bare heap (struct sys_tlsf) does no locking.  struct
+ * sys_tlsf_pool wraps one with a sys_mutex so it can be shared by
+ * user mode threads, like sys_mem_pool.
+ */
+
+#include <kernel.h>
+#include <misc/mutex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Alignment of the memory returned, 8 bytes on every architecture so
+ * that malloc() suits 64-bit integers and doubles
+ */
+#define Z_TLSF_ALIGN_LOG2 3
+
+#define Z_TLSF_SL_LOG2 3
+#define Z_TLSF_SL_COUNT (1 << Z_TLSF_SL_LOG2)
+#define Z_TLSF_FL_SHIFT (Z_TLSF_SL_LOG2 + Z_TLSF_ALIGN_LOG2)
+#define Z_TLSF_FL_MAX CONFIG_SYS_TLSF_MAX_BLOCK_LOG2
+#define Z_TLSF_FL_COUNT (Z_TLSF_FL_MAX - Z_TLSF_FL_SHIFT + 1)
+
+struct z_tlsf_block;
+
+struct sys_tlsf {
+	/* Non-empty first level lists */
+	u32_t fl_bitmap;
+
+	/* Non-empty second level lists, per first level */
+	u32_t sl_bitmap[Z_TLSF_FL_COUNT];
+
+	/* Free list heads */
+	struct z_tlsf_block *blocks[Z_TLSF_FL_COUNT][Z_TLSF_SL_COUNT];
+
+	/* Arena bounds */
+	u8_t *start;
+	u8_t *end;
+
+	/* Payload bytes currently held by free blocks */
+	size_t free_bytes;
+};
+
+/** @brief TLSF heap usage snapshot */
+struct sys_tlsf_stats {
+	/** Bytes available for allocation, across all free blocks */
+	size_t free_bytes;
+	/** Bytes not available: allocated blocks and heap overhead */
+	size_t used_bytes;
+	/** Size of the largest single allocation that would succeed */
+	size_t max_free_block;
+};
+
+/**
+ * @brief Initialize a TLSF heap
+ *
+ * The whole of @a mem (minus a few words of bookkeeping and
+ * alignment) becomes one free block.  Individual blocks are limited to
+ * 2^CONFIG_SYS_TLSF_MAX_BLOCK_LOG2 bytes, any memory beyond that is
+ * ignored.
+ *
+ * @param h Heap to initialize
+ * @param mem Arena backing the heap
+ * @param bytes Size of @a mem
+ */
+void sys_tlsf_init(struct sys_tlsf *h, void *mem, size_t bytes);
+
+/**
+ * @brief Allocate memory from a TLSF heap
+ *
+ * @param h Heap to allocate from
+ * @param bytes Number of bytes requested
+ * @return Pointer aligned to 8 bytes, or NULL if no free block
+ *         is large enough (or @a bytes is zero)
+ */
+void *sys_tlsf_alloc(struct sys_tlsf *h, size_t bytes);
+
+/**
+ * @brief Free memory allocated from a TLSF heap
+ *
+ * It is safe to pass NULL, in which case it is a no-op.
+ *
+ * @param h Heap @a ptr was allocated from
+ * @param ptr Memory previously returned by sys_tlsf_alloc()
+ */
+void sys_tlsf_free(struct sys_tlsf *h, void *ptr);
+
+/**
+ * @brief Resize memory allocated from a TLSF heap
+ *
+ * Grows in place when the block (or its free physical neighbor) is
+ * large enough, otherwise moves the data to a new block.
+ *
+ * @param h Heap @a ptr was allocated from
+ * @param ptr Memory previously returned by sys_tlsf_alloc(), or NULL
+ * @param bytes New size
+ * @return Pointer to the resized memory, or NULL on failure in which
+ *         case @a ptr is left untouched
+ */
+void *sys_tlsf_realloc(struct sys_tlsf *h, void *ptr, size_t bytes);
+
+/**
+ * @brief Get the usable size of an allocated block
+ *
+ * @param ptr Memory previously returned by sys_tlsf_alloc()
+ * @return Number of bytes that can be used at @a ptr, at least the
+ *         size that was requested
+ */
+size_t sys_tlsf_usable_size(void *ptr);
+
+/**
+ * @brief Get heap usage statistics
+ *
+ * Runs in constant time, except for finding the largest free block
+ * which walks the single list holding the largest blocks.
+ *
+ * @param h Heap to inspect
+ * @param stats Filled with the current usage
+ */
+void sys_tlsf_stats_get(struct sys_tlsf *h, struct sys_tlsf_stats *stats);
+
+/**
+ * @brief Check whether memory belongs to a TLSF heap
+ *
+ * @param h Heap to check
+ * @param ptr Any pointer
+ * @return true if @a ptr lies inside the arena of @a h
+ */
+static inline bool sys_tlsf_contains(struct sys_tlsf *h, void *ptr)
+{
+	return (u8_t *)ptr >= h->start && (u8_t *)ptr < h->end;
+}
+
+struct sys_tlsf_pool {
+	struct sys_tlsf heap;
+	struct sys_mutex mutex;
+	void *buf;
+	size_t size;
+};
+
+/**
+ * @brief Statically define a TLSF memory pool
+ *
+ * This is the TLSF counterpart of SYS_MEM_POOL_DEFINE(): the pool can
+ * live in an application memory partition and be used from user mode.
+ * It must be initialized with sys_tlsf_pool_init() before use.
+ *
+ * @param name Name of the memory pool.
+ * @param sz Size of the pool's arena (in bytes).
+ * @param section Destination binary section for pool data
+ */
+#define SYS_TLSF_POOL_DEFINE(name, sz, section)				\
+	char __aligned(sizeof(void *)) Z_GENERIC_SECTION(section)	\
+		_tlsf_buf_##name[sz];					\
+	Z_GENERIC_SECTION(section) struct sys_tlsf_pool name = {	\
+		.buf = _tlsf_buf_##name,				\
+		.size = sz,						\
+	}
+
+/**
+ * @brief Initialize a TLSF memory pool
+ *
+ * @param p Memory pool defined with SYS_TLSF_POOL_DEFINE()
+ */
+static inline void sys_tlsf_pool_init(struct sys_tlsf_pool *p)
+{
+	sys_mutex_init(&p->mutex);
+	sys_tlsf_init(&p->heap, p->buf, p->size);
+}
+
+/**
+ * @brief Allocate memory from a TLSF memory pool
+ *
+ * This cannot be called from interrupt context.
+ *
+ * @param p Address of the memory pool
+ * @param size Requested size of the memory block
+ * @return A pointer to the requested memory, or NULL if none is available
+ */
+void *sys_tlsf_pool_alloc(struct sys_tlsf_pool *p, size_t size);
+
+/**
+ * @brief Free memory allocated from a TLSF memory pool
+ *
+ * It is safe to pass NULL to this function, in which case it is a no-op.
+ *
+ * @param p Address of the memory pool
+ * @param ptr Pointer to previously allocated memory
+ */
+void sys_tlsf_pool_free(struct sys_tlsf_pool *p, void *ptr);
+
+/**
+ * @brief Resize memory allocated from a TLSF memory pool
+ *
+ * @param p Address of the memory pool
+ * @param ptr Pointer to previously allocated memory, or NULL
+ * @param size New size
+ * @return Pointer to the resized memory, or NULL if none is available
+ */
+void *sys_tlsf_pool_realloc(struct sys_tlsf_pool *p, void *ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_TLSF_H_ */
@@ -716,8 +716,30 @@ extern const struct net_buf_data_cb net_buf_var_cb;
  * @param _destroy   Optional destroy callback when buffer is freed.
  */
 #define NET_BUF_POOL_VAR_DEFINE(_name, _count, _data_size, _destroy)          \
+	NET_BUF_POOL_VAR_BLOCK_DEFINE(_name, _count, _data_size, 1, _destroy)
+
+/**
+ * @def NET_BUF_POOL_VAR_BLOCK_DEFINE
+ * @brief Define a new pool for buffers with variable size payloads
+ *
+ * Same as NET_BUF_POOL_VAR_DEFINE(), but the memory available for data
+ * payloads is split in _block_count blocks of _block_size bytes each.
+ * A single payload cannot be larger than a block (minus a few bytes of
+ * bookkeeping), but several large payloads can then be allocated at the
+ * same time, whereas the block of a NET_BUF_POOL_VAR_DEFINE() pool
+ * covers all of its memory.
+ *
+ * @param _name        Name of the pool variable.
+ * @param _count       Number of buffers in the pool.
+ * @param _block_size  Size of the largest payload allocation.
+ * @param _block_count Number of blocks of _block_size bytes.
+ * @param _destroy     Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_VAR_BLOCK_DEFINE(_name, _count, _block_size,            \
+				      _block_count, _destroy)                 \
 	static struct net_buf _net_buf_##_name[_count] __noinit;              \
-	K_MEM_POOL_DEFINE(net_buf_mem_pool_##_name, 16, _data_size, 1, 4);    \
+	K_MEM_POOL_DEFINE(net_buf_mem_pool_##_name, 16, _block_size,          \
+			  _block_count, 4);                                   \
 	static const struct net_buf_data_alloc net_buf_data_alloc_##_name = { \
 		.cb = &net_buf_var_cb,                                        \
 		.alloc_data = &net_buf_mem_pool_##_name,                      \
@@ -120,6 +120,12 @@ enum ethernet_hw_caps {
 
 	/** Link Layer Discovery Protocol supported */
 	ETHERNET_LLDP			= BIT(13),
+
+	/** TCP segmentation offload supported: packets with a non zero
+	 * net_pkt_gso_size() can carry more data than the MSS, which the
+	 * hardware sends in segments of net_pkt_gso_size() bytes.
+	 */
+	ETHERNET_HW_TSO			= BIT(14),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -257,6 +263,15 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(struct device *dev, struct net_pkt *pkt);
+
+	/** Send several network packets at once. This is optional, if set
+	 * the L2 hands over the packets queued for transmission in bursts
+	 * of up to CONFIG_NET_ETHERNET_TX_BURST_SIZE packets. Returns the
+	 * number of packets sent, from the start of the array, or <0 if
+	 * error. The packets are owned by the caller in any case.
+	 */
+	int (*send_burst)(struct device *dev, struct net_pkt **pkts,
+			  int count);
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -364,6 +379,25 @@ struct ethernet_context {
 	s8_t vlan_enabled;
 #endif
 
+#if CONFIG_NET_ETHERNET_TX_BURST_SIZE > 0
+	struct {
+		/** Hands the staged packets over to the driver, queued
+		 * behind them in the TX queue.
+		 */
+		struct k_work work;
+
+		/** Protects the staged packets */
+		struct k_spinlock lock;
+
+		/** Packets ready to be sent */
+		struct net_pkt *pkts[CONFIG_NET_ETHERNET_TX_BURST_SIZE];
+		int count;
+
+		/** Traffic class of the TX queue the work was submitted to */
+		u8_t tc;
+	} tx_burst;
+#endif
+
 	/** Is this context already initialized */
 	bool is_init;
 };
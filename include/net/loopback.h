@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Network loopback interface
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+#define ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+/**
+ * @brief Drop some of the packets sent through the loopback interface
+ *
+ * Each packet is dropped independently, with the given probability.
+ *
+ * @param ratio Ratio of packets to drop, in 1/1000, 0 to drop none
+ *
+ * @return 0 on success, -EINVAL if @a ratio is above 1000
+ */
+int loopback_set_packet_drop_ratio(u32_t ratio);
+#endif
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_REORDER)
+/**
+ * @brief Reorder some of the packets sent through the loopback interface
+ *
+ * Every @a interval packet is held back and delivered right after the
+ * next one, or after a short delay if no other packet is sent.
+ *
+ * @param interval Number of packets between two reorderings, 0 to
+ *        deliver all packets in order
+ *
+ * @return 0 on success
+ */
+int loopback_set_packet_reorder_interval(u32_t interval);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_LOOPBACK_H_ */
@@ -184,6 +184,8 @@ struct net_conn_handle;
 
 struct tls_context;
 
+struct zsock_epoll_entry;
+
 /**
  * Note that we do not store the actual source IP address in the context
  * because the address is already be set in the network interface struct.
@@ -267,6 +269,11 @@ struct net_context {
 	/** TLS context information */
 	struct tls_context *tls;
 #endif /* CONFIG_NET_SOCKETS_SOCKOPT_TLS */
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Interest set registration, if any */
+	struct zsock_epoll_entry *epoll;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -864,6 +871,7 @@ int net_context_update_recv_wnd(struct net_context *context,
 enum net_context_option {
 	NET_OPT_PRIORITY	= 1,
 	NET_OPT_TIMESTAMP	= 2,
+	NET_OPT_TCP_NODELAY	= 3,
 };
 
 /**
@@ -86,6 +86,25 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device drivers to push several received
+ * network packets up in the network stack at once.
+ *
+ * This is the same as calling net_recv_data() for each packet, but the
+ * interface is checked and the packets are queued for processing in one
+ * go, which is cheaper for drivers that collect several packets per
+ * interrupt.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of network packets.
+ * @param count Number of packets in @a pkts.
+ *
+ * @return Number of packets that were taken, from the start of @a pkts,
+ * <0 if error. The caller still owns the packets that were not taken.
+ */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			int count);
+
 /**
  * @brief Send data to network.
  *
@@ -144,6 +144,15 @@ struct net_pkt {
 					     */
 	};
 
+	u8_t l2_hdr_pushed : 1;	/* For outgoing packet: is the L2 header
+				 * in the headroom of the first buffer,
+				 * rather than in a buffer of its own.
+				 */
+	u8_t chksum_verified : 1; /* For incoming packet: have the L3 and
+				   * L4 checksums already been verified,
+				   * by the hardware or the driver.
+				   */
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -188,6 +197,13 @@ struct net_pkt {
 	u8_t ipv6_next_hdr;	/* What is the very first next header */
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* For outgoing TCP packet: amount of data per segment when L2
+	 * cuts the packet in MSS sized segments, 0 if it is not to be cut.
+	 */
+	u16_t gso_size;
+#endif
+
 #if defined(CONFIG_IEEE802154)
 	u8_t ieee802154_rssi; /* Received Signal Strength Indication */
 	u8_t ieee802154_lqi;  /* Link Quality Indicator */
@@ -664,6 +680,31 @@ static inline void net_pkt_set_vlan_tci(struct net_pkt *pkt, u16_t tci)
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 static inline struct net_ptp_time *net_pkt_timestamp(struct net_pkt *pkt)
 {
@@ -807,6 +848,28 @@ static inline void net_pkt_set_lldp(struct net_pkt *pkt, bool is_lldp)
 }
 #endif /* CONFIG_NET_LLDP */
 
+static inline bool net_pkt_is_chksum_verified(struct net_pkt *pkt)
+{
+	return pkt->chksum_verified;
+}
+
+static inline void net_pkt_set_chksum_verified(struct net_pkt *pkt,
+					       bool verified)
+{
+	pkt->chksum_verified = verified;
+}
+
+static inline bool net_pkt_is_l2_hdr_pushed(struct net_pkt *pkt)
+{
+	return pkt->l2_hdr_pushed;
+}
+
+static inline void net_pkt_set_l2_hdr_pushed(struct net_pkt *pkt,
+					     bool pushed)
+{
+	pkt->l2_hdr_pushed = pushed;
+}
+
 #define NET_IPV6_HDR(pkt) ((struct net_ipv6_hdr *)net_pkt_ip_data(pkt))
 #define NET_IPV4_HDR(pkt) ((struct net_ipv4_hdr *)net_pkt_ip_data(pkt))
 
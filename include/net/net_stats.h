@@ -159,6 +159,15 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of application writes merged into a pending segment. */
+	net_stats_t coalesced;
+
+	/** Number of received segments whose ACK was delayed. */
+	net_stats_t delayed_ack;
+
+	/** Number of received segments queued out of order. */
+	net_stats_t ooo_queued;
 };
 
 /**
@@ -218,6 +227,22 @@ struct net_stats_tc {
 	} recv[NET_TC_RX_COUNT];
 };
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+/**
+ * @brief Flow steered Rx queue statistics
+ */
+struct net_stats_rxq {
+	struct {
+		/** Number of packets steered to the queue */
+		net_stats_t pkts;
+		/** Number of bytes steered to the queue */
+		net_stats_t bytes;
+		/** Number of times the queue thread dequeued packets */
+		net_stats_t batches;
+	} queue[CONFIG_NET_RX_QUEUE_COUNT];
+};
+#endif /* CONFIG_NET_RX_MULTI_QUEUE */
+
 /**
  * @brief All network statistics in one struct.
  */
@@ -273,6 +298,11 @@ struct net_stats {
 	/** Traffic class statistics */
 	struct net_stats_tc tc;
 #endif
+
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+	/** Rx queue statistics */
+	struct net_stats_rxq rxq;
+#endif
 };
 
 /**
@@ -304,6 +304,48 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_pkt;
+
+/**
+ * @brief Receive data from a socket without copying it
+ *
+ * @details
+ * Zephyr extension to the BSD Sockets API: instead of copying received
+ * data to a caller-supplied buffer, the network packet holding it is
+ * dequeued from the socket and handed over to the caller, which must
+ * return it with zsock_recv_pkt_release() once done.
+ *
+ * The data starts at the packet cursor and can be consumed with
+ * net_pkt_read() or by walking the net_buf fragments from
+ * pkt->cursor.buf directly.  For stream sockets, this is whatever the
+ * head packet still holds, possibly after a partial zsock_recv(); the
+ * receive window is reopened as soon as the packet is handed out.  For
+ * datagram sockets, the source address can be obtained from the IP
+ * header in the packet.
+ *
+ * ZSOCK_MSG_DONTWAIT is supported, ZSOCK_MSG_PEEK is not.  Sockets
+ * whose data does not live in network packets (e.g. TLS) fail with
+ * EOPNOTSUPP.
+ *
+ * As the packet is kernel memory, this is not available to user mode
+ * threads.
+ *
+ * @param sock Socket to receive from
+ * @param pkt Filled with the received packet on success
+ * @param flags ZSOCK_MSG_* flags
+ *
+ * @return Number of data bytes in @a pkt from its cursor on, 0 on
+ *         end of stream (with @a pkt set to NULL), or -1 with errno set
+ */
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags);
+
+/**
+ * @brief Release a packet obtained from zsock_recv_pkt()
+ *
+ * @param pkt Packet returned by zsock_recv_pkt()
+ */
+void zsock_recv_pkt_release(struct net_pkt *pkt);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -334,6 +376,90 @@ __syscall int zsock_fcntl(int sock, int cmd, int flags);
  */
 __syscall int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
 
+/** zsock_epoll_ctl: Register a socket in an interest set */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a socket from an interest set */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a registered socket */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data associated with a socket in an interest set */
+union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	u32_t u32;
+	u64_t u64;
+};
+
+/** Event registration and result for the zsock_epoll_* functions */
+struct zsock_epoll_event {
+	/** ZSOCK_POLL* flags */
+	u32_t events;
+	/** Returned as is by zsock_epoll_wait() */
+	union zsock_epoll_data data;
+};
+
+/**
+ * @brief Create a socket interest set
+ *
+ * @details
+ * @rststar
+ * Zephyr counterpart of Linux ``epoll_create()``: sockets are registered
+ * once with :c:func:`zsock_epoll_ctl()`, and :c:func:`zsock_epoll_wait()`
+ * then only looks at the sockets which became ready, instead of every
+ * socket passed to each :c:func:`zsock_poll()` call.
+ * Readiness is level-triggered.  The set is released with
+ * :c:func:`zsock_close()`.
+ * Requires :option:`CONFIG_NET_SOCKETS_EPOLL`.
+ * @endrststar
+ *
+ * @return File descriptor of the set, or -1 with errno set
+ */
+__syscall int zsock_epoll_create(void);
+
+/**
+ * @brief Add, change or remove a socket in an interest set
+ *
+ * @details
+ * @rststar
+ * Works like Linux ``epoll_ctl()``, with ZSOCK_POLLIN and ZSOCK_POLLOUT
+ * as the supported events.  A socket can belong to one set at a time,
+ * and leaves it automatically when closed.  TLS sockets are not
+ * supported.
+ * @endrststar
+ *
+ * @param epfd Interest set, from zsock_epoll_create()
+ * @param op ZSOCK_EPOLL_CTL_* operation
+ * @param fd Socket to operate on
+ * @param event Events of interest and user data, unused for
+ *              ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for sockets of an interest set to become ready
+ *
+ * @details
+ * @rststar
+ * Works like Linux ``epoll_wait()``.  Sockets that stay ready are
+ * reported again by the next call, after the other ready ones.
+ * @endrststar
+ *
+ * @param epfd Interest set, from zsock_epoll_create()
+ * @param events Filled with the ready sockets' events and data
+ * @param maxevents Size of @a events
+ * @param timeout Wait time in milliseconds, 0 to return immediately,
+ *                negative to wait forever
+ *
+ * @return Number of entries filled in @a events (0 on timeout), or -1
+ *         with errno set
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
 /**
  * @brief Get various socket options
  *
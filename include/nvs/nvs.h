@@ -29,6 +29,36 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection statistics
+ */
+struct nvs_gc_stats {
+	/** Number of sectors garbage collected */
+	u32_t sectors;
+	/** Number of entries copied by garbage collection */
+	u32_t moved;
+	/** Number of writes that waited for garbage collection */
+	u32_t stalls;
+	/** Total time writes waited for garbage collection, in microseconds */
+	u32_t stall_us;
+	/** Longest wait of a write for garbage collection, in microseconds */
+	u32_t max_stall_us;
+	/** Garbage collection of a sector is in progress */
+	bool active;
+	/** Upper bound of the bytes left to copy by the garbage collection
+	 * in progress
+	 */
+	u32_t remaining;
+};
+
+/* Garbage collection of a sector in progress */
+struct nvs_gc_state {
+	u32_t addr;		/* next ate to go through */
+	u32_t stop_addr;	/* oldest ate of the sector */
+	u32_t reserve;		/* space left needed for copies */
+	bool active;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -42,6 +72,13 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Address of the latest allocation table entry, per
+ * hash bucket of ids (only with CONFIG_NVS_LOOKUP_CACHE)
+ * @param gc_stats Garbage collection statistics
+ * @param gc_state Garbage collection in progress (only with
+ * CONFIG_NVS_INCREMENTAL_GC)
+ * @param gc_work Work item running garbage collection (only with
+ * CONFIG_NVS_INCREMENTAL_GC)
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -56,6 +93,14 @@ struct nvs_fs {
 
 	struct k_mutex nvs_lock;
 	struct device *flash_device;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	u32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+	struct nvs_gc_stats gc_stats;
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	struct nvs_gc_state gc_state;
+	struct k_work gc_work;
+#endif
 };
 
 /**
@@ -169,6 +214,19 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_stats_get
+ *
+ * Get the garbage collection statistics of the file system. Counters are
+ * kept from the file system initialization on.
+ *
+ * @param fs Pointer to file system
+ * @param stats Filled with the garbage collection statistics
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats);
+
 /**
  * @}
  */
@@ -44,6 +44,9 @@ struct settings_handler {
 	sys_snode_t node;
 	/**< Linked list node info for module internal usage. */
 
+	sys_snode_t index_node;
+	/**< Handler index node info for module internal usage. */
+
 	char *name;
 	/**< Name of subtree. */
 
@@ -118,6 +121,20 @@ int settings_register(struct settings_handler *cf);
  */
 int settings_load(void);
 
+/**
+ * Load serialized items of a single subtree from registered persistence
+ * sources. Only the handler of that subtree is called, for the encountered
+ * values whose name is @p subtree or starts with @p subtree followed by
+ * @ref SETTINGS_NAME_SEPARATOR. Other items are skipped by the backends
+ * after reading no more than the beginning of their name. The handler's
+ * commit callback is called afterwards.
+ *
+ * @param subtree Name of the subtree to load, e.g. "bt" or "bt/keys".
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_load_subtree(const char *subtree);
+
 /**
  * Save currently running serialized items. All serialized items which are different
  * from currently persisted values will be saved.
@@ -211,6 +211,8 @@ struct _timeout {
 	sys_dnode_t node;
 	s32_t dticks;
 	_timeout_func_t fn;
+	/* absolute tick at which the timeout expires */
+	u64_t expiry;
 };
 
 #ifdef __cplusplus
@@ -110,6 +110,11 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* threads ready to run on this CPU */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -13,6 +13,9 @@
 #include <misc/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <misc/printk.h>
+#include <stats.h>
+#include <string.h>
 
 extern struct k_mem_slab _k_mem_slab_list_start[];
 extern struct k_mem_slab _k_mem_slab_list_end[];
@@ -23,6 +26,185 @@ static struct k_spinlock lock;
 struct k_mem_slab *_trace_list_k_mem_slab;
 #endif	/* CONFIG_OBJECT_TRACING */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Blocks move between a CPU magazine and the shared free list half a
+ * magazine at a time, so a CPU alternating between allocating and
+ * freeing around the limit doesn't bounce on the shared lock.
+ */
+#define MAG_SIZE CONFIG_MEM_SLAB_MAGAZINE_SIZE
+#define MAG_BATCH MAX(1, MAG_SIZE / 2)
+
+#ifdef CONFIG_STATS
+/* One stats group per CPU ("slab_mag<cpu>"), aggregated over all
+ * slabs, so counters are only ever touched by their own CPU
+ */
+STATS_SECT_START(mem_slab_mag)
+STATS_SECT_ENTRY(alloc_hit)
+STATS_SECT_ENTRY(alloc_miss)
+STATS_SECT_ENTRY(free_hit)
+STATS_SECT_ENTRY(free_miss)
+STATS_SECT_ENTRY(refill)
+STATS_SECT_ENTRY(drain)
+STATS_SECT_END;
+
+STATS_NAME_START(mem_slab_mag)
+STATS_NAME(mem_slab_mag, alloc_hit)
+STATS_NAME(mem_slab_mag, alloc_miss)
+STATS_NAME(mem_slab_mag, free_hit)
+STATS_NAME(mem_slab_mag, free_miss)
+STATS_NAME(mem_slab_mag, refill)
+STATS_NAME(mem_slab_mag, drain)
+STATS_NAME_END(mem_slab_mag);
+
+static STATS_SECT_DECL(mem_slab_mag) mag_stats[CONFIG_MP_NUM_CPUS];
+static char mag_stats_names[CONFIG_MP_NUM_CPUS][sizeof("slab_mag255")];
+
+static void mag_stats_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		snprintk(mag_stats_names[i], sizeof(mag_stats_names[i]),
+			 "slab_mag%d", i);
+		(void)STATS_INIT_AND_REG(mag_stats[i], STATS_SIZE_32,
+					 mag_stats_names[i]);
+	}
+}
+#else
+static inline void mag_stats_init(void) { }
+#endif /* CONFIG_STATS */
+
+/* Moves up to MAG_BATCH blocks from the slab free list to a magazine */
+static void mag_refill(struct k_mem_slab *slab, struct z_mem_slab_mag *mag)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	while (mag->count < MAG_BATCH && slab->free_list != NULL) {
+		char *block = slab->free_list;
+
+		slab->free_list = *(char **)block;
+		*(char **)block = mag->list;
+		mag->list = block;
+		mag->count++;
+		slab->num_used++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/* Returns up to count blocks from a magazine to the slab free list */
+static void mag_drain(struct k_mem_slab *slab, struct z_mem_slab_mag *mag,
+		      u32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (u32_t i = 0U; i < count && mag->list != NULL; i++) {
+		char *block = mag->list;
+
+		mag->list = *(char **)block;
+		mag->count--;
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/* A magazine is normally only used by its own CPU, but its lock lets
+ * mag_steal() empty it from another one.  Magazine locks are always
+ * taken before the slab lock.
+ */
+static bool mag_alloc(struct k_mem_slab *slab, void **mem)
+{
+	int irq = z_arch_irq_lock();
+	int cpu = _current_cpu->id;
+	struct z_mem_slab_mag *mag = &slab->mag[cpu];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool ret = false;
+
+	if (mag->count == 0U) {
+		STATS_INC(mag_stats[cpu], alloc_miss);
+		mag_refill(slab, mag);
+		if (mag->count != 0U) {
+			STATS_INC(mag_stats[cpu], refill);
+		}
+	} else {
+		STATS_INC(mag_stats[cpu], alloc_hit);
+	}
+
+	if (mag->count != 0U) {
+		*mem = mag->list;
+		mag->list = *(char **)mag->list;
+		mag->count--;
+		ret = true;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	z_arch_irq_unlock(irq);
+
+	return ret;
+}
+
+static bool mag_free(struct k_mem_slab *slab, void *block)
+{
+	int irq = z_arch_irq_lock();
+	int cpu = _current_cpu->id;
+	struct z_mem_slab_mag *mag = &slab->mag[cpu];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	bool ret = false;
+
+	/* Threads may be waiting for a block: let the regular path
+	 * hand it over.  A thread about to wait counts itself before
+	 * stealing from the magazines, so it either sees this block in
+	 * the magazine or this check sees it.
+	 */
+	if (slab->mag_waiters != 0U) {
+		goto out;
+	}
+
+	if (mag->count == MAG_SIZE) {
+		STATS_INC(mag_stats[cpu], free_miss);
+		STATS_INC(mag_stats[cpu], drain);
+		mag_drain(slab, mag, MAG_BATCH);
+	} else {
+		STATS_INC(mag_stats[cpu], free_hit);
+	}
+
+	*(char **)block = mag->list;
+	mag->list = block;
+	mag->count++;
+	ret = true;
+
+out:
+	k_spin_unlock(&mag->lock, key);
+	z_arch_irq_unlock(irq);
+
+	return ret;
+}
+
+/* Returns the blocks cached by all CPUs to the slab free list */
+static void mag_steal(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct z_mem_slab_mag *mag = &slab->mag[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+		mag_drain(slab, mag, mag->count);
+		k_spin_unlock(&mag->lock, key);
+	}
+}
+
+u32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	u32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->mag[i].count;
+	}
+
+	return cached;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -59,6 +241,10 @@ static int init_mem_slab_module(struct device *dev)
 
 	struct k_mem_slab *slab;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	mag_stats_init();
+#endif
+
 	for (slab = _k_mem_slab_list_start;
 	     slab < _k_mem_slab_list_end;
 	     slab++) {
@@ -83,6 +269,10 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	(void)memset(slab->mag, 0, sizeof(slab->mag));
+	slab->mag_waiters = 0U;
+#endif
 	create_free_list(slab);
 	z_waitq_init(&slab->wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
@@ -90,7 +280,19 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	z_object_init(slab);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+static void mag_waiters_add(struct k_mem_slab *slab, s32_t timeout, int n)
+{
+	if (timeout != K_NO_WAIT) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		slab->mag_waiters += n;
+		k_spin_unlock(&lock, key);
+	}
+}
+#endif
+
+static int mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	int result;
@@ -123,8 +325,39 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 	return result;
 }
 
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	int result;
+
+	if (mag_alloc(slab, mem)) {
+		return 0;
+	}
+
+	/* Frees bypass the magazines until this thread is done, so
+	 * that no block gets stuck in one while it waits.
+	 */
+	mag_waiters_add(slab, timeout, 1);
+	mag_steal(slab);
+
+	result = mem_slab_alloc(slab, mem, timeout);
+
+	mag_waiters_add(slab, timeout, -1);
+
+	return result;
+#else
+	return mem_slab_alloc(slab, mem, timeout);
+#endif
+}
+
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (mag_free(slab, *mem)) {
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -10,6 +10,7 @@
 #include <init.h>
 #include <string.h>
 #include <misc/__assert.h>
+#include <misc/tlsf.h>
 #include <stdbool.h>
 
 /* Linker-defined symbols bound the static pool structs */
@@ -18,6 +19,12 @@ extern struct k_mem_pool _k_mem_pool_list_end[];
 
 static struct k_spinlock lock;
 
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+static char __aligned(sizeof(void *)) heap_buf[CONFIG_HEAP_MEM_POOL_SIZE];
+static struct sys_tlsf heap;
+static struct k_spinlock heap_lock;
+#endif
+
 static struct k_mem_pool *get_pool(int id)
 {
 	return &_k_mem_pool_list_start[id];
@@ -161,6 +168,16 @@ void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
 
 void k_free(void *ptr)
 {
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+	if (sys_tlsf_contains(&heap, ptr)) {
+		k_spinlock_key_t key = k_spin_lock(&heap_lock);
+
+		sys_tlsf_free(&heap, ptr);
+		k_spin_unlock(&heap_lock, key);
+		return;
+	}
+#endif
+
 	if (ptr != NULL) {
 		/* point to hidden block descriptor at start of block */
 		ptr = (char *)ptr - sizeof(struct k_mem_block_id);
@@ -179,6 +196,34 @@ void k_free(void *ptr)
  * that has the address of the associated memory pool struct.
  */
 
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+/* Threads name their resource pool with a k_mem_pool pointer: the TLSF
+ * heap is not one, so it gets a stand-in address that z_thread_malloc()
+ * recognizes and routes to k_malloc().  It is never dereferenced.
+ */
+#define _HEAP_MEM_POOL ((struct k_mem_pool *)&heap)
+
+void *k_malloc(size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap_lock);
+	void *ret = sys_tlsf_alloc(&heap, size);
+
+	k_spin_unlock(&heap_lock, key);
+
+	return ret;
+}
+
+static int init_heap(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	sys_tlsf_init(&heap, heap_buf, sizeof(heap_buf));
+
+	return 0;
+}
+
+SYS_INIT(init_heap, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#else
 K_MEM_POOL_DEFINE(_heap_mem_pool, CONFIG_HEAP_MEM_POOL_MIN_SIZE,
 		  CONFIG_HEAP_MEM_POOL_SIZE, 1, 4);
 #define _HEAP_MEM_POOL (&_heap_mem_pool)
@@ -187,6 +232,7 @@ void *k_malloc(size_t size)
 {
 	return k_mem_pool_malloc(_HEAP_MEM_POOL, size);
 }
+#endif /* CONFIG_HEAP_MEM_POOL_TLSF */
 
 void *k_calloc(size_t nmemb, size_t size)
 {
@@ -214,6 +260,11 @@ void *z_thread_malloc(size_t size)
 {
 	void *ret;
 
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+	if (_current->resource_pool == _HEAP_MEM_POOL) {
+		ret = k_malloc(size);
+	} else
+#endif
 	if (_current->resource_pool != NULL) {
 		ret = k_mem_pool_malloc(_current->resource_pool, size);
 	} else {
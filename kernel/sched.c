@@ -17,7 +17,7 @@
 #if defined(CONFIG_SCHED_DUMB)
 #define _priq_run_add		z_priq_dumb_add
 #define _priq_run_remove	z_priq_dumb_remove
-# if defined(CONFIG_SCHED_CPU_MASK)
+# if defined(CONFIG_SCHED_CPU_MASK) && !defined(CONFIG_SCHED_CPU_RUNQ)
 #  define _priq_run_best	_priq_dumb_mask_best
 # else
 #  define _priq_run_best	z_priq_dumb_best
@@ -42,6 +42,15 @@
 #define _priq_wait_best		z_priq_dumb_best
 #endif
 
+/* With per-CPU run queues each CPU only ever finds threads allowed to
+ * run on it in its own queue, so no mask filtering is needed there.
+ */
+#ifdef CONFIG_SCHED_CPU_RUNQ
+#define RUNQ(cpu)		(&_kernel.cpus[(cpu)].ready_q.runq)
+#else
+#define RUNQ(cpu)		(&_kernel.ready_q.runq)
+#endif
+
 /* the only struct z_kernel instance */
 struct z_kernel _kernel;
 
@@ -176,6 +185,155 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+static inline bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Choose the run queue for a thread becoming ready: the CPU it last
+ * ran on if it would get to run there right away (cache affinity),
+ * otherwise an idle CPU, otherwise one running something it
+ * preempts, otherwise its last (or first allowed) CPU.  Threads are
+ * only ever placed on CPUs included in their affinity mask.
+ */
+static int runq_pick_cpu(struct k_thread *thread)
+{
+	int last = thread->base.cpu, idle = -1, preempt = -1, any = -1;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *cur = _kernel.cpus[i].current;
+
+		if (!cpu_allowed(thread, i) || cur == NULL) {
+			continue;
+		}
+
+		bool lower = is_idle(cur) ||
+			z_is_t1_higher_prio_than_t2(thread, cur);
+
+		if (i == last && lower) {
+			return i;
+		}
+
+		if (idle < 0 && is_idle(cur)) {
+			idle = i;
+		} else if (preempt < 0 && lower) {
+			preempt = i;
+		} else if (any < 0) {
+			any = i;
+		}
+	}
+
+	if (idle >= 0) {
+		return idle;
+	} else if (preempt >= 0) {
+		return preempt;
+	} else if (cpu_allowed(thread, last) || any < 0) {
+		return last;
+	} else {
+		return any;
+	}
+}
+
+static void runq_add_cpu(struct k_thread *thread, int cpu)
+{
+	thread->base.runq_cpu = cpu;
+	_priq_run_add(RUNQ(cpu), thread);
+}
+
+static void runq_add(struct k_thread *thread)
+{
+	int cpu = runq_pick_cpu(thread);
+
+	runq_add_cpu(thread, cpu);
+
+	/* Kick the other CPU so it notices the new thread at its
+	 * next interrupt exit instead of its next tick
+	 */
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+	if (cpu != _current_cpu->id) {
+		z_arch_sched_ipi();
+	}
+#endif
+}
+
+static void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(RUNQ(thread->base.runq_cpu), thread);
+}
+
+/* Put a thread back into the queue it was taken from.  _current is
+ * not kept in any queue under SMP, it goes back to the local one.
+ */
+static void runq_readd(struct k_thread *thread)
+{
+	runq_add_cpu(thread, thread == _current ?
+		     _current_cpu->id : thread->base.runq_cpu);
+}
+
+/* Best thread in the local queue, or if that is empty the best
+ * thread allowed here found at the head of another CPU's queue.
+ * Stolen threads are not moved here: next_up() takes its choice out
+ * of whatever queue it lives in.
+ */
+static struct k_thread *runq_best(void)
+{
+	int id = _current_cpu->id;
+	struct k_thread *th = _priq_run_best(RUNQ(id));
+
+	if (th != NULL) {
+		return th;
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *t;
+
+		if (i == id) {
+			continue;
+		}
+
+		t = _priq_run_best(RUNQ(i));
+		if (t != NULL && cpu_allowed(t, id) &&
+		    (th == NULL || z_is_t1_higher_prio_than_t2(t, th))) {
+			th = t;
+		}
+	}
+
+	return th;
+}
+#else
+static inline void runq_add(struct k_thread *thread)
+{
+	_priq_run_add(RUNQ(0), thread);
+}
+
+static inline void runq_remove(struct k_thread *thread)
+{
+	_priq_run_remove(RUNQ(0), thread);
+}
+
+static inline void runq_readd(struct k_thread *thread)
+{
+	_priq_run_add(RUNQ(0), thread);
+}
+
+static inline struct k_thread *runq_best(void)
+{
+	return _priq_run_best(RUNQ(0));
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
+/* Re-sort a thread in its run queue, e.g. after a priority change */
+static inline void runq_requeue(struct k_thread *thread)
+{
+	runq_remove(thread);
+	runq_readd(thread);
+}
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 #ifndef CONFIG_SMP
@@ -185,7 +343,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	 * responsible for putting it back in z_swap and ISR return!),
 	 * which makes this choice simple.
 	 */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 
 	return th ? th : _current_cpu->idle_thread;
 #else
@@ -203,7 +361,7 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	int active = !z_is_thread_prevented_from_running(_current);
 
 	/* Choose the best thread that is not current */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best();
 	if (th == NULL) {
 		th = _current_cpu->idle_thread;
 	}
@@ -221,13 +379,13 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 
 	/* Put _current back into the queue */
 	if (th != _current && active && !is_idle(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_readd(_current);
 		z_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (z_is_thread_queued(th)) {
-		_priq_run_remove(&_kernel.ready_q.runq, th);
+		runq_remove(th);
 	}
 	z_mark_thread_as_not_queued(th);
 
@@ -330,7 +488,7 @@ static void update_cache(int preempt_ok)
 void z_add_thread_to_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		runq_add(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(0);
 	}
@@ -339,8 +497,7 @@ void z_add_thread_to_ready_q(struct k_thread *thread)
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
+		runq_requeue(thread);
 		z_mark_thread_as_queued(thread);
 		update_cache(thread == _current);
 	}
@@ -350,7 +507,7 @@ void z_remove_thread_from_ready_q(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
 		if (z_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			z_mark_thread_as_not_queued(thread);
 		}
 		update_cache(thread == _current);
@@ -482,9 +639,9 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 		need_sched = z_is_thread_ready(thread);
 
 		if (need_sched) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
+			runq_remove(thread);
 			thread->base.prio = prio;
-			_priq_run_add(&_kernel.ready_q.runq, thread);
+			runq_readd(thread);
 			update_cache(1);
 		} else {
 			thread->base.prio = prio;
@@ -792,14 +949,14 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
-void z_sched_init(void)
+static void init_ready_q(struct _ready_q *rq)
 {
 #ifdef CONFIG_SCHED_DUMB
-	sys_dlist_init(&_kernel.ready_q.runq);
+	sys_dlist_init(&rq->runq);
 #endif
 
 #ifdef CONFIG_SCHED_SCALABLE
-	_kernel.ready_q.runq = (struct _priq_rb) {
+	rq->runq = (struct _priq_rb) {
 		.tree = {
 			.lessthan_fn = z_priq_rb_lessthan,
 		}
@@ -807,9 +964,20 @@ void z_sched_init(void)
 #endif
 
 #ifdef CONFIG_SCHED_MULTIQ
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
-		sys_dlist_init(&_kernel.ready_q.runq.queues[i]);
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
+		sys_dlist_init(&rq->runq.queues[i]);
+	}
+#endif
+}
+
+void z_sched_init(void)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
+#else
+	init_ready_q(&_kernel.ready_q);
 #endif
 
 #ifdef CONFIG_TIMESLICING
@@ -867,8 +1035,7 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	LOCKED(&sched_spinlock) {
 		th->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(th)) {
-			_priq_run_remove(&_kernel.ready_q.runq, th);
-			_priq_run_add(&_kernel.ready_q.runq, th);
+			runq_requeue(th);
 		}
 	}
 }
@@ -897,10 +1064,7 @@ void z_impl_k_yield(void)
 		LOCKED(&sched_spinlock) {
 			if (!IS_ENABLED(CONFIG_SMP) ||
 			    z_is_thread_queued(_current)) {
-				_priq_run_remove(&_kernel.ready_q.runq,
-						 _current);
-				_priq_run_add(&_kernel.ready_q.runq,
-					      _current);
+				runq_requeue(_current);
 			}
 			update_cache(1);
 		}
@@ -1035,7 +1199,7 @@ void z_sched_abort(struct k_thread *thread)
 		LOCKED(&sched_spinlock) {
 			if (z_is_thread_queued(thread)) {
 				thread->base.thread_state |= _THREAD_DEAD;
-				_priq_run_remove(&_kernel.ready_q.runq, thread);
+				runq_remove(thread);
 				z_mark_thread_as_not_queued(thread);
 			}
 		}
@@ -17,8 +17,6 @@
 
 static u64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 static bool can_wait_forever;
@@ -30,6 +28,265 @@ static int announce_remaining;
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 #endif
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+
+/* Hierarchical timer wheel.  Level 0 has one slot per tick, each
+ * higher level has slots WHEEL_SLOTS times wider than the one below.
+ * A timeout lives in the lowest level at which its expiry tick and
+ * curr_tick fall into the same slot of the level above, so a slot in
+ * level 0 only ever holds timeouts with identical expiry, and higher
+ * level slots only ever lie strictly in the future.  When time
+ * reaches the start of a higher level slot its contents are
+ * "cascaded" down by reinserting them.  The top level has no level
+ * above it and is used as a circular buffer, which is fine because
+ * its slots are far wider than the longest possible timeout.
+ *
+ * Insertion and cancellation are O(1).  Expiry processing costs
+ * O(WHEEL_LEVELS) per timeout fired or cascaded, independent of the
+ * number of armed timeouts.
+ */
+#define WHEEL_BITS 5
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS 7
+#define WHEEL_MASK (WHEEL_SLOTS - 1U)
+
+BUILD_ASSERT(WHEEL_SLOTS == 32);
+BUILD_ASSERT((WHEEL_BITS * (WHEEL_LEVELS - 1)) >= 30);
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+/* Non-empty slots of each level.  Slot lists are only initialized
+ * when their bit is set, which allows the wheel to live in .bss.
+ */
+static u32_t wheel_bits[WHEEL_LEVELS];
+
+static inline int lvl_shift(int lvl)
+{
+	return lvl * WHEEL_BITS;
+}
+
+static inline u32_t lvl_slot(u64_t tick, int lvl)
+{
+	return (u32_t)(tick >> lvl_shift(lvl)) & WHEEL_MASK;
+}
+
+static int wheel_level(u64_t expiry)
+{
+	int lvl;
+
+	for (lvl = 0; lvl < WHEEL_LEVELS - 1; lvl++) {
+		int sh = lvl_shift(lvl + 1);
+
+		if ((expiry >> sh) == (curr_tick >> sh)) {
+			break;
+		}
+	}
+
+	return lvl;
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	int lvl = wheel_level(to->expiry);
+	u32_t slot = lvl_slot(to->expiry, lvl);
+	sys_dlist_t *l = &wheel[lvl][slot];
+
+	if ((wheel_bits[lvl] & BIT(slot)) == 0U) {
+		sys_dlist_init(l);
+		wheel_bits[lvl] |= BIT(slot);
+	}
+
+	sys_dlist_append(l, &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	/* The last node of a list points to the list head both ways,
+	 * which tells us which slot (if any) is going empty without
+	 * having to store its position in the timeout.
+	 */
+	if (t->node.next == t->node.prev) {
+		int idx = (sys_dlist_t *)t->node.next - &wheel[0][0];
+
+		wheel_bits[idx / WHEEL_SLOTS] &= ~BIT(idx % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* Index of the first non-empty slot at or after "from", as a
+ * distance from "from" going around the wheel, or -1 if empty
+ */
+static int next_slot(u32_t bits, u32_t from)
+{
+	u32_t rot = from == 0U ? bits :
+		(bits >> from) | (bits << (WHEEL_SLOTS - from));
+
+	return rot == 0U ? -1 : __builtin_ctz(rot);
+}
+
+/* Absolute tick of the next wheel event: either a level 0 slot
+ * expiring or a higher level slot that needs to be cascaded.
+ */
+static bool wheel_next_event(u64_t *event)
+{
+	bool found = false;
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		u32_t c = lvl_slot(curr_tick, lvl);
+		int d;
+		u64_t ev;
+
+		if (lvl == 0) {
+			d = next_slot(wheel_bits[lvl], c);
+		} else {
+			/* The current slot of a level above 0 is
+			 * always empty, start looking at the next one
+			 */
+			d = next_slot(wheel_bits[lvl], (c + 1U) & WHEEL_MASK);
+			d = d < 0 ? d : d + 1;
+		}
+
+		if (d < 0) {
+			continue;
+		}
+
+		ev = ((curr_tick >> lvl_shift(lvl)) + d) << lvl_shift(lvl);
+		if (!found || ev < *event) {
+			*event = ev;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+/* Moves the contents of every higher level slot starting at
+ * curr_tick down to the levels below
+ */
+static void wheel_cascade(void)
+{
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		u32_t slot = lvl_slot(curr_tick, lvl);
+		u64_t mask = ((u64_t)1 << lvl_shift(lvl)) - 1;
+		sys_dlist_t *l = &wheel[lvl][slot];
+		sys_dnode_t *n;
+
+		if ((curr_tick & mask) != 0U ||
+		    (wheel_bits[lvl] & BIT(slot)) == 0U) {
+			continue;
+		}
+
+		wheel_bits[lvl] &= ~BIT(slot);
+		while ((n = sys_dlist_get(l)) != NULL) {
+			wheel_insert(CONTAINER_OF(n, struct _timeout, node));
+		}
+	}
+}
+
+static s32_t first_dticks(void)
+{
+	u64_t ev;
+
+	if (!wheel_next_event(&ev)) {
+		return -1;
+	}
+
+	return (s32_t)MIN(ev - curr_tick, (u64_t)INT_MAX);
+}
+
+static void timeout_insert(struct _timeout *to, s32_t ticks)
+{
+	ARG_UNUSED(ticks);
+
+	wheel_insert(to);
+}
+
+/* A timeout parked in a higher level generates its first event when
+ * its slot gets cascaded, not at its expiry
+ */
+static bool timeout_is_first(struct _timeout *to)
+{
+	int sh = lvl_shift(wheel_level(to->expiry));
+	u64_t ev;
+
+	return wheel_next_event(&ev) && ev == ((to->expiry >> sh) << sh);
+}
+
+/* Advances time to the next expiring timeout within the announced
+ * range and removes it from the wheel, or returns NULL if nothing
+ * else expires before announce_remaining runs out.
+ */
+static struct _timeout *next_expired(void)
+{
+	u64_t ev;
+
+	while (wheel_next_event(&ev) &&
+	       ev - curr_tick <= (u64_t)announce_remaining) {
+		u32_t slot = lvl_slot(ev, 0);
+
+		announce_remaining -= (s32_t)(ev - curr_tick);
+		curr_tick = ev;
+		wheel_cascade();
+
+		if ((wheel_bits[0] & BIT(slot)) != 0U) {
+			sys_dnode_t *n = sys_dlist_peek_head(&wheel[0][slot]);
+			struct _timeout *t = CONTAINER_OF(n, struct _timeout,
+							  node);
+
+			__ASSERT(t->expiry == curr_tick, "");
+			t->dticks = 0;
+			remove_timeout(t);
+			return t;
+		}
+	}
+
+	return NULL;
+}
+
+static void finish_announce(void)
+{
+}
+
+static int collect_within(u64_t end, struct _timeout **list, int max)
+{
+	int n = 0;
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		int sh = lvl_shift(lvl);
+		u32_t c = lvl_slot(curr_tick, lvl);
+
+		for (u32_t d = lvl == 0 ? 0 : 1; d < WHEEL_SLOTS; d++) {
+			u32_t slot = (c + d) & WHEEL_MASK;
+			struct _timeout *t;
+
+			if ((((curr_tick >> sh) + d) << sh) > end) {
+				break;
+			}
+
+			if ((wheel_bits[lvl] & BIT(slot)) == 0U) {
+				continue;
+			}
+
+			SYS_DLIST_FOR_EACH_CONTAINER(&wheel[lvl][slot], t,
+						     node) {
+				if (t->expiry <= end) {
+					if (n < max) {
+						list[n] = t;
+					}
+					n++;
+				}
+			}
+		}
+	}
+
+	return n;
+}
+
+#else /* !CONFIG_TIMEOUT_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -53,6 +310,81 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static s32_t first_dticks(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? -1 : to->dticks;
+}
+
+static void timeout_insert(struct _timeout *to, s32_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+	for (t = first(); t != NULL; t = next(t)) {
+		__ASSERT(t->dticks >= 0, "");
+
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+static bool timeout_is_first(struct _timeout *to)
+{
+	return to == first();
+}
+
+static struct _timeout *next_expired(void)
+{
+	struct _timeout *t = first();
+
+	if (t == NULL || t->dticks > announce_remaining) {
+		return NULL;
+	}
+
+	curr_tick += t->dticks;
+	announce_remaining -= t->dticks;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+static void finish_announce(void)
+{
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+}
+
+static int collect_within(u64_t end, struct _timeout **list, int max)
+{
+	int n = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		if (t->expiry > end) {
+			break;
+		}
+		if (n < max) {
+			list[n] = t;
+		}
+		n++;
+	}
+
+	return n;
+}
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static s32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0;
@@ -61,8 +393,8 @@ static s32_t elapsed(void)
 static s32_t next_timeout(void)
 {
 	int maxw = can_wait_forever ? K_FOREVER : INT_MAX;
-	struct _timeout *to = first();
-	s32_t ret = to == NULL ? maxw : MAX(0, to->dticks - elapsed());
+	s32_t dticks = first_dticks();
+	s32_t ret = dticks < 0 ? maxw : MAX(0, dticks - elapsed());
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -79,25 +411,12 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
-		to->dticks = ticks + elapsed();
-		for (t = first(); t != NULL; t = next(t)) {
-			__ASSERT(t->dticks >= 0, "");
-
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+		s32_t dticks = ticks + elapsed();
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		to->expiry = curr_tick + dticks;
+		timeout_insert(to, dticks);
 
-		if (to == first()) {
+		if (timeout_is_first(to)) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
 	}
@@ -126,12 +445,7 @@ s32_t z_timeout_remaining(struct _timeout *timeout)
 	}
 
 	LOCKED(&timeout_lock) {
-		for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-			ticks += t->dticks;
-			if (timeout == t) {
-				break;
-			}
-		}
+		ticks = (s32_t)(timeout->expiry - curr_tick);
 	}
 
 	return ticks - elapsed();
@@ -147,6 +461,19 @@ s32_t z_get_next_timeout_expiry(void)
 	return ret;
 }
 
+int k_timeout_expiring_within(s32_t ticks, struct _timeout **list, int max)
+{
+	int ret = 0;
+
+	LOCKED(&timeout_lock) {
+		u64_t end = curr_tick + elapsed() + MAX(0, ticks);
+
+		ret = collect_within(end, list, max);
+	}
+
+	return ret;
+}
+
 void z_set_timeout_expiry(s32_t ticks, bool idle)
 {
 	LOCKED(&timeout_lock) {
@@ -173,26 +500,17 @@ void z_clock_announce(s32_t ticks)
 #endif
 
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct _timeout *t;
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
+	while ((t = next_expired()) != NULL) {
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	finish_announce();
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -9,6 +9,7 @@
 #include <init.h>
 #include <errno.h>
 #include <misc/mempool.h>
+#include <misc/tlsf.h>
 #include <string.h>
 #include <app_memory/app_memdomain.h>
 
@@ -24,6 +25,48 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 #define POOL_SECTION .data
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_TLSF
+SYS_TLSF_POOL_DEFINE(z_malloc_tlsf_pool,
+		     CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE, POOL_SECTION);
+
+void *malloc(size_t size)
+{
+	void *ret;
+
+	ret = sys_tlsf_pool_alloc(&z_malloc_tlsf_pool, size);
+	if (ret == NULL) {
+		errno = ENOMEM;
+	}
+
+	return ret;
+}
+
+void free(void *ptr)
+{
+	sys_tlsf_pool_free(&z_malloc_tlsf_pool, ptr);
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	void *ret;
+
+	ret = sys_tlsf_pool_realloc(&z_malloc_tlsf_pool, ptr, requested_size);
+	if (ret == NULL && requested_size != 0) {
+		errno = ENOMEM;
+	}
+
+	return ret;
+}
+
+static int malloc_prepare(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	sys_tlsf_pool_init(&z_malloc_tlsf_pool);
+
+	return 0;
+}
+#else
 SYS_MEM_POOL_DEFINE(z_malloc_mem_pool, NULL, 16,
 		    CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE, 1, 4, POOL_SECTION);
 
@@ -47,6 +90,7 @@ static int malloc_prepare(struct device *unused)
 
 	return 0;
 }
+#endif /* CONFIG_MINIMAL_LIBC_MALLOC_TLSF */
 
 SYS_INIT(malloc_prepare, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
 #else /* No malloc arena */
@@ -61,10 +105,12 @@ void *malloc(size_t size)
 }
 #endif
 
+#ifndef CONFIG_MINIMAL_LIBC_MALLOC_TLSF
 void free(void *ptr)
 {
 	sys_mem_pool_free(ptr);
 }
+#endif
 
 static bool size_t_mul_overflow(size_t a, size_t b, size_t *res)
 {
@@ -96,6 +142,7 @@ void *calloc(size_t nmemb, size_t size)
 	return ret;
 }
 
+#ifndef CONFIG_MINIMAL_LIBC_MALLOC_TLSF
 void *realloc(void *ptr, size_t requested_size)
 {
 	struct sys_mem_pool_block *blk;
@@ -136,7 +183,7 @@ void *realloc(void *ptr, size_t requested_size)
 
 	return new_ptr;
 }
-
+#endif /* !CONFIG_MINIMAL_LIBC_MALLOC_TLSF */
 
 void *reallocarray(void *ptr, size_t nmemb, size_t size)
 {
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/tlsf.h>
+
+/* Physical block header.  Only the size field is live while a block is
+ * allocated: prev_phys sits in the last word of the previous block's
+ * payload and is only valid while that block is free, and the free
+ * list links are part of the payload.
+ */
+struct z_tlsf_block {
+	struct z_tlsf_block *prev_phys;
+	size_t size;
+	struct z_tlsf_block *next_free;
+	struct z_tlsf_block *prev_free;
+};
+
+#define WORD sizeof(void *)
+#define ALIGN ((size_t)1 << Z_TLSF_ALIGN_LOG2)
+
+/* Payloads are ALIGN aligned.  Blocks follow each other every WORD +
+ * size bytes, so block sizes are kept ALIGN - WORD modulo ALIGN: a
+ * multiple of 8 on 64-bit, 4 more than one on 32-bit.
+ */
+#define SIZE_ROUND_UP(s)	(ROUND_UP((s) + WORD, ALIGN) - WORD)
+#define SIZE_ROUND_DOWN(s)	(ROUND_DOWN((s) + WORD, ALIGN) - WORD)
+
+/* Low bits of the size field, sizes are multiples of WORD */
+#define FREE_BIT	BIT(0)
+#define PREV_FREE_BIT	BIT(1)
+#define FLAG_BITS	(FREE_BIT | PREV_FREE_BIT)
+
+/* Payload starts after prev_phys and size */
+#define PAYLOAD_OFFSET	(2 * WORD)
+
+/* A free block must hold its list links plus the next block's prev_phys */
+#define BLOCK_SIZE_MIN	(3 * WORD)
+#define BLOCK_SIZE_MAX	(((size_t)1 << Z_TLSF_FL_MAX) - WORD)
+
+/* Smallest block that can be split off another one: payload plus the
+ * size field of its header
+ */
+#define SPLIT_MIN	(BLOCK_SIZE_MIN + WORD)
+
+BUILD_ASSERT_MSG(Z_TLSF_FL_COUNT < 32, "first level bitmap too small");
+
+static inline size_t block_size(struct z_tlsf_block *b)
+{
+	return b->size & ~FLAG_BITS;
+}
+
+static inline void block_set_size(struct z_tlsf_block *b, size_t size)
+{
+	b->size = size | (b->size & FLAG_BITS);
+}
+
+static inline bool block_is_free(struct z_tlsf_block *b)
+{
+	return (b->size & FREE_BIT) != 0;
+}
+
+static inline void *block_payload(struct z_tlsf_block *b)
+{
+	return (u8_t *)b + PAYLOAD_OFFSET;
+}
+
+static inline struct z_tlsf_block *payload_block(void *ptr)
+{
+	return (struct z_tlsf_block *)((u8_t *)ptr - PAYLOAD_OFFSET);
+}
+
+static inline struct z_tlsf_block *block_next(struct z_tlsf_block *b)
+{
+	return (struct z_tlsf_block *)((u8_t *)b + WORD + block_size(b));
+}
+
+/* Marks b free in its own header and in the next block's */
+static void block_mark_free(struct z_tlsf_block *b)
+{
+	struct z_tlsf_block *next = block_next(b);
+
+	b->size |= FREE_BIT;
+	next->prev_phys = b;
+	next->size |= PREV_FREE_BIT;
+}
+
+static void block_mark_used(struct z_tlsf_block *b)
+{
+	b->size &= ~FREE_BIT;
+	block_next(b)->size &= ~PREV_FREE_BIT;
+}
+
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+	if (size < ((size_t)1 << Z_TLSF_FL_SHIFT)) {
+		*fl = 0;
+		*sl = size >> Z_TLSF_ALIGN_LOG2;
+	} else {
+		int msb = find_msb_set((u32_t)size) - 1;
+
+		*fl = msb - (Z_TLSF_FL_SHIFT - 1);
+		*sl = (size >> (msb - Z_TLSF_SL_LOG2)) ^ Z_TLSF_SL_COUNT;
+	}
+}
+
+/* Like mapping_insert(), but rounds up to the next list so that any
+ * block found there is large enough
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= ((size_t)1 << Z_TLSF_FL_SHIFT)) {
+		int msb = find_msb_set((u32_t)size) - 1;
+
+		size += ((size_t)1 << (msb - Z_TLSF_SL_LOG2)) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+}
+
+static void free_list_remove(struct sys_tlsf *h, struct z_tlsf_block *b)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+
+	if (b->next_free != NULL) {
+		b->next_free->prev_free = b->prev_free;
+	}
+	if (b->prev_free != NULL) {
+		b->prev_free->next_free = b->next_free;
+	} else {
+		h->blocks[fl][sl] = b->next_free;
+		if (b->next_free == NULL) {
+			h->sl_bitmap[fl] &= ~BIT(sl);
+			if (h->sl_bitmap[fl] == 0) {
+				h->fl_bitmap &= ~BIT(fl);
+			}
+		}
+	}
+
+	h->free_bytes -= block_size(b);
+}
+
+static void free_list_insert(struct sys_tlsf *h, struct z_tlsf_block *b)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+
+	b->prev_free = NULL;
+	b->next_free = h->blocks[fl][sl];
+	if (b->next_free != NULL) {
+		b->next_free->prev_free = b;
+	}
+	h->blocks[fl][sl] = b;
+	h->sl_bitmap[fl] |= BIT(sl);
+	h->fl_bitmap |= BIT(fl);
+
+	h->free_bytes += block_size(b);
+}
+
+/* Finds the head of the first non-empty list at or above (fl, sl) */
+static struct z_tlsf_block *find_suitable(struct sys_tlsf *h, int fl, int sl)
+{
+	u32_t map = h->sl_bitmap[fl] & (~0U << sl);
+
+	if (map == 0) {
+		u32_t fl_map = h->fl_bitmap & (~0U << (fl + 1));
+
+		if (fl_map == 0) {
+			return NULL;
+		}
+
+		fl = find_lsb_set(fl_map) - 1;
+		map = h->sl_bitmap[fl];
+	}
+
+	return h->blocks[fl][find_lsb_set(map) - 1];
+}
+
+/* Last resort when no list is guaranteed to fit: the list size itself
+ * maps to may still hold a block that is large enough
+ */
+static struct z_tlsf_block *find_fit(struct sys_tlsf *h, size_t size)
+{
+	struct z_tlsf_block *b;
+	int fl, sl;
+
+	mapping_insert(size, &fl, &sl);
+	for (b = h->blocks[fl][sl]; b != NULL; b = b->next_free) {
+		if (block_size(b) >= size) {
+			break;
+		}
+	}
+
+	return b;
+}
+
+/* Merges b with its next physical block, which must be free and no
+ * longer on a free list
+ */
+static void block_absorb_next(struct z_tlsf_block *b)
+{
+	struct z_tlsf_block *next = block_next(b);
+
+	block_set_size(b, block_size(b) + WORD + block_size(next));
+}
+
+/* Gives the tail of an allocated block beyond size back to the heap, if
+ * it is large enough to make a block of its own
+ */
+static void block_trim_used(struct sys_tlsf *h, struct z_tlsf_block *b,
+			    size_t size)
+{
+	struct z_tlsf_block *rem, *next;
+
+	if (block_size(b) < size + SPLIT_MIN) {
+		return;
+	}
+
+	rem = (struct z_tlsf_block *)((u8_t *)b + WORD + size);
+	rem->size = block_size(b) - size - WORD;
+	block_set_size(b, size);
+
+	next = block_next(rem);
+	if (block_is_free(next)) {
+		free_list_remove(h, next);
+		block_absorb_next(rem);
+	}
+
+	block_mark_free(rem);
+	free_list_insert(h, rem);
+}
+
+static size_t adjust_size(size_t bytes)
+{
+	size_t size = SIZE_ROUND_UP(bytes);
+
+	return MAX(size, BLOCK_SIZE_MIN);
+}
+
+void sys_tlsf_init(struct sys_tlsf *h, void *mem, size_t bytes)
+{
+	u8_t *start = (u8_t *)ROUND_UP((u8_t *)mem + PAYLOAD_OFFSET, ALIGN) -
+		      PAYLOAD_OFFSET;
+	u8_t *end = (u8_t *)ROUND_DOWN((u8_t *)mem + bytes, WORD);
+	struct z_tlsf_block *b, *sentinel;
+	size_t size;
+
+	(void)memset(h, 0, sizeof(*h));
+
+	/* One word for the first block's unused prev_phys, one for its
+	 * size and one for the size of the sentinel block closing the
+	 * arena
+	 */
+	__ASSERT(end > start && (size_t)(end - start) >=
+		 BLOCK_SIZE_MIN + 3 * WORD, "TLSF arena too small");
+
+	size = MIN(SIZE_ROUND_DOWN((size_t)(end - start) - 3 * WORD),
+		   BLOCK_SIZE_MAX);
+
+	b = (struct z_tlsf_block *)start;
+	b->size = size;
+
+	/* Zero-sized, permanently used block so that the last real block
+	 * always has a next one to update
+	 */
+	sentinel = block_next(b);
+	sentinel->size = 0;
+
+	block_mark_free(b);
+	free_list_insert(h, b);
+
+	h->start = start;
+	h->end = (u8_t *)sentinel + 2 * WORD;
+}
+
+void *sys_tlsf_alloc(struct sys_tlsf *h, size_t bytes)
+{
+	struct z_tlsf_block *b;
+	size_t size;
+	int fl, sl;
+
+	if (bytes == 0 || bytes > BLOCK_SIZE_MAX) {
+		return NULL;
+	}
+
+	size = adjust_size(bytes);
+	mapping_search(size, &fl, &sl);
+
+	b = fl < Z_TLSF_FL_COUNT ? find_suitable(h, fl, sl) : NULL;
+	if (b == NULL) {
+		b = find_fit(h, size);
+		if (b == NULL) {
+			return NULL;
+		}
+	}
+
+	free_list_remove(h, b);
+	block_mark_used(b);
+	block_trim_used(h, b, size);
+
+	return block_payload(b);
+}
+
+void sys_tlsf_free(struct sys_tlsf *h, void *ptr)
+{
+	struct z_tlsf_block *b, *next;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	b = payload_block(ptr);
+	__ASSERT(sys_tlsf_contains(h, ptr), "pointer not from this heap");
+	__ASSERT(!block_is_free(b), "double free");
+
+	if ((b->size & PREV_FREE_BIT) != 0) {
+		struct z_tlsf_block *prev = b->prev_phys;
+
+		free_list_remove(h, prev);
+		block_absorb_next(prev);
+		b = prev;
+	}
+
+	next = block_next(b);
+	if (block_is_free(next)) {
+		free_list_remove(h, next);
+		block_absorb_next(b);
+	}
+
+	block_mark_free(b);
+	free_list_insert(h, b);
+}
+
+void *sys_tlsf_realloc(struct sys_tlsf *h, void *ptr, size_t bytes)
+{
+	struct z_tlsf_block *b, *next;
+	size_t size;
+	void *ret;
+
+	if (ptr == NULL) {
+		return sys_tlsf_alloc(h, bytes);
+	}
+
+	if (bytes == 0) {
+		sys_tlsf_free(h, ptr);
+		return NULL;
+	}
+
+	if (bytes > BLOCK_SIZE_MAX) {
+		return NULL;
+	}
+
+	b = payload_block(ptr);
+	size = adjust_size(bytes);
+
+	if (size > block_size(b)) {
+		next = block_next(b);
+
+		if (!block_is_free(next) ||
+		    block_size(b) + WORD + block_size(next) < size) {
+			ret = sys_tlsf_alloc(h, bytes);
+			if (ret != NULL) {
+				(void)memcpy(ret, ptr, block_size(b));
+				sys_tlsf_free(h, ptr);
+			}
+			return ret;
+		}
+
+		free_list_remove(h, next);
+		block_absorb_next(b);
+		block_mark_used(b);
+	}
+
+	block_trim_used(h, b, size);
+
+	return ptr;
+}
+
+size_t sys_tlsf_usable_size(void *ptr)
+{
+	return block_size(payload_block(ptr));
+}
+
+void sys_tlsf_stats_get(struct sys_tlsf *h, struct sys_tlsf_stats *stats)
+{
+	struct z_tlsf_block *b;
+	size_t max = 0;
+
+	if (h->fl_bitmap != 0) {
+		int fl = find_msb_set(h->fl_bitmap) - 1;
+		int sl = find_msb_set(h->sl_bitmap[fl]) - 1;
+
+		for (b = h->blocks[fl][sl]; b != NULL; b = b->next_free) {
+			max = MAX(max, block_size(b));
+		}
+	}
+
+	stats->free_bytes = h->free_bytes;
+	stats->used_bytes = (h->end - h->start) - h->free_bytes;
+	stats->max_free_block = max;
+}
+
+void *sys_tlsf_pool_alloc(struct sys_tlsf_pool *p, size_t size)
+{
+	void *ret;
+
+	sys_mutex_lock(&p->mutex, K_FOREVER);
+	ret = sys_tlsf_alloc(&p->heap, size);
+	sys_mutex_unlock(&p->mutex);
+
+	return ret;
+}
+
+void sys_tlsf_pool_free(struct sys_tlsf_pool *p, void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	sys_mutex_lock(&p->mutex, K_FOREVER);
+	sys_tlsf_free(&p->heap, ptr);
+	sys_mutex_unlock(&p->mutex);
+}
+
+void *sys_tlsf_pool_realloc(struct sys_tlsf_pool *p, void *ptr, size_t size)
+{
+	void *ret;
+
+	sys_mutex_lock(&p->mutex, K_FOREVER);
+	ret = sys_tlsf_realloc(&p->heap, ptr, size);
+	sys_mutex_unlock(&p->mutex);
+
+	return ret;
+}
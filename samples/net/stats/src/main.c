@@ -104,6 +104,10 @@ static void print_stats(struct net_if *iface, struct net_stats *data)
 	printk("TCP conn drop  %d\tconnrst\t%d\n",
 	       GET_STAT(iface, tcp.conndrop),
 	       GET_STAT(iface, tcp.connrst));
+	printk("TCP coalesced  %d\tdelayed ack\t%d\tooo\t%d\n",
+	       GET_STAT(iface, tcp.coalesced),
+	       GET_STAT(iface, tcp.delayed_ack),
+	       GET_STAT(iface, tcp.ooo_queued));
 #endif
 
 	printk("Bytes received %u\n", GET_STAT(iface, bytes.received));
@@ -113,26 +113,132 @@ int bt_rand(void *buf, size_t len)
 	return -EIO;
 }
 
-int bt_encrypt_le(const u8_t key[16], const u8_t plaintext[16],
-		  u8_t enc_data[16])
+#if defined(CONFIG_BT_CRYPTO_KEY_CACHE)
+static struct key_sched {
+	u8_t key[16];
+	struct tc_aes_key_sched_struct sched;
+} key_cache[CONFIG_BT_CRYPTO_KEY_CACHE_SIZE];
+
+/* Indexes of the cached keys, most recently used first */
+static u8_t key_order[CONFIG_BT_CRYPTO_KEY_CACHE_SIZE];
+static u8_t key_count;
+
+static K_MUTEX_DEFINE(key_cache_lock);
+
+/* Must be called with key_cache_lock held */
+static struct key_sched *key_cache_get(const u8_t key[16])
 {
-	struct tc_aes_key_sched_struct s;
-	u8_t tmp[16];
+	struct key_sched *entry;
+	u8_t idx;
+	int i;
 
-	BT_DBG("key %s plaintext %s", bt_hex(key, 16), bt_hex(plaintext, 16));
+	for (i = 0; i < key_count; i++) {
+		if (!_compare(key_cache[key_order[i]].key, key, 16)) {
+			break;
+		}
+	}
+
+	if (i < key_count) {
+		idx = key_order[i];
+		entry = &key_cache[idx];
+	} else {
+		if (key_count < ARRAY_SIZE(key_cache)) {
+			key_order[key_count] = key_count;
+			key_count++;
+		}
+
+		/* Take a free entry or evict the least recently used key */
+		i = key_count - 1;
+		idx = key_order[i];
+		entry = &key_cache[idx];
+
+		memcpy(entry->key, key, 16);
+		(void)tc_aes128_set_encrypt_key(&entry->sched, key);
+
+		BT_DBG("key %s cached", bt_hex(key, 16));
+	}
 
-	sys_memcpy_swap(tmp, key, 16);
+	memmove(&key_order[1], &key_order[0], i);
+	key_order[0] = idx;
 
-	if (tc_aes128_set_encrypt_key(&s, tmp) == TC_CRYPTO_FAIL) {
+	return entry;
+}
+
+int bt_crypto_key_sched(const u8_t key[16], struct tc_aes_key_sched_struct *s)
+{
+	if (!key || !s) {
 		return -EINVAL;
 	}
 
-	sys_memcpy_swap(tmp, plaintext, 16);
+	k_mutex_lock(&key_cache_lock, K_FOREVER);
+	memcpy(s, &key_cache_get(key)->sched, sizeof(*s));
+	k_mutex_unlock(&key_cache_lock);
+
+	return 0;
+}
+
+void bt_crypto_key_cache_clear(void)
+{
+	k_mutex_lock(&key_cache_lock, K_FOREVER);
+	_set(key_cache, 0, sizeof(key_cache));
+	key_count = 0U;
+	k_mutex_unlock(&key_cache_lock);
+
+	BT_DBG("key cache cleared");
+}
+#endif
+
+static int aes_encrypt(const u8_t key[16], const u8_t in[16], u8_t out[16])
+{
+#if defined(CONFIG_BT_CRYPTO_KEY_CACHE)
+	int err = 0;
+
+	if (!key) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&key_cache_lock, K_FOREVER);
+
+	if (tc_aes_encrypt(out, in, &key_cache_get(key)->sched) ==
+	    TC_CRYPTO_FAIL) {
+		err = -EINVAL;
+	}
 
-	if (tc_aes_encrypt(enc_data, tmp, &s) == TC_CRYPTO_FAIL) {
+	k_mutex_unlock(&key_cache_lock);
+
+	return err;
+#else
+	struct tc_aes_key_sched_struct s;
+
+	if (tc_aes128_set_encrypt_key(&s, key) == TC_CRYPTO_FAIL) {
 		return -EINVAL;
 	}
 
+	if (tc_aes_encrypt(out, in, &s) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+#endif
+}
+
+int bt_encrypt_le(const u8_t key[16], const u8_t plaintext[16],
+		  u8_t enc_data[16])
+{
+	u8_t tmp_key[16], tmp[16];
+	int err;
+
+	BT_DBG("key %s plaintext %s", bt_hex(key, 16), bt_hex(plaintext, 16));
+
+	sys_memcpy_swap(tmp_key, key, 16);
+	sys_memcpy_swap(tmp, plaintext, 16);
+
+	err = aes_encrypt(tmp_key, tmp, enc_data);
+	_set(tmp_key, 0, sizeof(tmp_key));
+	if (err) {
+		return err;
+	}
+
 	sys_mem_swap(enc_data, 16);
 
 	BT_DBG("enc_data %s", bt_hex(enc_data, 16));
@@ -143,16 +249,13 @@ int bt_encrypt_le(const u8_t key[16], const u8_t plaintext[16],
 int bt_encrypt_be(const u8_t key[16], const u8_t plaintext[16],
 		  u8_t enc_data[16])
 {
-	struct tc_aes_key_sched_struct s;
+	int err;
 
 	BT_DBG("key %s plaintext %s", bt_hex(key, 16), bt_hex(plaintext, 16));
 
-	if (tc_aes128_set_encrypt_key(&s, key) == TC_CRYPTO_FAIL) {
-		return -EINVAL;
-	}
-
-	if (tc_aes_encrypt(enc_data, plaintext, &s) == TC_CRYPTO_FAIL) {
-		return -EINVAL;
+	err = aes_encrypt(key, plaintext, enc_data);
+	if (err) {
+		return err;
 	}
 
 	BT_DBG("enc_data %s", bt_hex(enc_data, 16));
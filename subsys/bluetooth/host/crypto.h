@@ -6,3 +6,21 @@
  */
 
 int prng_init(void);
+
+struct tc_aes_key_sched_struct;
+
+/* Copies the AES key schedule of key, which is only expanded if it is
+ * not in the key schedule cache already.
+ */
+int bt_crypto_key_sched(const u8_t key[16], struct tc_aes_key_sched_struct *s);
+
+/* Wipes every cached key schedule. Called whenever key material is
+ * deleted or revoked, so that no copy of it is left in the cache.
+ */
+#if defined(CONFIG_BT_CRYPTO_KEY_CACHE)
+void bt_crypto_key_cache_clear(void);
+#else
+static inline void bt_crypto_key_cache_clear(void)
+{
+}
+#endif
@@ -492,6 +492,64 @@ static struct bt_gatt_attr gatt_attrs[] = {
 
 static struct bt_gatt_service gatt_svc = BT_GATT_SERVICE(gatt_attrs);
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+/* Registered services in handle order, the same as in db */
+static struct bt_gatt_service *db_index[CONFIG_BT_GATT_DB_INDEX_SIZE];
+static size_t db_index_count;
+
+static u16_t svc_last_handle(const struct bt_gatt_service *svc)
+{
+	return svc->attrs[svc->attr_count - 1].handle;
+}
+
+/* Position of the first service ending at or after handle */
+static size_t db_index_find(u16_t handle)
+{
+	size_t lo = 0, hi = db_index_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (svc_last_handle(db_index[mid]) < handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Position of the first attribute of svc at or after handle */
+static size_t svc_attr_find(const struct bt_gatt_service *svc, u16_t handle)
+{
+	size_t lo = 0, hi = svc->attr_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (svc->attrs[mid].handle < handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void db_index_remove(struct bt_gatt_service *svc)
+{
+	size_t i = db_index_find(svc->attrs[0].handle);
+
+	if (i < db_index_count && db_index[i] == svc) {
+		db_index_count--;
+		memmove(&db_index[i], &db_index[i + 1],
+			(db_index_count - i) * sizeof(db_index[0]));
+	}
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 static int gatt_register(struct bt_gatt_service *svc)
 {
 	struct bt_gatt_service *last;
@@ -499,6 +557,13 @@ static int gatt_register(struct bt_gatt_service *svc)
 	struct bt_gatt_attr *attrs = svc->attrs;
 	u16_t count = svc->attr_count;
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	if (db_index_count == ARRAY_SIZE(db_index)) {
+		BT_ERR("No room for service in database index");
+		return -ENOMEM;
+	}
+#endif
+
 	if (sys_slist_is_empty(&db)) {
 		handle = 0U;
 		goto populate;
@@ -530,6 +595,11 @@ populate:
 
 	sys_slist_append(&db, &svc->node);
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	/* Handles only grow, the service goes last */
+	db_index[db_index_count++] = svc;
+#endif
+
 	return 0;
 }
 
@@ -789,6 +859,10 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	db_index_remove(svc);
+#endif
+
 	sc_indicate(&gatt_sc, svc->attrs[0].handle,
 		    svc->attrs[svc->attr_count - 1].handle);
 
@@ -926,6 +1000,31 @@ ssize_t bt_gatt_attr_read_chrc(struct bt_conn *conn,
 	return bt_gatt_attr_read(conn, attr, buf, len, offset, &pdu, value_len);
 }
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+void bt_gatt_foreach_attr(u16_t start_handle, u16_t end_handle,
+			  bt_gatt_attr_func_t func, void *user_data)
+{
+	size_t i, j;
+
+	for (i = db_index_find(start_handle); i < db_index_count; i++) {
+		struct bt_gatt_service *svc = db_index[i];
+
+		for (j = svc_attr_find(svc, start_handle); j < svc->attr_count;
+		     j++) {
+			struct bt_gatt_attr *attr = &svc->attrs[j];
+
+			/* Attributes are sorted, none further is in range */
+			if (attr->handle > end_handle) {
+				return;
+			}
+
+			if (func(attr, user_data) == BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+	}
+}
+#else
 void bt_gatt_foreach_attr(u16_t start_handle, u16_t end_handle,
 			  bt_gatt_attr_func_t func, void *user_data)
 {
@@ -949,6 +1048,7 @@ void bt_gatt_foreach_attr(u16_t start_handle, u16_t end_handle,
 		}
 	}
 }
+#endif /* CONFIG_BT_GATT_DB_INDEX */
 
 static u8_t find_next(const struct bt_gatt_attr *attr, void *user_data)
 {
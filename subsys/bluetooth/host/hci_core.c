@@ -1443,6 +1443,8 @@ static int bt_clear_all_pairings(u8_t id)
 		bt_keys_link_key_clear_addr(NULL);
 	}
 
+	bt_crypto_key_cache_clear();
+
 	return 0;
 }
 
@@ -1495,6 +1497,9 @@ int bt_unpair(u8_t id, const bt_addr_le_t *addr)
 		bt_gatt_clear(id, addr);
 	}
 
+	/* Do not keep the schedules of the removed keys, e.g. the IRK */
+	bt_crypto_key_cache_clear();
+
 	return 0;
 }
 
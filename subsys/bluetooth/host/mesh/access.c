@@ -7,6 +7,7 @@
  */
 
 #include <zephyr.h>
+#include <string.h>
 #include <errno.h>
 #include <misc/util.h>
 #include <misc/byteorder.h>
@@ -303,6 +304,76 @@ static void mod_init(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 	}
 }
 
+#if defined(CONFIG_BT_MESH_OP_TABLE)
+/* Open addressed table of the opcodes of all models. The entries of an
+ * opcode are inserted in element and model order, so that they are
+ * found in that order along its probe sequence.
+ */
+static struct op_entry {
+	u32_t opcode;
+	struct bt_mesh_model *model;
+	const struct bt_mesh_model_op *op;
+} op_table[2 * CONFIG_BT_MESH_OP_TABLE_SIZE];
+
+static u16_t op_count;
+
+static u16_t op_slot(u32_t opcode)
+{
+	return (opcode ^ (opcode >> 16)) % ARRAY_SIZE(op_table);
+}
+
+static u16_t op_slot_next(u16_t slot)
+{
+	return (slot + 1) % ARRAY_SIZE(op_table);
+}
+
+static void op_table_add(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+			 bool vnd, bool primary, void *user_data)
+{
+	const struct bt_mesh_model_op *op;
+	int *err = user_data;
+	u16_t slot;
+
+	for (op = mod->op; op->func; op++) {
+		/* Such OpCodes would never be looked up in this model */
+		if (vnd != (op->opcode >= 0x10000)) {
+			continue;
+		}
+
+		if (op_count == CONFIG_BT_MESH_OP_TABLE_SIZE) {
+			*err = -ENOMEM;
+			return;
+		}
+
+		slot = op_slot(op->opcode);
+		while (op_table[slot].op) {
+			slot = op_slot_next(slot);
+		}
+
+		op_table[slot].opcode = op->opcode;
+		op_table[slot].model = mod;
+		op_table[slot].op = op;
+		op_count++;
+	}
+}
+
+static int op_table_build(void)
+{
+	int err = 0;
+
+	(void)memset(op_table, 0, sizeof(op_table));
+	op_count = 0U;
+
+	bt_mesh_model_foreach(op_table_add, &err);
+	if (err) {
+		BT_ERR("More than %u OpCodes in the composition",
+		       CONFIG_BT_MESH_OP_TABLE_SIZE);
+	}
+
+	return err;
+}
+#endif
+
 int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 {
 	/* There must be at least one element */
@@ -314,7 +385,11 @@ int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 
 	bt_mesh_model_foreach(mod_init, NULL);
 
+#if defined(CONFIG_BT_MESH_OP_TABLE)
+	return op_table_build();
+#else
 	return 0;
+#endif
 }
 
 void bt_mesh_comp_provision(u16_t addr)
@@ -394,6 +469,21 @@ struct bt_mesh_elem *bt_mesh_elem_find(u16_t addr)
 {
 	int i;
 
+#if defined(CONFIG_BT_MESH_OP_TABLE)
+	/* Element addresses follow the primary address */
+	if (BT_MESH_ADDR_IS_UNICAST(addr)) {
+		struct bt_mesh_elem *elem;
+
+		i = addr - dev_primary_addr;
+		if (i < 0 || i >= dev_comp->elem_count) {
+			return NULL;
+		}
+
+		elem = &dev_comp->elem[i];
+		return elem->addr == addr ? elem : NULL;
+	}
+#endif
+
 	for (i = 0; i < dev_comp->elem_count; i++) {
 		struct bt_mesh_elem *elem = &dev_comp->elem[i];
 
@@ -428,6 +518,7 @@ static bool model_has_key(struct bt_mesh_model *mod, u16_t key)
 	return false;
 }
 
+#if !defined(CONFIG_BT_MESH_OP_TABLE)
 static const struct bt_mesh_model_op *find_op(struct bt_mesh_model *models,
 					      u8_t model_count, u16_t dst,
 					      u16_t app_idx, u32_t opcode,
@@ -461,6 +552,7 @@ static const struct bt_mesh_model_op *find_op(struct bt_mesh_model *models,
 	*model = NULL;
 	return NULL;
 }
+#endif
 
 static int get_opcode(struct net_buf_simple *buf, u32_t *opcode)
 {
@@ -514,6 +606,75 @@ bool bt_mesh_fixed_group_match(u16_t addr)
 	}
 }
 
+#if defined(CONFIG_BT_MESH_OP_TABLE)
+static bool model_addr_match(struct bt_mesh_model *mod, u16_t dst)
+{
+	if (BT_MESH_ADDR_IS_UNICAST(dst)) {
+		return dev_comp->elem[mod->elem_idx].addr == dst;
+	}
+
+	if (BT_MESH_ADDR_IS_GROUP(dst) || BT_MESH_ADDR_IS_VIRTUAL(dst)) {
+		return bt_mesh_model_find_group(mod, dst) != NULL;
+	}
+
+	return mod->elem_idx == 0 && bt_mesh_fixed_group_match(dst);
+}
+
+void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
+{
+	struct net_buf_simple_state state;
+	struct op_entry *entry;
+	u32_t opcode;
+	int elem_idx = -1;
+	u16_t slot;
+
+	BT_DBG("app_idx 0x%04x src 0x%04x dst 0x%04x", rx->ctx.app_idx,
+	       rx->ctx.addr, rx->ctx.recv_dst);
+	BT_DBG("len %u: %s", buf->len, bt_hex(buf->data, buf->len));
+
+	if (get_opcode(buf, &opcode) < 0) {
+		BT_WARN("Unable to decode OpCode");
+		return;
+	}
+
+	BT_DBG("OpCode 0x%08x", opcode);
+
+	for (slot = op_slot(opcode); op_table[slot].op;
+	     slot = op_slot_next(slot)) {
+		entry = &op_table[slot];
+
+		if (entry->opcode != opcode) {
+			continue;
+		}
+
+		/* Only the first matching model of each element receives
+		 * the message.
+		 */
+		if (entry->model->elem_idx == elem_idx) {
+			continue;
+		}
+
+		if (!model_addr_match(entry->model, rx->ctx.recv_dst) ||
+		    !model_has_key(entry->model, rx->ctx.app_idx)) {
+			continue;
+		}
+
+		elem_idx = entry->model->elem_idx;
+
+		if (buf->len < entry->op->min_len) {
+			BT_ERR("Too short message for OpCode 0x%08x", opcode);
+			continue;
+		}
+
+		/* The callback will likely parse the buffer, so store the
+		 * parsing state in case multiple models receive the message.
+		 */
+		net_buf_simple_save(buf, &state);
+		entry->op->func(entry->model, &rx->ctx, buf);
+		net_buf_simple_restore(buf, &state);
+	}
+}
+#else
 void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 {
 	struct bt_mesh_model *models, *model;
@@ -584,6 +745,7 @@ void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 		}
 	}
 }
+#endif
 
 void bt_mesh_model_msg_init(struct net_buf_simple *msg, u32_t opcode)
 {
@@ -23,6 +23,7 @@
 #include "common/log.h"
 
 #include "../testing.h"
+#include "../crypto.h"
 
 #include "mesh.h"
 #include "adv.h"
@@ -558,6 +559,8 @@ void bt_mesh_app_key_del(struct bt_mesh_app_key *key, bool store)
 
 	key->net_idx = BT_MESH_KEY_UNUSED;
 	(void)memset(key->keys, 0, sizeof(key->keys));
+
+	bt_crypto_key_cache_clear();
 }
 
 static void app_key_del(struct bt_mesh_model *model,
@@ -3554,4 +3557,6 @@ void bt_mesh_subnet_del(struct bt_mesh_subnet *sub, bool store)
 
 	(void)memset(sub, 0, sizeof(*sub));
 	sub->net_idx = BT_MESH_KEY_UNUSED;
+
+	bt_crypto_key_cache_clear();
 }
@@ -27,6 +27,8 @@
 #define LOG_MODULE_NAME bt_mesh_crypto
 #include "common/log.h"
 
+#include "../crypto.h"
+
 #include "mesh.h"
 #include "crypto.h"
 
@@ -203,10 +205,36 @@ int bt_mesh_id128(const u8_t n[16], const char *s, u8_t out[16])
 	return bt_mesh_k1(n, 16, salt, id128, out);
 }
 
-static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
-			       const u8_t *enc_msg, size_t msg_len,
-			       const u8_t *aad, size_t aad_len,
-			       u8_t *out_msg, size_t mic_size)
+static int aes_set_key(struct tc_aes_key_sched_struct *sched,
+		       const u8_t key[16])
+{
+#if defined(CONFIG_BT_CRYPTO_KEY_CACHE)
+	return bt_crypto_key_sched(key, sched);
+#else
+	if (tc_aes128_set_encrypt_key(sched, key) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+#endif
+}
+
+static int aes_encrypt(const struct tc_aes_key_sched_struct *sched,
+		       const u8_t in[16], u8_t out[16])
+{
+	/* TinyCrypt only reads the key schedule */
+	if (tc_aes_encrypt(out, in, (TCAesKeySched_t)sched) ==
+	    TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int ccm_decrypt(const struct tc_aes_key_sched_struct *sched,
+		       u8_t nonce[13], const u8_t *enc_msg, size_t msg_len,
+		       const u8_t *aad, size_t aad_len, u8_t *out_msg,
+		       size_t mic_size)
 {
 	u8_t msg[16], pmsg[16], cmic[16], cmsg[16], Xn[16], mic[16];
 	u16_t last_blk, blk_cnt;
@@ -222,7 +250,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 	memcpy(pmsg + 1, nonce, 13);
 	sys_put_be16(0x0000, pmsg + 14);
 
-	err = bt_encrypt_be(key, pmsg, cmic);
+	err = aes_encrypt(sched, pmsg, cmic);
 	if (err) {
 		return err;
 	}
@@ -237,7 +265,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 	memcpy(pmsg + 1, nonce, 13);
 	sys_put_be16(msg_len, pmsg + 14);
 
-	err = bt_encrypt_be(key, pmsg, Xn);
+	err = aes_encrypt(sched, pmsg, Xn);
 	if (err) {
 		return err;
 	}
@@ -261,7 +289,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 			aad_len -= 16;
 			i = 0;
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -275,7 +303,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 			pmsg[i] = Xn[i];
 		}
 
-		err = bt_encrypt_be(key, pmsg, Xn);
+		err = aes_encrypt(sched, pmsg, Xn);
 		if (err) {
 			return err;
 		}
@@ -294,7 +322,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 			memcpy(pmsg + 1, nonce, 13);
 			sys_put_be16(j + 1, pmsg + 14);
 
-			err = bt_encrypt_be(key, pmsg, cmsg);
+			err = aes_encrypt(sched, pmsg, cmsg);
 			if (err) {
 				return err;
 			}
@@ -315,7 +343,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 				pmsg[i] = Xn[i] ^ 0x00;
 			}
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -330,7 +358,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 			memcpy(pmsg + 1, nonce, 13);
 			sys_put_be16(j + 1, pmsg + 14);
 
-			err = bt_encrypt_be(key, pmsg, cmsg);
+			err = aes_encrypt(sched, pmsg, cmsg);
 			if (err) {
 				return err;
 			}
@@ -347,7 +375,7 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 				pmsg[i] = Xn[i] ^ msg[i];
 			}
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -361,17 +389,16 @@ static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
 	return 0;
 }
 
-static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
-			       const u8_t *msg, size_t msg_len,
-			       const u8_t *aad, size_t aad_len,
-			       u8_t *out_msg, size_t mic_size)
+static int ccm_encrypt(const struct tc_aes_key_sched_struct *sched,
+		       u8_t nonce[13], const u8_t *msg, size_t msg_len,
+		       const u8_t *aad, size_t aad_len, u8_t *out_msg,
+		       size_t mic_size)
 {
 	u8_t pmsg[16], cmic[16], cmsg[16], mic[16], Xn[16];
 	u16_t blk_cnt, last_blk;
 	size_t i, j;
 	int err;
 
-	BT_DBG("key %s", bt_hex(key, 16));
 	BT_DBG("nonce %s", bt_hex(nonce, 13));
 	BT_DBG("msg (len %zu) %s", msg_len, bt_hex(msg, msg_len));
 	BT_DBG("aad_len %zu mic_size %zu", aad_len, mic_size);
@@ -386,7 +413,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 	memcpy(pmsg + 1, nonce, 13);
 	sys_put_be16(0x0000, pmsg + 14);
 
-	err = bt_encrypt_be(key, pmsg, cmic);
+	err = aes_encrypt(sched, pmsg, cmic);
 	if (err) {
 		return err;
 	}
@@ -401,7 +428,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 	memcpy(pmsg + 1, nonce, 13);
 	sys_put_be16(msg_len, pmsg + 14);
 
-	err = bt_encrypt_be(key, pmsg, Xn);
+	err = aes_encrypt(sched, pmsg, Xn);
 	if (err) {
 		return err;
 	}
@@ -425,7 +452,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 			aad_len -= 16;
 			i = 0;
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -439,7 +466,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 			pmsg[i] = Xn[i];
 		}
 
-		err = bt_encrypt_be(key, pmsg, Xn);
+		err = aes_encrypt(sched, pmsg, Xn);
 		if (err) {
 			return err;
 		}
@@ -461,7 +488,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 				pmsg[i] = Xn[i] ^ 0x00;
 			}
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -476,7 +503,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 			memcpy(pmsg + 1, nonce, 13);
 			sys_put_be16(j + 1, pmsg + 14);
 
-			err = bt_encrypt_be(key, pmsg, cmsg);
+			err = aes_encrypt(sched, pmsg, cmsg);
 			if (err) {
 				return err;
 			}
@@ -492,7 +519,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 				pmsg[i] = Xn[i] ^ msg[(j * 16) + i];
 			}
 
-			err = bt_encrypt_be(key, pmsg, Xn);
+			err = aes_encrypt(sched, pmsg, Xn);
 			if (err) {
 				return err;
 			}
@@ -502,7 +529,7 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 			memcpy(pmsg + 1, nonce, 13);
 			sys_put_be16(j + 1, pmsg + 14);
 
-			err = bt_encrypt_be(key, pmsg, cmsg);
+			err = aes_encrypt(sched, pmsg, cmsg);
 			if (err) {
 				return err;
 			}
@@ -521,6 +548,51 @@ static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
 	return 0;
 }
 
+static int bt_mesh_ccm_decrypt(const u8_t key[16], u8_t nonce[13],
+			       const u8_t *enc_msg, size_t msg_len,
+			       const u8_t *aad, size_t aad_len,
+			       u8_t *out_msg, size_t mic_size)
+{
+	struct tc_aes_key_sched_struct sched;
+	int err;
+
+	err = aes_set_key(&sched, key);
+	if (err) {
+		return err;
+	}
+
+	err = ccm_decrypt(&sched, nonce, enc_msg, msg_len, aad, aad_len,
+			  out_msg, mic_size);
+
+	/* Do not leave a copy of the key schedule on the stack */
+	_set(&sched, 0, sizeof(sched));
+
+	return err;
+}
+
+static int bt_mesh_ccm_encrypt(const u8_t key[16], u8_t nonce[13],
+			       const u8_t *msg, size_t msg_len,
+			       const u8_t *aad, size_t aad_len,
+			       u8_t *out_msg, size_t mic_size)
+{
+	struct tc_aes_key_sched_struct sched;
+	int err;
+
+	BT_DBG("key %s", bt_hex(key, 16));
+
+	err = aes_set_key(&sched, key);
+	if (err) {
+		return err;
+	}
+
+	err = ccm_encrypt(&sched, nonce, msg, msg_len, aad, aad_len,
+			  out_msg, mic_size);
+
+	_set(&sched, 0, sizeof(sched));
+
+	return err;
+}
+
 #if defined(CONFIG_BT_MESH_PROXY)
 static void create_proxy_nonce(u8_t nonce[13], const u8_t *pdu,
 			       u32_t iv_index)
@@ -575,21 +647,21 @@ static void create_net_nonce(u8_t nonce[13], const u8_t *pdu,
 	sys_put_be32(iv_index, &nonce[9]);
 }
 
-int bt_mesh_net_obfuscate(u8_t *pdu, u32_t iv_index,
-			  const u8_t privacy_key[16])
+int bt_mesh_net_obfuscate_sched(u8_t *pdu, u32_t iv_index,
+				const struct tc_aes_key_sched_struct *privacy)
 {
 	u8_t priv_rand[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, };
 	u8_t tmp[16];
 	int err, i;
 
-	BT_DBG("IVIndex %u, PrivacyKey %s", iv_index, bt_hex(privacy_key, 16));
+	BT_DBG("IVIndex %u", iv_index);
 
 	sys_put_be32(iv_index, &priv_rand[5]);
 	memcpy(&priv_rand[9], &pdu[7], 7);
 
 	BT_DBG("PrivacyRandom %s", bt_hex(priv_rand, 16));
 
-	err = bt_encrypt_be(privacy_key, priv_rand, tmp);
+	err = aes_encrypt(privacy, priv_rand, tmp);
 	if (err) {
 		return err;
 	}
@@ -601,15 +673,35 @@ int bt_mesh_net_obfuscate(u8_t *pdu, u32_t iv_index,
 	return 0;
 }
 
-int bt_mesh_net_encrypt(const u8_t key[16], struct net_buf_simple *buf,
-			u32_t iv_index, bool proxy)
+int bt_mesh_net_obfuscate(u8_t *pdu, u32_t iv_index,
+			  const u8_t privacy_key[16])
+{
+	struct tc_aes_key_sched_struct sched;
+	int err;
+
+	BT_DBG("PrivacyKey %s", bt_hex(privacy_key, 16));
+
+	err = aes_set_key(&sched, privacy_key);
+	if (err) {
+		return err;
+	}
+
+	err = bt_mesh_net_obfuscate_sched(pdu, iv_index, &sched);
+
+	_set(&sched, 0, sizeof(sched));
+
+	return err;
+}
+
+int bt_mesh_net_encrypt_sched(const struct tc_aes_key_sched_struct *enc,
+			      struct net_buf_simple *buf, u32_t iv_index,
+			      bool proxy)
 {
 	u8_t mic_len = NET_MIC_LEN(buf->data);
 	u8_t nonce[13];
 	int err;
 
-	BT_DBG("IVIndex %u EncKey %s mic_len %u", iv_index, bt_hex(key, 16),
-	       mic_len);
+	BT_DBG("IVIndex %u mic_len %u", iv_index, mic_len);
 	BT_DBG("PDU (len %u) %s", buf->len, bt_hex(buf->data, buf->len));
 
 #if defined(CONFIG_BT_MESH_PROXY)
@@ -624,8 +716,8 @@ int bt_mesh_net_encrypt(const u8_t key[16], struct net_buf_simple *buf,
 
 	BT_DBG("Nonce %s", bt_hex(nonce, 13));
 
-	err = bt_mesh_ccm_encrypt(key, nonce, &buf->data[7], buf->len - 7,
-				  NULL, 0, &buf->data[7], mic_len);
+	err = ccm_encrypt(enc, nonce, &buf->data[7], buf->len - 7, NULL, 0,
+			  &buf->data[7], mic_len);
 	if (!err) {
 		net_buf_simple_add(buf, mic_len);
 	}
@@ -633,15 +725,35 @@ int bt_mesh_net_encrypt(const u8_t key[16], struct net_buf_simple *buf,
 	return err;
 }
 
-int bt_mesh_net_decrypt(const u8_t key[16], struct net_buf_simple *buf,
+int bt_mesh_net_encrypt(const u8_t key[16], struct net_buf_simple *buf,
 			u32_t iv_index, bool proxy)
+{
+	struct tc_aes_key_sched_struct sched;
+	int err;
+
+	BT_DBG("EncKey %s", bt_hex(key, 16));
+
+	err = aes_set_key(&sched, key);
+	if (err) {
+		return err;
+	}
+
+	err = bt_mesh_net_encrypt_sched(&sched, buf, iv_index, proxy);
+
+	_set(&sched, 0, sizeof(sched));
+
+	return err;
+}
+
+int bt_mesh_net_decrypt_sched(const struct tc_aes_key_sched_struct *enc,
+			      struct net_buf_simple *buf, u32_t iv_index,
+			      bool proxy)
 {
 	u8_t mic_len = NET_MIC_LEN(buf->data);
 	u8_t nonce[13];
 
 	BT_DBG("PDU (%u bytes) %s", buf->len, bt_hex(buf->data, buf->len));
-	BT_DBG("iv_index %u, key %s mic_len %u", iv_index, bt_hex(key, 16),
-	       mic_len);
+	BT_DBG("iv_index %u, mic_len %u", iv_index, mic_len);
 
 #if defined(CONFIG_BT_MESH_PROXY)
 	if (proxy) {
@@ -657,8 +769,28 @@ int bt_mesh_net_decrypt(const u8_t key[16], struct net_buf_simple *buf,
 
 	buf->len -= mic_len;
 
-	return bt_mesh_ccm_decrypt(key, nonce, &buf->data[7], buf->len - 7,
-				   NULL, 0, &buf->data[7], mic_len);
+	return ccm_decrypt(enc, nonce, &buf->data[7], buf->len - 7, NULL, 0,
+			   &buf->data[7], mic_len);
+}
+
+int bt_mesh_net_decrypt(const u8_t key[16], struct net_buf_simple *buf,
+			u32_t iv_index, bool proxy)
+{
+	struct tc_aes_key_sched_struct sched;
+	int err;
+
+	BT_DBG("key %s", bt_hex(key, 16));
+
+	err = aes_set_key(&sched, key);
+	if (err) {
+		return err;
+	}
+
+	err = bt_mesh_net_decrypt_sched(&sched, buf, iv_index, proxy);
+
+	_set(&sched, 0, sizeof(sched));
+
+	return err;
 }
 
 static void create_app_nonce(u8_t nonce[13], bool dev_key, u8_t aszmic,
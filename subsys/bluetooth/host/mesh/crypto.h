@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <tinycrypt/aes.h>
+
 struct bt_mesh_sg {
 	const void *data;
 	size_t len;
@@ -127,6 +129,18 @@ int bt_mesh_net_encrypt(const u8_t key[16], struct net_buf_simple *buf,
 int bt_mesh_net_decrypt(const u8_t key[16], struct net_buf_simple *buf,
 			u32_t iv_index, bool proxy);
 
+/* Same as above, with the key already expanded into its AES key schedule */
+int bt_mesh_net_obfuscate_sched(u8_t *pdu, u32_t iv_index,
+				const struct tc_aes_key_sched_struct *privacy);
+
+int bt_mesh_net_encrypt_sched(const struct tc_aes_key_sched_struct *enc,
+			      struct net_buf_simple *buf, u32_t iv_index,
+			      bool proxy);
+
+int bt_mesh_net_decrypt_sched(const struct tc_aes_key_sched_struct *enc,
+			      struct net_buf_simple *buf, u32_t iv_index,
+			      bool proxy);
+
 int bt_mesh_app_encrypt(const u8_t key[16], bool dev_key, u8_t aszmic,
 			struct net_buf_simple *buf, const u8_t *ad,
 			u16_t src, u16_t dst, u32_t seq_num, u32_t iv_index);
@@ -20,6 +20,8 @@
 #define LOG_MODULE_NAME bt_mesh_main
 #include "common/log.h"
 
+#include "../crypto.h"
+
 #include "test.h"
 #include "adv.h"
 #include "prov.h"
@@ -124,6 +126,8 @@ void bt_mesh_reset(void)
 
 	(void)memset(bt_mesh.dev_key, 0, sizeof(bt_mesh.dev_key));
 
+	bt_crypto_key_cache_clear();
+
 	bt_mesh_scan_disable();
 	bt_mesh_beacon_disable();
 
@@ -19,10 +19,14 @@
 #include <bluetooth/conn.h>
 #include <bluetooth/mesh.h>
 
+#include <tinycrypt/constants.h>
+#include <tinycrypt/aes.h>
+
 #define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_MESH_DEBUG_NET)
 #define LOG_MODULE_NAME bt_mesh_net
 #include "common/log.h"
 
+#include "../crypto.h"
 #include "crypto.h"
 #include "adv.h"
 #include "mesh.h"
@@ -73,6 +77,27 @@ static struct friend_cred friend_cred[FRIEND_CRED_COUNT];
 static u64_t msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static u16_t msg_cache_next;
 
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+#define MSG_CACHE_INDEX_FREE 0xffff
+
+/* Ring positions of the cached messages, open addressed by hash */
+static u16_t msg_cache_index[2 * CONFIG_BT_MESH_MSG_CACHE_SIZE] = {
+	[0 ... (2 * CONFIG_BT_MESH_MSG_CACHE_SIZE - 1)] = MSG_CACHE_INDEX_FREE,
+};
+#endif
+
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+#define NID_KEY(sub, gen) (((sub) << 1) | (gen))
+#define NID_KEY_SUB(key)  ((key) >> 1)
+#define NID_KEY_GEN(key)  ((key) & 0x01)
+
+/* Key generations of all subnets, sorted by NID. The ones with a given
+ * NID are found from nid_keys_first[nid] up to nid_keys_first[nid + 1].
+ */
+static u16_t nid_keys[2 * CONFIG_BT_MESH_SUBNET_COUNT];
+static u16_t nid_keys_first[128 + 1];
+#endif
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -124,6 +149,100 @@ static u64_t msg_hash(struct bt_mesh_net_rx *rx, struct net_buf_simple *pdu)
 	return (u64_t)hash1 << 32 | (u64_t)hash2;
 }
 
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+static int msg_cache_slot(u64_t hash)
+{
+	return (u32_t)(hash ^ (hash >> 32)) % ARRAY_SIZE(msg_cache_index);
+}
+
+static int msg_cache_slot_next(int i)
+{
+	return (i + 1) % ARRAY_SIZE(msg_cache_index);
+}
+
+/* Index slot of the cached message at ring position pos */
+static int msg_cache_find_pos(u16_t pos)
+{
+	int i;
+
+	for (i = msg_cache_slot(msg_cache[pos]);
+	     msg_cache_index[i] != MSG_CACHE_INDEX_FREE;
+	     i = msg_cache_slot_next(i)) {
+		if (msg_cache_index[i] == pos) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static bool msg_cache_find(u64_t hash)
+{
+	int i;
+
+	for (i = msg_cache_slot(hash);
+	     msg_cache_index[i] != MSG_CACHE_INDEX_FREE;
+	     i = msg_cache_slot_next(i)) {
+		if (msg_cache[msg_cache_index[i]] == hash) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void msg_cache_unindex(int i)
+{
+	int j, home;
+
+	/* Move back the entries further down the probe sequence which
+	 * would otherwise become unreachable, so no tombstones are needed.
+	 */
+	for (j = msg_cache_slot_next(i);
+	     msg_cache_index[j] != MSG_CACHE_INDEX_FREE;
+	     j = msg_cache_slot_next(j)) {
+		home = msg_cache_slot(msg_cache[msg_cache_index[j]]);
+
+		if ((i < j && (home <= i || home > j)) ||
+		    (i > j && home <= i && home > j)) {
+			msg_cache_index[i] = msg_cache_index[j];
+			i = j;
+		}
+	}
+
+	msg_cache_index[i] = MSG_CACHE_INDEX_FREE;
+}
+
+static bool msg_cache_match(struct bt_mesh_net_rx *rx,
+			    struct net_buf_simple *pdu)
+{
+	u64_t hash = msg_hash(rx, pdu);
+	int i;
+
+	if (msg_cache_find(hash)) {
+		return true;
+	}
+
+	/* Drop the oldest message, which is about to be overwritten */
+	i = msg_cache_find_pos(msg_cache_next);
+	if (i >= 0) {
+		msg_cache_unindex(i);
+	}
+
+	for (i = msg_cache_slot(hash);
+	     msg_cache_index[i] != MSG_CACHE_INDEX_FREE;
+	     i = msg_cache_slot_next(i)) {
+	}
+
+	msg_cache_index[i] = msg_cache_next;
+
+	/* Add to the cache */
+	msg_cache[msg_cache_next++] = hash;
+	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	return false;
+}
+#else
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 			    struct net_buf_simple *pdu)
 {
@@ -142,6 +261,7 @@ static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 
 	return false;
 }
+#endif /* CONFIG_BT_MESH_CACHE_HASH */
 
 struct bt_mesh_subnet *bt_mesh_subnet_get(u16_t net_idx)
 {
@@ -160,6 +280,36 @@ struct bt_mesh_subnet *bt_mesh_subnet_get(u16_t net_idx)
 	return NULL;
 }
 
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+static void nid_keys_update(void)
+{
+	int i, gen, nid;
+
+	(void)memset(nid_keys_first, 0, sizeof(nid_keys_first));
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.sub); i++) {
+		for (gen = 0; gen < ARRAY_SIZE(bt_mesh.sub[i].keys); gen++) {
+			nid_keys_first[bt_mesh.sub[i].keys[gen].nid & 0x7f]++;
+		}
+	}
+
+	/* Turn the counts into bucket ends, then fill the buckets from
+	 * the back to keep the subnet order within each of them.
+	 */
+	for (nid = 1; nid < ARRAY_SIZE(nid_keys_first); nid++) {
+		nid_keys_first[nid] += nid_keys_first[nid - 1];
+	}
+
+	for (i = ARRAY_SIZE(bt_mesh.sub) - 1; i >= 0; i--) {
+		for (gen = ARRAY_SIZE(bt_mesh.sub[i].keys) - 1; gen >= 0;
+		     gen--) {
+			nid = bt_mesh.sub[i].keys[gen].nid & 0x7f;
+			nid_keys[--nid_keys_first[nid]] = NID_KEY(i, gen);
+		}
+	}
+}
+#endif
+
 int bt_mesh_net_keys_create(struct bt_mesh_subnet_keys *keys,
 			    const u8_t key[16])
 {
@@ -180,6 +330,18 @@ int bt_mesh_net_keys_create(struct bt_mesh_subnet_keys *keys,
 	BT_DBG("NID 0x%02x EncKey %s", keys->nid, bt_hex(keys->enc, 16));
 	BT_DBG("PrivacyKey %s", bt_hex(keys->privacy, 16));
 
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+	if (tc_aes128_set_encrypt_key(&keys->enc_sched,
+				      keys->enc) == TC_CRYPTO_FAIL ||
+	    tc_aes128_set_encrypt_key(&keys->privacy_sched,
+				      keys->privacy) == TC_CRYPTO_FAIL) {
+		BT_ERR("Unable to expand EncKey & PrivacyKey");
+		return -EIO;
+	}
+
+	nid_keys_update();
+#endif
+
 	err = bt_mesh_k3(key, keys->net_id);
 	if (err) {
 		BT_ERR("Unable to generate Net ID");
@@ -450,6 +612,9 @@ int bt_mesh_net_create(u16_t idx, u8_t flags, const u8_t key[16],
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
 	msg_cache_next = 0U;
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+	(void)memset(msg_cache_index, 0xff, sizeof(msg_cache_index));
+#endif
 
 	sub = &bt_mesh.sub[0];
 
@@ -500,6 +665,10 @@ void bt_mesh_net_revoke_keys(struct bt_mesh_subnet *sub)
 
 	memcpy(&sub->keys[0], &sub->keys[1], sizeof(sub->keys[0]));
 
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+	nid_keys_update();
+#endif
+
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.app_keys); i++) {
 		struct bt_mesh_app_key *key = &bt_mesh.app_keys[i];
 
@@ -510,6 +679,9 @@ void bt_mesh_net_revoke_keys(struct bt_mesh_subnet *sub)
 		memcpy(&key->keys[0], &key->keys[1], sizeof(key->keys[0]));
 		key->updated = false;
 	}
+
+	/* The old keys are no longer used, drop their schedules */
+	bt_crypto_key_cache_clear();
 }
 
 bool bt_mesh_kr_update(struct bt_mesh_subnet *sub, u8_t new_kr, bool new_key)
@@ -574,6 +746,8 @@ void bt_mesh_rpl_reset(void)
 			}
 		}
 	}
+
+	bt_mesh_rpl_reindex();
 }
 
 #if defined(CONFIG_BT_MESH_IV_UPDATE_TEST)
@@ -651,7 +825,7 @@ bool bt_mesh_net_iv_update(u32_t iv_index, bool iv_update)
 
 		if (iv_index > bt_mesh.iv_index + 1) {
 			BT_WARN("Performing IV Index Recovery");
-			(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+			bt_mesh_rpl_clear();
 			bt_mesh.iv_index = iv_index;
 			bt_mesh.seq = 0U;
 			goto do_update;
@@ -980,8 +1154,41 @@ struct bt_mesh_subnet *bt_mesh_subnet_find(const u8_t net_id[8], u8_t flags,
 	return NULL;
 }
 
-static int net_decrypt(struct bt_mesh_subnet *sub, const u8_t *enc,
-		       const u8_t *priv, const u8_t *data,
+/* The cached key schedules of keys are used when available, friendship
+ * credentials only come with the plain EncKey and PrivacyKey.
+ */
+static int net_obfuscate_rx(const struct bt_mesh_subnet_keys *keys,
+			    const u8_t *priv, struct bt_mesh_net_rx *rx,
+			    struct net_buf_simple *buf)
+{
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+	if (keys) {
+		return bt_mesh_net_obfuscate_sched(buf->data,
+						   BT_MESH_NET_IVI_RX(rx),
+						   &keys->privacy_sched);
+	}
+#endif
+
+	return bt_mesh_net_obfuscate(buf->data, BT_MESH_NET_IVI_RX(rx), priv);
+}
+
+static int net_decrypt_rx(const struct bt_mesh_subnet_keys *keys,
+			  const u8_t *enc, struct bt_mesh_net_rx *rx,
+			  struct net_buf_simple *buf, bool proxy)
+{
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+	if (keys) {
+		return bt_mesh_net_decrypt_sched(&keys->enc_sched, buf,
+						 BT_MESH_NET_IVI_RX(rx), proxy);
+	}
+#endif
+
+	return bt_mesh_net_decrypt(enc, buf, BT_MESH_NET_IVI_RX(rx), proxy);
+}
+
+static int net_decrypt(struct bt_mesh_subnet *sub,
+		       const struct bt_mesh_subnet_keys *keys,
+		       const u8_t *enc, const u8_t *priv, const u8_t *data,
 		       size_t data_len, struct bt_mesh_net_rx *rx,
 		       struct net_buf_simple *buf)
 {
@@ -993,7 +1200,7 @@ static int net_decrypt(struct bt_mesh_subnet *sub, const u8_t *enc,
 	net_buf_simple_reset(buf);
 	memcpy(net_buf_simple_add(buf, data_len), data, data_len);
 
-	if (bt_mesh_net_obfuscate(buf->data, BT_MESH_NET_IVI_RX(rx), priv)) {
+	if (net_obfuscate_rx(keys, priv, rx, buf)) {
 		return -ENOENT;
 	}
 
@@ -1012,13 +1219,97 @@ static int net_decrypt(struct bt_mesh_subnet *sub, const u8_t *enc,
 
 	if (IS_ENABLED(CONFIG_BT_MESH_PROXY) &&
 	    rx->net_if == BT_MESH_NET_IF_PROXY_CFG) {
-		return bt_mesh_net_decrypt(enc, buf, BT_MESH_NET_IVI_RX(rx),
-					   true);
+		return net_decrypt_rx(keys, enc, rx, buf, true);
+	}
+
+	return net_decrypt_rx(keys, enc, rx, buf, false);
+}
+
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+#if (defined(CONFIG_BT_MESH_LOW_POWER) || \
+     defined(CONFIG_BT_MESH_FRIEND))
+static bool friend_find_and_decrypt(const u8_t *data, size_t data_len,
+				    struct bt_mesh_net_rx *rx,
+				    struct net_buf_simple *buf)
+{
+	struct bt_mesh_subnet *sub;
+	int i, gen;
+
+	for (i = 0; i < ARRAY_SIZE(friend_cred); i++) {
+		struct friend_cred *cred = &friend_cred[i];
+
+		if (cred->net_idx == BT_MESH_KEY_UNUSED) {
+			continue;
+		}
+
+		for (gen = 0; gen < ARRAY_SIZE(cred->cred); gen++) {
+			if (NID(data) != cred->cred[gen].nid) {
+				continue;
+			}
+
+			sub = bt_mesh_subnet_get(cred->net_idx);
+			if (!sub ||
+			    (gen && sub->kr_phase == BT_MESH_KR_NORMAL)) {
+				continue;
+			}
+
+			if (!net_decrypt(sub, NULL, cred->cred[gen].enc,
+					 cred->cred[gen].privacy, data,
+					 data_len, rx, buf)) {
+				rx->new_key = gen;
+				rx->friend_cred = 1U;
+				rx->ctx.net_idx = sub->net_idx;
+				rx->sub = sub;
+				return true;
+			}
+		}
 	}
 
-	return bt_mesh_net_decrypt(enc, buf, BT_MESH_NET_IVI_RX(rx), false);
+	return false;
 }
+#endif
+
+static bool net_find_and_decrypt(const u8_t *data, size_t data_len,
+				 struct bt_mesh_net_rx *rx,
+				 struct net_buf_simple *buf)
+{
+	struct bt_mesh_subnet_keys *keys;
+	struct bt_mesh_subnet *sub;
+	u8_t nid = NID(data);
+	int i, gen;
+
+	BT_DBG("");
+
+#if (defined(CONFIG_BT_MESH_LOW_POWER) || \
+     defined(CONFIG_BT_MESH_FRIEND))
+	if (friend_find_and_decrypt(data, data_len, rx, buf)) {
+		return true;
+	}
+#endif
+
+	for (i = nid_keys_first[nid]; i < nid_keys_first[nid + 1]; i++) {
+		sub = &bt_mesh.sub[NID_KEY_SUB(nid_keys[i])];
+		gen = NID_KEY_GEN(nid_keys[i]);
+		keys = &sub->keys[gen];
+
+		/* The index is only rebuilt when NIDs change */
+		if (sub->net_idx == BT_MESH_KEY_UNUSED || keys->nid != nid ||
+		    (gen && sub->kr_phase == BT_MESH_KR_NORMAL)) {
+			continue;
+		}
+
+		if (!net_decrypt(sub, keys, keys->enc, keys->privacy, data,
+				 data_len, rx, buf)) {
+			rx->new_key = gen;
+			rx->ctx.net_idx = sub->net_idx;
+			rx->sub = sub;
+			return true;
+		}
+	}
 
+	return false;
+}
+#else
 #if (defined(CONFIG_BT_MESH_LOW_POWER) || \
      defined(CONFIG_BT_MESH_FRIEND))
 static int friend_decrypt(struct bt_mesh_subnet *sub, const u8_t *data,
@@ -1037,8 +1328,9 @@ static int friend_decrypt(struct bt_mesh_subnet *sub, const u8_t *data,
 		}
 
 		if (NID(data) == cred->cred[0].nid &&
-		    !net_decrypt(sub, cred->cred[0].enc, cred->cred[0].privacy,
-				 data, data_len, rx, buf)) {
+		    !net_decrypt(sub, NULL, cred->cred[0].enc,
+				 cred->cred[0].privacy, data, data_len, rx,
+				 buf)) {
 			return 0;
 		}
 
@@ -1047,8 +1339,9 @@ static int friend_decrypt(struct bt_mesh_subnet *sub, const u8_t *data,
 		}
 
 		if (NID(data) == cred->cred[1].nid &&
-		    !net_decrypt(sub, cred->cred[1].enc, cred->cred[1].privacy,
-				 data, data_len, rx, buf)) {
+		    !net_decrypt(sub, NULL, cred->cred[1].enc,
+				 cred->cred[1].privacy, data, data_len, rx,
+				 buf)) {
 			rx->new_key = 1U;
 			return 0;
 		}
@@ -1084,8 +1377,9 @@ static bool net_find_and_decrypt(const u8_t *data, size_t data_len,
 #endif
 
 		if (NID(data) == sub->keys[0].nid &&
-		    !net_decrypt(sub, sub->keys[0].enc, sub->keys[0].privacy,
-				 data, data_len, rx, buf)) {
+		    !net_decrypt(sub, NULL, sub->keys[0].enc,
+				 sub->keys[0].privacy, data, data_len, rx,
+				 buf)) {
 			rx->ctx.net_idx = sub->net_idx;
 			rx->sub = sub;
 			return true;
@@ -1096,8 +1390,9 @@ static bool net_find_and_decrypt(const u8_t *data, size_t data_len,
 		}
 
 		if (NID(data) == sub->keys[1].nid &&
-		    !net_decrypt(sub, sub->keys[1].enc, sub->keys[1].privacy,
-				 data, data_len, rx, buf)) {
+		    !net_decrypt(sub, NULL, sub->keys[1].enc,
+				 sub->keys[1].privacy, data, data_len, rx,
+				 buf)) {
 			rx->new_key = 1U;
 			rx->ctx.net_idx = sub->net_idx;
 			rx->sub = sub;
@@ -1107,6 +1402,7 @@ static bool net_find_and_decrypt(const u8_t *data, size_t data_len,
 
 	return false;
 }
+#endif /* CONFIG_BT_MESH_NET_KEY_CACHE */
 
 /* Relaying from advertising to the advertising bearer should only happen
  * if the Relay state is set to enabled. Locally originated packets always
@@ -1130,7 +1426,7 @@ static bool relay_to_adv(enum bt_mesh_net_if net_if)
 static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 			      struct bt_mesh_net_rx *rx)
 {
-	const u8_t *enc, *priv;
+	const struct bt_mesh_subnet_keys *keys;
 	struct net_buf *buf;
 	u8_t nid, transmit;
 
@@ -1184,9 +1480,8 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 
 	net_buf_add_mem(buf, sbuf->data, sbuf->len);
 
-	enc = rx->sub->keys[rx->sub->kr_flag].enc;
-	priv = rx->sub->keys[rx->sub->kr_flag].privacy;
-	nid = rx->sub->keys[rx->sub->kr_flag].nid;
+	keys = &rx->sub->keys[rx->sub->kr_flag];
+	nid = keys->nid;
 
 	BT_DBG("Relaying packet. TTL is now %u", TTL(buf->data));
 
@@ -1200,15 +1495,31 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 	 * the normal TX IVI (which may be different) since the transport
 	 * layer nonce includes the IVI.
 	 */
-	if (bt_mesh_net_encrypt(enc, &buf->b, BT_MESH_NET_IVI_RX(rx), false)) {
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+	if (bt_mesh_net_encrypt_sched(&keys->enc_sched, &buf->b,
+				      BT_MESH_NET_IVI_RX(rx), false)) {
+		BT_ERR("Re-encrypting failed");
+		goto done;
+	}
+
+	if (bt_mesh_net_obfuscate_sched(buf->data, BT_MESH_NET_IVI_RX(rx),
+					&keys->privacy_sched)) {
+		BT_ERR("Re-obfuscating failed");
+		goto done;
+	}
+#else
+	if (bt_mesh_net_encrypt(keys->enc, &buf->b, BT_MESH_NET_IVI_RX(rx),
+				false)) {
 		BT_ERR("Re-encrypting failed");
 		goto done;
 	}
 
-	if (bt_mesh_net_obfuscate(buf->data, BT_MESH_NET_IVI_RX(rx), priv)) {
+	if (bt_mesh_net_obfuscate(buf->data, BT_MESH_NET_IVI_RX(rx),
+				  keys->privacy)) {
 		BT_ERR("Re-obfuscating failed");
 		goto done;
 	}
+#endif
 
 	/* Sending to the GATT bearer should only happen if GATT Proxy
 	 * is enabled or the message originates from the local node.
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <tinycrypt/aes.h>
+
 #define BT_MESH_NET_FLAG_KR       BIT(0)
 #define BT_MESH_NET_FLAG_IVU      BIT(1)
 
@@ -64,6 +66,11 @@ struct bt_mesh_subnet {
 #endif
 		u8_t privacy[16];   /* PrivacyKey */
 		u8_t beacon[16];    /* BeaconKey */
+#if defined(CONFIG_BT_MESH_NET_KEY_CACHE)
+		/* EncKey and PrivacyKey expanded for AES */
+		struct tc_aes_key_sched_struct enc_sched;
+		struct tc_aes_key_sched_struct privacy_sched;
+#endif
 	} keys[2];
 };
 
@@ -239,33 +239,6 @@ static int seq_set(int argc, char **argv, void *val_ctx)
 	return 0;
 }
 
-static struct bt_mesh_rpl *rpl_find(u16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		if (bt_mesh.rpl[i].src == src) {
-			return &bt_mesh.rpl[i];
-		}
-	}
-
-	return NULL;
-}
-
-static struct bt_mesh_rpl *rpl_alloc(u16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		if (!bt_mesh.rpl[i].src) {
-			bt_mesh.rpl[i].src = src;
-			return &bt_mesh.rpl[i];
-		}
-	}
-
-	return NULL;
-}
-
 static int rpl_set(int argc, char **argv, void *val_ctx)
 {
 	struct bt_mesh_rpl *entry;
@@ -279,12 +252,13 @@ static int rpl_set(int argc, char **argv, void *val_ctx)
 	}
 
 	src = strtol(argv[0], NULL, 16);
-	entry = rpl_find(src);
+	entry = bt_mesh_rpl_find(src);
 
 	if (settings_val_get_len_cb(val_ctx) == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
 			(void)memset(entry, 0, sizeof(*entry));
+			bt_mesh_rpl_reindex();
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -293,7 +267,7 @@ static int rpl_set(int argc, char **argv, void *val_ctx)
 	}
 
 	if (!entry) {
-		entry = rpl_alloc(src);
+		entry = bt_mesh_rpl_alloc(src);
 		if (!entry) {
 			BT_ERR("Unable to allocate RPL entry for 0x%04x", src);
 			return -ENOMEM;
@@ -960,6 +934,8 @@ static void clear_rpl(void)
 
 		(void)memset(rpl, 0, sizeof(*rpl));
 	}
+
+	bt_mesh_rpl_reindex();
 }
 
 static void store_pending_rpl(void)
@@ -531,54 +531,133 @@ int bt_mesh_trans_resend(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
 	return err;
 }
 
-static bool is_replay(struct bt_mesh_net_rx *rx)
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+#define RPL_INDEX_FREE 0xffff
+
+/* Positions of the bt_mesh.rpl entries, open addressed by source */
+static u16_t rpl_index[2 * CONFIG_BT_MESH_CRPL] = {
+	[0 ... (2 * CONFIG_BT_MESH_CRPL - 1)] = RPL_INDEX_FREE,
+};
+
+static int rpl_slot(u16_t src)
+{
+	/* Unicast addresses tend to be allocated contiguously */
+	return src % ARRAY_SIZE(rpl_index);
+}
+
+static int rpl_slot_next(int i)
+{
+	return (i + 1) % ARRAY_SIZE(rpl_index);
+}
+
+static void rpl_index_add(u16_t pos)
 {
 	int i;
 
+	for (i = rpl_slot(bt_mesh.rpl[pos].src);
+	     rpl_index[i] != RPL_INDEX_FREE; i = rpl_slot_next(i)) {
+	}
+
+	rpl_index[i] = pos;
+}
+#endif /* CONFIG_BT_MESH_CACHE_HASH */
+
+struct bt_mesh_rpl *bt_mesh_rpl_find(u16_t src)
+{
+	int i;
+
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+	for (i = rpl_slot(src); rpl_index[i] != RPL_INDEX_FREE;
+	     i = rpl_slot_next(i)) {
+		if (bt_mesh.rpl[rpl_index[i]].src == src) {
+			return &bt_mesh.rpl[rpl_index[i]];
+		}
+	}
+#else
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		if (bt_mesh.rpl[i].src == src) {
+			return &bt_mesh.rpl[i];
+		}
+	}
+#endif
+
+	return NULL;
+}
+
+struct bt_mesh_rpl *bt_mesh_rpl_alloc(u16_t src)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		if (!bt_mesh.rpl[i].src) {
+			bt_mesh.rpl[i].src = src;
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+			rpl_index_add(i);
+#endif
+			return &bt_mesh.rpl[i];
+		}
+	}
+
+	return NULL;
+}
+
+void bt_mesh_rpl_reindex(void)
+{
+#if defined(CONFIG_BT_MESH_CACHE_HASH)
+	int i;
+
+	(void)memset(rpl_index, 0xff, sizeof(rpl_index));
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		if (bt_mesh.rpl[i].src) {
+			rpl_index_add(i);
+		}
+	}
+#endif
+}
+
+static bool is_replay(struct bt_mesh_net_rx *rx)
+{
+	struct bt_mesh_rpl *rpl;
+
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
-
-		/* Empty slot */
-		if (!rpl->src) {
-			rpl->src = rx->ctx.addr;
-			rpl->seq = rx->seq;
-			rpl->old_iv = rx->old_iv;
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+	if (!rpl) {
+		rpl = bt_mesh_rpl_alloc(rx->ctx.addr);
+		if (!rpl) {
+			BT_ERR("RPL is full!");
+			return true;
+		}
 
-			if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-				bt_mesh_store_rpl(rpl);
-			}
+		rpl->seq = rx->seq;
+		rpl->old_iv = rx->old_iv;
 
-			return false;
+		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+			bt_mesh_store_rpl(rpl);
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return false;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				rpl->seq = rx->seq;
-				rpl->old_iv = rx->old_iv;
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
 
-				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
-					bt_mesh_store_rpl(rpl);
-				}
+	if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
+		rpl->seq = rx->seq;
+		rpl->old_iv = rx->old_iv;
 
-				return false;
-			} else {
-				return true;
-			}
+		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+			bt_mesh_store_rpl(rpl);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
@@ -1443,7 +1522,7 @@ void bt_mesh_rx_reset(void)
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_clear_rpl();
 	} else {
-		(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+		bt_mesh_rpl_clear();
 	}
 }
 
@@ -1478,4 +1557,5 @@ void bt_mesh_rpl_clear(void)
 {
 	BT_DBG("");
 	(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+	bt_mesh_rpl_reindex();
 }
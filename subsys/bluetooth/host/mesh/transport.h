@@ -94,3 +94,9 @@ int bt_mesh_trans_recv(struct net_buf_simple *buf, struct bt_mesh_net_rx *rx);
 void bt_mesh_trans_init(void);
 
 void bt_mesh_rpl_clear(void);
+
+struct bt_mesh_rpl *bt_mesh_rpl_find(u16_t src);
+
+struct bt_mesh_rpl *bt_mesh_rpl_alloc(u16_t src);
+
+void bt_mesh_rpl_reindex(void);
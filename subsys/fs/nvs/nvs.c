@@ -26,6 +26,30 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (fs->write_block_size - 1U)) & ~(fs->write_block_size - 1U);
 }
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* position of the bucket holding id in the lookup cache */
+static inline size_t nvs_lookup_cache_pos(u16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+#endif
+
+/* nvs_lookup_start returns the address from where to walk back to find the
+ * latest ate of id. With the lookup cache this is the latest ate of the
+ * bucket holding id, or NVS_LOOKUP_CACHE_NO_ADDR if no such ate exists.
+ * Without it (and for the close ate id, which is never cached) the whole
+ * allocation table is walked.
+ */
+static inline u32_t nvs_lookup_start(struct nvs_fs *fs, u16_t id)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (id != NVS_CLOSE_ATE_ID) {
+		return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+	}
+#endif
+	return fs->ate_wra;
+}
 /* end basic routines */
 
 /* flash routines */
@@ -103,6 +127,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (entry->id != NVS_CLOSE_ATE_ID) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -398,6 +427,57 @@ static void nvs_sector_advance(struct nvs_fs *fs, u32_t *addr)
 	}
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* lookup cache rebuild: walk through the allocation table from newest to
+ * oldest entries, the first valid ate found for a bucket is its latest.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	u32_t addr, ate_addr;
+	u32_t *cache_entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+
+	addr = fs->ate_wra;
+	while (1) {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+		if ((ate.id != NVS_CLOSE_ATE_ID) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    (!nvs_ate_crc8_check(&ate))) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* drop the cached addresses pointing to a sector that is being erased. The
+ * sector is the oldest one, so the buckets concerned have no older ate left.
+ */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, u32_t addr)
+{
+	addr &= ADDR_SECT_MASK;
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] & ADDR_SECT_MASK) == addr) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
+
 /* allocation entry close (this closes the current sector) by writing offset
  * of last ate to the sector end.
  */
@@ -409,7 +489,7 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	close_ate.id = 0xFFFF;
+	close_ate.id = NVS_CLOSE_ATE_ID;
 	close_ate.len = 0U;
 	close_ate.offset = (u16_t)((fs->ate_wra + ate_size) & ADDR_OFFS_MASK);
 
@@ -428,16 +508,16 @@ static int nvs_sector_close(struct nvs_fs *fs)
 }
 
 
-/* garbage collection: the address ate_wra has been updated to the new sector
- * that has just been started. The data to gc is in the sector after this new
- * sector.
+/* garbage collection start: the address ate_wra has been updated to the new
+ * sector that has just been started. The data to gc is in the sector after
+ * this new sector. If that sector is not closed it is only erased, otherwise
+ * gc is set up to walk through its ate's from newest to oldest.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, struct nvs_gc_state *gc)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	u32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, last_ate;
+	u32_t sec_addr, gc_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -455,6 +535,9 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, 0xff);
 	if (!rc) {
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+		nvs_lookup_cache_invalidate(fs, sec_addr);
+#endif
 		rc = nvs_flash_erase_sector(fs, sec_addr);
 		if (rc) {
 			return rc;
@@ -462,19 +545,60 @@ static int nvs_gc(struct nvs_fs *fs)
 		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
+	gc->stop_addr = gc_addr - ate_size;
+	gc->addr = sec_addr + close_ate.offset;
 
-	gc_addr &= ADDR_SECT_MASK;
-	gc_addr += close_ate.offset;
+	/* the space needed to copy the live entries is at most the space
+	 * used in the sector: its ate's and the data up to the end of the
+	 * data of the newest ate.
+	 */
+	rc = nvs_flash_ate_rd(fs, gc->addr, &last_ate);
+	if (rc) {
+		return rc;
+	}
 
-	while (1) {
-		gc_prev_addr = gc_addr;
+	gc->reserve = fs->sector_size - ate_size - close_ate.offset;
+	if (!nvs_ate_crc8_check(&last_ate)) {
+		gc->reserve += last_ate.offset + nvs_al_size(fs, last_ate.len);
+	} else {
+		gc->reserve += close_ate.offset;
+	}
+
+	gc->active = true;
+	return 0;
+}
+
+/* garbage collection step: go through at most max ate's of the sector being
+ * collected, copying the ones that are the latest of their id to the write
+ * sector. The sector is erased once its oldest ate has been handled. The gc
+ * position only advances past an ate once it is handled, so a step that
+ * failed can be retried.
+ */
+static int nvs_gc_step(struct nvs_fs *fs, struct nvs_gc_state *gc, u32_t max)
+{
+	int rc;
+	struct nvs_ate gc_ate, wlk_ate;
+	u32_t gc_addr, wlk_addr, wlk_prev_addr, data_addr;
+	size_t ate_size, entry_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	while (gc->active && max--) {
+		gc_addr = gc->addr;
 		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
 		if (rc) {
 			return rc;
 		}
-		wlk_addr = fs->ate_wra;
-		while (1) {
+		/* invalid and deleted items are never copied, only look for
+		 * the latest ate of the id of the others.
+		 */
+		wlk_prev_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+		if (gc_ate.len && !nvs_ate_crc8_check(&gc_ate)) {
+			wlk_addr = nvs_lookup_start(fs, gc_ate.id);
+		} else {
+			wlk_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+		while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_prev_addr = wlk_addr;
 			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 			if (rc) {
@@ -491,13 +615,13 @@ static int nvs_gc(struct nvs_fs *fs)
 			}
 		}
 		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
+		 * needed.
 		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if (wlk_prev_addr == gc->addr) {
 			/* copy needed */
 			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+			data_addr = (gc->addr & ADDR_SECT_MASK);
 			data_addr += gc_ate.offset;
 
 			gc_ate.offset = (u16_t)(fs->data_wra & ADDR_OFFS_MASK);
@@ -512,21 +636,101 @@ static int nvs_gc(struct nvs_fs *fs)
 			if (rc) {
 				return rc;
 			}
+			fs->gc_stats.moved++;
 		}
 
 		/* stop gc at end of the sector */
-		if (gc_prev_addr == stop_addr) {
-			break;
+		if (gc->addr == gc->stop_addr) {
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+			nvs_lookup_cache_invalidate(fs, gc->addr);
+#endif
+			rc = nvs_flash_erase_sector(fs, gc->addr);
+			if (rc) {
+				return rc;
+			}
+			gc->active = false;
+			gc->reserve = 0U;
+			fs->gc_stats.sectors++;
+			return 0;
+		}
+
+		entry_size = ate_size;
+		if (!nvs_ate_crc8_check(&gc_ate)) {
+			entry_size += nvs_al_size(fs, gc_ate.len);
 		}
+		gc->reserve -= MIN(gc->reserve, entry_size);
+		gc->addr = gc_addr;
 	}
 
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	return 0;
+}
+
+#ifndef CONFIG_NVS_INCREMENTAL_GC
+/* garbage collection of a whole sector at once, see nvs_gc_start() */
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_gc_state gc = { .active = false };
+
+	rc = nvs_gc_start(fs, &gc);
 	if (rc) {
 		return rc;
 	}
+
+	return nvs_gc_step(fs, &gc, UINT32_MAX);
+}
+#endif
+
+/* bytes to keep free in the write sector for gc to complete */
+static inline u32_t nvs_gc_reserve(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	return fs->gc_state.reserve;
+#else
 	return 0;
+#endif
 }
 
+/* account for a write waiting for gc since start */
+static void nvs_gc_stall(struct nvs_fs *fs, u32_t start)
+{
+	u32_t stall_us;
+
+	stall_us = (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+			   NSEC_PER_USEC);
+
+	fs->gc_stats.stalls++;
+	fs->gc_stats.stall_us += stall_us;
+	fs->gc_stats.max_stall_us = MAX(fs->gc_stats.max_stall_us, stall_us);
+}
+
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	bool active;
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	rc = nvs_gc_step(fs, &fs->gc_state, CONFIG_NVS_GC_STEP_ENTRIES);
+	active = fs->gc_state.active;
+
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (rc) {
+		/* a write running out of space will retry */
+		LOG_ERR("Garbage collection failed: %d", rc);
+		return;
+	}
+
+	if (active) {
+		/* give other work items a chance between steps */
+		k_work_submit(&fs->gc_work);
+	}
+}
+#endif
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -619,6 +823,21 @@ static int nvs_startup(struct nvs_fs *fs)
 	if (rc < 0) {
 		goto end;
 	}
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	/* with incremental gc the write sector also holds entries written
+	 * while gc was in progress, so it is kept and gc resumes from the
+	 * start of the sector. Entries already copied are no longer the
+	 * latest of their id in that sector and are not copied again.
+	 */
+	fs->gc_state.active = false;
+	fs->gc_state.reserve = 0U;
+	if (rc) {
+		rc = nvs_gc_start(fs, &fs->gc_state);
+		if (rc) {
+			goto end;
+		}
+	}
+#else
 	if (rc) {
 		/* the sector after fs->ate_wrt is not empty */
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
@@ -628,11 +847,26 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+		/* gc looks entries up through the cache */
+		rc = nvs_lookup_cache_rebuild(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
 		rc = nvs_gc(fs);
 		if (rc) {
 			goto end;
 		}
 	}
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	rc = nvs_lookup_cache_rebuild(fs);
+	if (rc) {
+		goto end;
+	}
+#endif
 
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -656,6 +890,13 @@ int nvs_clear(struct nvs_fs *fs)
 			return rc;
 		}
 	}
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	fs->gc_state.active = false;
+	fs->gc_state.reserve = 0U;
+#endif
 	return 0;
 }
 
@@ -666,6 +907,10 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 
 	k_mutex_init(&fs->nvs_lock);
+	(void)memset(&fs->gc_stats, 0, sizeof(fs->gc_stats));
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
 
 	fs->flash_device = device_get_binding(dev_name);
 	if (!fs->flash_device) {
@@ -706,6 +951,12 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	if (fs->gc_state.active) {
+		k_work_submit(&fs->gc_work);
+	}
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -722,8 +973,9 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	int rc, gc_count;
 	size_t ate_size, data_size;
 	struct nvs_ate wlk_ate;
-	u32_t wlk_addr, rd_addr;
+	u32_t wlk_addr, rd_addr, stall_start;
 	u16_t sector_freespace;
+	bool prev_found = false;
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -742,17 +994,21 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		return -EINVAL;
 	}
 
+	/* lock before looking up, gc might be moving entries around */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
-			return rc;
+			goto end;
 		}
 		if ((wlk_ate.id == id) && (!nvs_ate_crc8_check(&wlk_ate))) {
+			prev_found = true;
 			break;
 		}
 		if (wlk_addr == fs->ate_wra) {
@@ -760,7 +1016,7 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		}
 	}
 
-	if (wlk_addr != fs->ate_wra) {
+	if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
 		rd_addr += wlk_ate.offset;
@@ -768,19 +1024,18 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 		if (len == 0) {
 			/* do not try to compare with empty data */
 			if (wlk_ate.len == 0U) {
-				return 0;
+				rc = 0;
+				goto end;
 			}
 		} else {
 			/* compare the data and if equal return 0 */
 			rc = nvs_flash_block_cmp(fs, rd_addr, data, len);
 			if (rc <= 0) {
-				return rc;
+				goto end;
 			}
 		}
 	}
 
-	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
-
 	gc_count = 0;
 	while (1) {
 		if (gc_count == fs->sector_count) {
@@ -793,8 +1048,11 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 
 		sector_freespace = fs->ate_wra - fs->data_wra;
 
-		/* Leave space for delete ate */
-		if (sector_freespace >= data_size + ate_size) {
+		/* Leave space for delete ate, and for gc to copy what is left
+		 * in the sector being collected
+		 */
+		if (sector_freespace >= data_size + ate_size +
+					nvs_gc_reserve(fs)) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
 			if (rc) {
@@ -803,12 +1061,31 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 			break;
 		}
 
+		stall_start = k_cycle_get_32();
+
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+		if (fs->gc_state.active) {
+			/* out of space: complete the gc in progress */
+			rc = nvs_gc_step(fs, &fs->gc_state, UINT32_MAX);
+			nvs_gc_stall(fs, stall_start);
+			if (rc) {
+				goto end;
+			}
+			continue;
+		}
+#endif
+
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
 		}
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+		rc = nvs_gc_start(fs, &fs->gc_state);
+#else
 		rc = nvs_gc(fs);
+#endif
+		nvs_gc_stall(fs, stall_start);
 		if (rc) {
 			goto end;
 		}
@@ -816,6 +1093,11 @@ ssize_t nvs_write(struct nvs_fs *fs, u16_t id, const void *data, size_t len)
 	}
 	rc = len;
 end:
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	if (fs->gc_state.active) {
+		k_work_submit(&fs->gc_work);
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -847,7 +1129,13 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-	wlk_addr = fs->ate_wra;
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	wlk_addr = nvs_lookup_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -866,7 +1154,8 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 
 	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
 	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
-		return -ENOENT;
+		rc = -ENOENT;
+		goto err;
 	}
 
 	rd_addr &= ADDR_SECT_MASK;
@@ -876,9 +1165,10 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, u16_t id, void *data, size_t len,
 		goto err;
 	}
 
-	return wlk_ate.len;
+	rc = wlk_ate.len;
 
 err:
+	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
 
@@ -910,12 +1200,14 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 		free_space += (fs->sector_size - ate_size);
 	}
 
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
 	step_addr = fs->ate_wra;
 
 	while (1) {
 		rc = nvs_prev_ate(fs, &step_addr, &step_ate);
 		if (rc) {
-			return rc;
+			goto end;
 		}
 
 		wlk_addr = fs->ate_wra;
@@ -923,7 +1215,7 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 		while (1) {
 			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 			if (rc) {
-				return rc;
+				goto end;
 			}
 			if ((wlk_ate.id == step_ate.id) ||
 			    (wlk_addr == fs->ate_wra)) {
@@ -943,5 +1235,30 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 		}
 
 	}
-	return free_space;
+	rc = free_space;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats)
+{
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	*stats = fs->gc_stats;
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	stats->active = fs->gc_state.active;
+	stats->remaining = fs->gc_state.reserve;
+#else
+	stats->active = false;
+	stats->remaining = 0U;
+#endif
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return 0;
 }
@@ -47,6 +47,109 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
+/* Connection lookup table.
+ *
+ * Handlers with a local port are put in a hash table bucket selected by
+ * their lookup tier, protocol, ports and, for the most specific tier,
+ * remote address. A received packet then only needs to be compared with
+ * the handlers of one bucket per tier, plus the handlers without a local
+ * port which are all kept in a separate list. The buckets are shared by
+ * all tiers, so the tier of each handler is checked when walking them.
+ * The lists are only modified or walked with conn_lock held.
+ */
+enum conn_tier {
+	/* Remote address, remote port and local port set */
+	CONN_TIER_FULL,
+	/* Remote and local port set */
+	CONN_TIER_PORTS,
+	/* Local port set */
+	CONN_TIER_LOCAL,
+	/* No local port, not in the hash table */
+	CONN_TIER_WILD,
+};
+
+static sys_slist_t conn_table[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wild;
+static struct k_spinlock conn_lock;
+
+static inline enum conn_tier conn_tier(struct net_conn *conn)
+{
+	if (!(conn->rank & NET_RANK_LOCAL_PORT)) {
+		return CONN_TIER_WILD;
+	}
+
+	if (!(conn->rank & NET_RANK_REMOTE_PORT)) {
+		return CONN_TIER_LOCAL;
+	}
+
+	if (conn->rank & NET_RANK_REMOTE_SPEC_ADDR) {
+		return CONN_TIER_FULL;
+	}
+
+	return CONN_TIER_PORTS;
+}
+
+static inline u32_t conn_hash_mix(u32_t hash, u32_t value)
+{
+	/* Multiplicative hashing, the upper bits are the best mixed */
+	return (hash ^ value) * 0x9e3779b1U;
+}
+
+/* Ports are in network byte order, as in the packet headers */
+static sys_slist_t *conn_bucket(enum conn_tier tier, u16_t proto,
+				sa_family_t family, const void *remote_addr,
+				u16_t remote_port, u16_t local_port)
+{
+	u32_t hash;
+
+	hash = conn_hash_mix(tier, proto);
+	hash = conn_hash_mix(hash, local_port);
+
+	if (tier != CONN_TIER_LOCAL) {
+		hash = conn_hash_mix(hash, remote_port);
+	}
+
+	if (tier == CONN_TIER_FULL) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+			const struct in6_addr *addr6 = remote_addr;
+			int i;
+
+			for (i = 0; i < 4; i++) {
+				hash = conn_hash_mix(hash, UNALIGNED_GET(
+						&addr6->s6_addr32[i]));
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+			const struct in_addr *addr4 = remote_addr;
+
+			hash = conn_hash_mix(hash,
+					     UNALIGNED_GET(&addr4->s_addr));
+		}
+	}
+
+	return &conn_table[(hash >> 16) % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+static sys_slist_t *conn_list(struct net_conn *conn)
+{
+	enum conn_tier tier = conn_tier(conn);
+	const void *remote_addr;
+
+	if (tier == CONN_TIER_WILD) {
+		return &conn_wild;
+	}
+
+	if (conn->remote_addr.sa_family == AF_INET6) {
+		remote_addr = &net_sin6(&conn->remote_addr)->sin6_addr;
+	} else {
+		remote_addr = &net_sin(&conn->remote_addr)->sin_addr;
+	}
+
+	return conn_bucket(tier, conn->proto, conn->remote_addr.sa_family,
+			   remote_addr,
+			   net_sin(&conn->remote_addr)->sin_port,
+			   net_sin(&conn->local_addr)->sin_port);
+}
+
 #if defined(CONFIG_NET_CONN_CACHE)
 
 /* Cache the connection so that we do not have to go
@@ -329,6 +432,7 @@ static inline void cache_remove(struct net_conn *conn)
 int net_conn_unregister(struct net_conn_handle *handle)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
+	k_spinlock_key_t key;
 
 	if (conn < &conns[0] || conn > &conns[CONFIG_NET_MAX_CONN]) {
 		return -EINVAL;
@@ -340,11 +444,14 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	cache_remove(conn);
 
+	key = k_spin_lock(&conn_lock);
+	sys_slist_find_and_remove(conn_list(conn), &conn->node);
+	(void)memset(conn, 0, sizeof(*conn));
+	k_spin_unlock(&conn_lock, key);
+
 	NET_DBG("[%zu] connection handler %p removed",
 		conn - conns, conn);
 
-	(void)memset(conn, 0, sizeof(*conn));
-
 	return 0;
 }
 
@@ -544,6 +651,7 @@ int net_conn_register(u16_t proto, u8_t family,
 		      void *user_data,
 		      struct net_conn_handle **handle)
 {
+	k_spinlock_key_t key;
 	int i;
 	u8_t rank = 0U;
 
@@ -659,6 +767,10 @@ int net_conn_register(u16_t proto, u8_t family,
 		conns[i].proto = proto;
 		conns[i].family = family;
 
+		key = k_spin_lock(&conn_lock);
+		sys_slist_prepend(conn_list(&conns[i]), &conns[i].node);
+		k_spin_unlock(&conn_lock, key);
+
 		/* Cache needs to be cleared if new entries are added. */
 		cache_clear();
 
@@ -796,14 +908,125 @@ static bool is_valid_packet(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+static bool conn_matches(struct net_conn *conn,
+			 struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 u8_t proto,
+			 u16_t src_port,
+			 u16_t dst_port)
+{
+	if (!(conn->flags & NET_CONN_IN_USE)) {
+		return false;
+	}
+
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != AF_UNSPEC &&
+	    conn->family != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) {
+		if (net_sin(&conn->remote_addr)->sin_port) {
+			if (net_sin(&conn->remote_addr)->sin_port !=
+			    src_port) {
+				return false;
+			}
+		}
+
+		if (net_sin(&conn->local_addr)->sin_port) {
+			if (net_sin(&conn->local_addr)->sin_port !=
+			    dst_port) {
+				return false;
+			}
+		}
+
+		if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+			if (!check_addr(pkt, ip_hdr, &conn->remote_addr,
+					true)) {
+				return false;
+			}
+		}
+
+		if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+			if (!check_addr(pkt, ip_hdr, &conn->local_addr,
+					false)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/* Mark the handlers of the given tier in list that match the packet */
+static void conn_collect(sys_slist_t *list, enum conn_tier tier,
+			 struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 u8_t proto,
+			 u16_t src_port,
+			 u16_t dst_port,
+			 u32_t *matches)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, node) {
+		int idx = conn - conns;
+
+		if (conn_tier(conn) != tier) {
+			continue;
+		}
+
+		if (conn_matches(conn, pkt, ip_hdr, proto, src_port,
+				 dst_port)) {
+			matches[idx / 32] |= BIT(idx % 32);
+		}
+	}
+}
+
+/* Look the packet up in the hash table, one bucket per tier */
+static void conn_lookup(struct net_pkt *pkt,
+			union net_ip_header *ip_hdr,
+			u8_t proto,
+			u16_t src_port,
+			u16_t dst_port,
+			u32_t *matches)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	const void *src = NULL;
+	int tier;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		src = &ip_hdr->ipv4->src;
+	}
+
+	for (tier = CONN_TIER_FULL; tier < CONN_TIER_WILD; tier++) {
+		/* Remote addresses are only hashed for IP packets */
+		if (tier == CONN_TIER_FULL && !src) {
+			continue;
+		}
+
+		conn_collect(conn_bucket(tier, proto, family, src,
+					 src_port, dst_port),
+			     tier, pkt, ip_hdr, proto, src_port, dst_port,
+			     matches);
+	}
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				u8_t proto,
 				union net_proto_header *proto_hdr)
 {
 	struct net_if *pkt_iface = net_pkt_iface(pkt);
+	u32_t matches[DIV_ROUND_UP(CONFIG_NET_MAX_CONN, 32)] = { 0 };
 	int i, best_match = -1;
 	s16_t best_rank = -1;
+	k_spinlock_key_t key;
 	u16_t src_port;
 	u16_t dst_port;
 #if defined(CONFIG_NET_CONN_CACHE)
@@ -858,71 +1081,46 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
-	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-		if (!(conns[i].flags & NET_CONN_IN_USE)) {
-			continue;
-		}
-
-		if (conns[i].proto != proto) {
-			continue;
-		}
-
-		if (conns[i].family != AF_UNSPEC &&
-		    conns[i].family != net_pkt_family(pkt)) {
-			continue;
-		}
-
-		if (IS_ENABLED(CONFIG_NET_UDP) ||
-		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conns[i].remote_addr)->sin_port) {
-				if (net_sin(&conns[i].remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
+	key = k_spin_lock(&conn_lock);
 
-			if (net_sin(&conns[i].local_addr)->sin_port) {
-				if (net_sin(&conns[i].local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
+	if (dst_port) {
+		conn_lookup(pkt, ip_hdr, proto, src_port, dst_port, matches);
+	}
 
-			if (conns[i].flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!check_addr(pkt, ip_hdr,
-						&conns[i].remote_addr,
-						true)) {
+	conn_collect(&conn_wild, CONN_TIER_WILD, pkt, ip_hdr, proto,
+		     src_port, dst_port, matches);
+
+	k_spin_unlock(&conn_lock, key);
+
+	/* Rank the matching handlers in registration slot order */
+	for (i = 0; i < ARRAY_SIZE(matches); i++) {
+		while (matches[i]) {
+			int j = find_lsb_set(matches[i]) - 1;
+			int idx = i * 32 + j;
+
+			matches[i] &= ~BIT(j);
+
+			if (IS_ENABLED(CONFIG_NET_UDP) ||
+			    IS_ENABLED(CONFIG_NET_TCP)) {
+				/* If we have an existing best_match, and that
+				 * one specifies a remote port, then we've
+				 * matched to a LISTENING connection that
+				 * should not override.
+				 */
+				if (best_match >= 0 &&
+				    net_sin(&conns[best_match].remote_addr)->
+								sin_port) {
 					continue;
 				}
-			}
 
-			if (conns[i].flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!check_addr(pkt, ip_hdr,
-						&conns[i].local_addr,
-						false)) {
-					continue;
+				if (best_rank < conns[idx].rank) {
+					best_rank = conns[idx].rank;
+					best_match = idx;
 				}
+			} else {
+				best_rank = 0;
+				best_match = idx;
 			}
-
-			/* If we have an existing best_match, and that one
-			 * specifies a remote port, then we've matched to a
-			 * LISTENING connection that should not override.
-			 */
-			if (best_match >= 0 &&
-			    net_sin(&conns[best_match].remote_addr)->sin_port) {
-				continue;
-			}
-
-			if (best_rank < conns[i].rank) {
-				best_rank = conns[i].rank;
-				best_match = i;
-			}
-		} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
-			best_rank = 0;
-			best_match = i;
-		} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN)) {
-			best_rank = 0;
-			best_match = i;
 		}
 	}
 
@@ -1003,13 +1201,17 @@ void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 
 void net_conn_init(void)
 {
-#if defined(CONFIG_NET_CONN_CACHE)
-	do {
-		int i;
+	int i;
 
-		for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
-			conn_cache[i].idx = -1;
-		}
-	} while (0);
+	for (i = 0; i < ARRAY_SIZE(conn_table); i++) {
+		sys_slist_init(&conn_table[i]);
+	}
+
+	sys_slist_init(&conn_wild);
+
+#if defined(CONFIG_NET_CONN_CACHE)
+	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
+		conn_cache[i].idx = -1;
+	}
 #endif /* CONFIG_NET_CONN_CACHE */
 }
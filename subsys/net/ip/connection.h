@@ -16,6 +16,7 @@
 #include <zephyr/types.h>
 
 #include <misc/util.h>
+#include <misc/slist.h>
 
 #include <net/net_core.h>
 #include <net/net_ip.h>
@@ -47,6 +48,9 @@ typedef enum net_verdict (*net_conn_cb_t)(struct net_conn *conn,
  *
  */
 struct net_conn {
+	/** Internal slist node, for the connection lookup table */
+	sys_snode_t node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -77,6 +77,8 @@ int net_ipv4_finalize(struct net_pkt *pkt, u8_t next_header_proto)
 
 	ipv4_hdr->len   = htons(net_pkt_get_len(pkt));
 	ipv4_hdr->proto = next_header_proto;
+	/* Coalesced TCP segments are finalized again */
+	ipv4_hdr->chksum = 0U;
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
@@ -159,7 +161,7 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		goto drop;
 	}
 
-	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+	if (net_pkt_need_calc_rx_checksum(pkt) &&
 	    net_calc_chksum_ipv4(pkt) != 0U) {
 		NET_DBG("DROP: invalid chksum");
 		goto drop;
@@ -1250,6 +1250,36 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 
 		return pkt;
 	}
+#endif
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_context_get_ip_proto(context) == IPPROTO_TCP &&
+	    context->tcp) {
+		u16_t gso_size;
+
+		gso_size = net_tcp_gso_size(context->tcp,
+					    net_context_get_iface(context),
+					    len);
+		if (gso_size) {
+			pkt = net_pkt_alloc_on_iface(
+				net_context_get_iface(context), timeout);
+			if (!pkt) {
+				return NULL;
+			}
+
+			net_pkt_set_family(pkt,
+					   net_context_get_family(context));
+			net_pkt_set_context(pkt, context);
+			net_pkt_set_gso_size(pkt, gso_size);
+
+			if (net_pkt_alloc_buffer(pkt, len, IPPROTO_TCP,
+						 timeout)) {
+				net_pkt_unref(pkt);
+				return NULL;
+			}
+
+			return pkt;
+		}
+	}
 #endif
 	pkt = net_pkt_alloc_with_buffer(net_context_get_iface(context), len,
 					net_context_get_family(context),
@@ -1846,6 +1876,16 @@ static int set_context_timestamp(struct net_context *context,
 #endif
 }
 
+static int set_context_tcp_nodelay(struct net_context *context,
+				   const void *value, size_t len)
+{
+	if (len > sizeof(bool)) {
+		return -EINVAL;
+	}
+
+	return net_tcp_set_nodelay(context, *((bool *)value));
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -1867,6 +1907,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_TIMESTAMP:
 		ret = set_context_timestamp(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = set_context_tcp_nodelay(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -1895,6 +1938,12 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_TIMESTAMP:
 		ret = get_context_timepstamp(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = net_tcp_get_nodelay(context, value);
+		if (!ret && len) {
+			*len = sizeof(bool);
+		}
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
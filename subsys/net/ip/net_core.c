@@ -321,6 +321,9 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* Nothing could corrupt it since it was built */
+		net_pkt_set_chksum_verified(pkt, true);
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -357,7 +360,8 @@ static void process_rx_packet(struct k_work *work)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+/* Sets the packet up for processing, returning its traffic class */
+static u8_t net_queue_rx_setup(struct net_if *iface, struct net_pkt *pkt)
 {
 	u8_t prio = net_pkt_priority(pkt);
 	u8_t tc = net_rx_priority2tc(prio);
@@ -374,7 +378,35 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	u8_t tc = net_queue_rx_setup(iface, pkt);
+
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+	ARG_UNUSED(tc);
+
+	net_tc_submit_to_rx_flow_queue(pkt);
+#else
 	net_tc_submit_to_rx_queue(tc, pkt);
+#endif
+}
+
+static void net_prepare_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
+		iface, pkt, net_pkt_get_len(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+		net_pkt_set_orig_iface(pkt, iface);
+	}
+
+	net_pkt_set_iface(pkt, iface);
 }
 
 /* Called by driver when an IP packet has been received */
@@ -392,21 +424,52 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		return -ENETDOWN;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
+	net_prepare_rx(iface, pkt);
 
-	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
-		iface, pkt, net_pkt_get_len(pkt));
+	net_queue_rx(iface, pkt);
 
-	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
-		net_pkt_set_orig_iface(pkt, iface);
+	return 0;
+}
+
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			int count)
+{
+	int i;
+
+	if (!iface || !pkts || count < 0) {
+		return -EINVAL;
 	}
 
-	net_pkt_set_iface(pkt, iface);
+	if (!atomic_test_bit(iface->if_dev->flags, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
 
-	net_queue_rx(iface, pkt);
+	/* Stop at the first packet that cannot be taken, the caller
+	 * keeps it and the ones after it.
+	 */
+	for (i = 0; i < count; i++) {
+		if (!pkts[i] || !pkts[i]->frags) {
+			break;
+		}
 
-	return 0;
+		net_prepare_rx(iface, pkts[i]);
+	}
+
+	count = i;
+
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+	for (i = 0; i < count; i++) {
+		net_queue_rx_setup(iface, pkts[i]);
+	}
+
+	net_tc_submit_batch_to_rx_flow_queue(pkts, count);
+#else
+	for (i = 0; i < count; i++) {
+		net_queue_rx(iface, pkts[i]);
+	}
+#endif
+
+	return count;
 }
 
 static inline void l3_init(void)
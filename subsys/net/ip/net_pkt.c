@@ -121,10 +121,25 @@ NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
 
 #else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
-NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
-			CONFIG_NET_BUF_DATA_POOL_SIZE, NULL);
-NET_BUF_POOL_VAR_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
-			CONFIG_NET_BUF_DATA_POOL_SIZE, NULL);
+#if CONFIG_NET_BUF_DATA_BLOCK_SIZE > CONFIG_NET_BUF_DATA_POOL_SIZE
+#error "CONFIG_NET_BUF_DATA_BLOCK_SIZE cannot exceed the data pool size"
+#endif
+
+#define NET_BUF_DATA_BLOCK_COUNT (CONFIG_NET_BUF_DATA_POOL_SIZE / \
+				  CONFIG_NET_BUF_DATA_BLOCK_SIZE)
+
+/* Largest data buffer that fits in a block, minus the block id and the
+ * reference count which the memory pool allocator stores in front of it.
+ */
+#define NET_BUF_DATA_MAX_LEN (CONFIG_NET_BUF_DATA_BLOCK_SIZE - \
+			      sizeof(struct k_mem_block_id) - 1)
+
+NET_BUF_POOL_VAR_BLOCK_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
+			      CONFIG_NET_BUF_DATA_BLOCK_SIZE,
+			      NET_BUF_DATA_BLOCK_COUNT, NULL);
+NET_BUF_POOL_VAR_BLOCK_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
+			      CONFIG_NET_BUF_DATA_BLOCK_SIZE,
+			      NET_BUF_DATA_BLOCK_COUNT, NULL);
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
@@ -919,21 +934,59 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 					size_t size, s32_t timeout)
 #endif
 {
-	struct net_buf *buf;
+	u32_t alloc_start = k_uptime_get_32();
+	struct net_buf *first = NULL;
+	struct net_buf *current = NULL;
+	size_t max_len = size;
 
-	buf = net_buf_alloc_len(pool, size, timeout);
+	/* Packets that do not fit in a block of the stack pools get a chain
+	 * of buffers. Custom context pools are left to their own sizing.
+	 */
+	if (pool == &rx_bufs || pool == &tx_bufs) {
+		max_len = NET_BUF_DATA_MAX_LEN;
+	}
+
+	while (size) {
+		struct net_buf *new;
+
+		new = net_buf_alloc_len(pool, MIN(size, max_len), timeout);
+		if (!new) {
+			goto error;
+		}
+
+		if (!first && !current) {
+			first = new;
+		} else {
+			current->frags = new;
+		}
+
+		current = new;
+		size -= MIN(size, current->size);
+
+		if (timeout != K_NO_WAIT && timeout != K_FOREVER) {
+			u32_t diff = k_uptime_get_32() - alloc_start;
+
+			timeout -= MIN(timeout, diff);
+		}
 
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
-	NET_FRAG_CHECK_IF_NOT_IN_USE(buf, buf->ref + 1);
+		NET_FRAG_CHECK_IF_NOT_IN_USE(new, new->ref + 1);
 
-	net_pkt_alloc_add(buf, false, caller, line);
+		net_pkt_alloc_add(new, false, caller, line);
 
-	NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
-		pool2str(pool), get_name(pool), get_frees(pool),
-		buf, buf->ref, caller, line);
+		NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
+			pool2str(pool), get_name(pool), get_frees(pool),
+			new, new->ref, caller, line);
 #endif
+	}
 
-	return buf;
+	return first;
+error:
+	if (first) {
+		net_buf_unref(first);
+	}
+
+	return NULL;
 }
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
@@ -972,6 +1025,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* L2 cuts such packets in segments fitting the MTU */
+	if (net_pkt_gso_size(pkt)) {
+		max_len = MAX(max_len, CONFIG_NET_TCP_GSO_MAX_SIZE);
+	}
+#endif
+
 	max_len -= existing;
 
 	return MIN(size, max_len);
@@ -1008,13 +1068,39 @@ static size_t pkt_estimate_headers_length(struct net_pkt *pkt,
 	return hdr_len;
 }
 
+/* Room for data in buf, counted from its data pointer: the headroom
+ * left in front of it is not part of it.
+ */
+static inline size_t pkt_buf_capacity(struct net_buf *buf)
+{
+	return buf->size - net_buf_headroom(buf);
+}
+
+/* Headroom reserved in front of the data of new TX packets, so that L2
+ * can put its header there instead of in a buffer of its own.
+ */
+static size_t pkt_tx_headroom(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_BUF_VARIABLE_DATA_SIZE) && \
+	defined(CONFIG_NET_L2_ETHERNET)
+	if (pkt->slab == &tx_pkts && net_pkt_iface(pkt) &&
+	    net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		return IS_ENABLED(CONFIG_NET_VLAN) ?
+			sizeof(struct net_eth_vlan_hdr) :
+			sizeof(struct net_eth_hdr);
+	}
+#endif
+
+	return 0;
+}
+
 static size_t pkt_get_size(struct net_pkt *pkt)
 {
 	struct net_buf *buf = pkt->buffer;
 	size_t size = 0;
 
 	while (buf) {
-		size += buf->size;
+		size += pkt_buf_capacity(buf);
 		buf = buf->frags;
 	}
 
@@ -1094,6 +1180,7 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	u32_t alloc_start = k_uptime_get_32();
 	struct net_buf_pool *pool = NULL;
 	size_t alloc_len = 0;
+	size_t headroom = 0;
 	size_t hdr_len = 0;
 	struct net_buf *buf;
 
@@ -1122,6 +1209,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	NET_DBG("Data allocation maximum size %zu (requested %zu)",
 		alloc_len, size);
 
+	if (!pkt->buffer && alloc_len) {
+		headroom = pkt_tx_headroom(pkt);
+	}
+
 	if (pkt->context) {
 		pool = get_data_pool(pkt->context);
 	}
@@ -1137,9 +1228,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	}
 
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout, caller, line);
+	buf = pkt_alloc_buffer(pool, alloc_len + headroom, timeout,
+			       caller, line);
 #else
-	buf = pkt_alloc_buffer(pool, alloc_len, timeout);
+	buf = pkt_alloc_buffer(pool, alloc_len + headroom, timeout);
 #endif
 
 	if (!buf) {
@@ -1147,6 +1239,10 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 		return -ENOMEM;
 	}
 
+	if (headroom && buf->size > headroom) {
+		net_buf_reserve(buf, headroom);
+	}
+
 	net_pkt_append_buffer(pkt, buf);
 
 	return 0;
@@ -1432,7 +1528,8 @@ static void pkt_cursor_jump(struct net_pkt *pkt, bool write)
 
 	cursor->buf = cursor->buf->frags;
 	while (cursor->buf) {
-		size_t len = write ? cursor->buf->size : cursor->buf->len;
+		size_t len = write ? pkt_buf_capacity(cursor->buf) :
+				     cursor->buf->len;
 
 		if (!len) {
 			cursor->buf = cursor->buf->frags;
@@ -1457,7 +1554,7 @@ static void pkt_cursor_advance(struct net_pkt *pkt, bool write)
 		return;
 	}
 
-	len = write ? cursor->buf->size : cursor->buf->len;
+	len = write ? pkt_buf_capacity(cursor->buf) : cursor->buf->len;
 	if ((cursor->pos - cursor->buf->data) == len) {
 		pkt_cursor_jump(pkt, write);
 	}
@@ -1473,9 +1570,10 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 		write = false;
 	}
 
-	len = write ? cursor->buf->size : cursor->buf->len;
+	len = write ? pkt_buf_capacity(cursor->buf) : cursor->buf->len;
 	if (length + (cursor->pos - cursor->buf->data) == len &&
-	    !(net_pkt_is_being_overwritten(pkt) && len < cursor->buf->size)) {
+	    !(net_pkt_is_being_overwritten(pkt) &&
+	      len < pkt_buf_capacity(cursor->buf))) {
 		pkt_cursor_jump(pkt, write);
 	} else {
 		cursor->pos += length;
@@ -1500,7 +1598,8 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		if (write && !net_pkt_is_being_overwritten(pkt)) {
-			d_len = c_op->buf->size - (c_op->pos - c_op->buf->data);
+			d_len = pkt_buf_capacity(c_op->buf) -
+				(c_op->pos - c_op->buf->data);
 		} else {
 			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
 		}
@@ -1618,7 +1717,8 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		}
 
 		s_len = c_src->buf->len - (c_src->pos - c_src->buf->data);
-		d_len = c_dst->buf->size - (c_dst->pos - c_dst->buf->data);
+		d_len = pkt_buf_capacity(c_dst->buf) -
+			(c_dst->pos - c_dst->buf->data);
 		if (length < s_len && length < d_len) {
 			len = length;
 		} else {
@@ -1824,7 +1924,8 @@ bool net_pkt_is_contiguous(struct net_pkt *pkt, size_t size)
 		size_t len;
 
 		len = net_pkt_is_being_overwritten(pkt) ?
-			pkt->cursor.buf->len : pkt->cursor.buf->size;
+			pkt->cursor.buf->len :
+			pkt_buf_capacity(pkt->cursor.buf);
 		len -= pkt->cursor.pos - pkt->cursor.buf->data;
 		if (len >= size) {
 			return true;
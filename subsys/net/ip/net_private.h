@@ -49,6 +49,10 @@ extern void net_tc_tx_init(void);
 extern void net_tc_rx_init(void);
 extern void net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_to_rx_flow_queue(struct net_pkt *pkt);
+extern void net_tc_submit_batch_to_rx_flow_queue(struct net_pkt **pkts,
+						 int count);
+extern void net_tc_submit_work_to_tx_queue(u8_t tc, struct k_work *work);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -97,6 +101,50 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 extern u16_t net_calc_chksum_ipv4(struct net_pkt *pkt);
 #endif /* CONFIG_NET_IPV4 */
 
+/**
+ * @brief Update a checksum after a 16-bit field it covers was changed
+ *
+ * This avoids summing the whole packet again when only a header field
+ * is rewritten, see RFC 1624.
+ *
+ * @param chksum Checksum as stored in the header
+ * @param old_val Previous value of the field, in host byte order
+ * @param new_val New value of the field, in host byte order
+ *
+ * @return Updated checksum, to store in the header
+ */
+static inline u16_t net_chksum_update_u16(u16_t chksum, u16_t old_val,
+					  u16_t new_val)
+{
+	u32_t sum;
+
+	sum = (u16_t)~chksum + (u16_t)~htons(old_val) + htons(new_val);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+/**
+ * @brief Update a checksum after a 32-bit field it covers was changed
+ *
+ * The field must start at an even offset of the checksummed data.
+ *
+ * @param chksum Checksum as stored in the header
+ * @param old_val Previous value of the field, in host byte order
+ * @param new_val New value of the field, in host byte order
+ *
+ * @return Updated checksum, to store in the header
+ */
+static inline u16_t net_chksum_update_u32(u16_t chksum, u32_t old_val,
+					  u32_t new_val)
+{
+	chksum = net_chksum_update_u16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update_u16(chksum, old_val & 0xffff,
+				     new_val & 0xffff);
+}
+
 static inline u16_t net_calc_chksum_icmpv6(struct net_pkt *pkt)
 {
 	return net_calc_chksum(pkt, IPPROTO_ICMPV6);
@@ -117,6 +165,15 @@ static inline u16_t net_calc_chksum_tcp(struct net_pkt *pkt)
 	return net_calc_chksum(pkt, IPPROTO_TCP);
 }
 
+/* Received packets are checked unless the driver already did it, for
+ * this packet or for all packets of its interface.
+ */
+static inline bool net_pkt_need_calc_rx_checksum(struct net_pkt *pkt)
+{
+	return !net_pkt_is_chksum_verified(pkt) &&
+		net_if_need_calc_rx_checksum(net_pkt_iface(pkt));
+}
+
 static inline char *net_sprint_ll_addr(const u8_t *ll, u8_t ll_len)
 {
 	static char buf[sizeof("xx:xx:xx:xx:xx:xx:xx:xx")];
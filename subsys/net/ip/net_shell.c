@@ -219,6 +219,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
 };
 
 static void print_supported_ethernet_capabilities(
@@ -766,6 +767,10 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("TCP conn drop  %d\tconnrst\t%d\n",
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
+	PR("TCP coalesced  %d\tdelayed ack\t%d\tooo\t%d\n",
+	   GET_STAT(iface, tcp.coalesced),
+	   GET_STAT(iface, tcp.delayed_ack),
+	   GET_STAT(iface, tcp.ooo_queued));
 #endif
 
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
@@ -804,6 +809,22 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 #endif
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+	{
+		int i;
+
+		PR("RX queue statistics:\n");
+		PR("Q   Recv pkts\tbytes\t\tbatches\n");
+
+		for (i = 0; i < CONFIG_NET_RX_QUEUE_COUNT; i++) {
+			PR("[%d] %d\t\t%d\t\t%d\n", i,
+			   GET_STAT(iface, rxq.queue[i].pkts),
+			   GET_STAT(iface, rxq.queue[i].bytes),
+			   GET_STAT(iface, rxq.queue[i].batches));
+		}
+	}
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
 	if (iface && net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
@@ -151,6 +151,10 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+		NET_INFO("TCP coalesced  %d\tdelayed ack\t%d\tooo\t%d",
+			 GET_STAT(iface, tcp.coalesced),
+			 GET_STAT(iface, tcp.delayed_ack),
+			 GET_STAT(iface, tcp.ooo_queued));
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
@@ -190,6 +194,18 @@ static inline void stats(struct net_if *iface)
 		ARG_UNUSED(i);
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+		NET_INFO("RX queue statistics:");
+		NET_INFO("Q   Recv pkts\tbytes\t\tbatches");
+
+		for (i = 0; i < CONFIG_NET_RX_QUEUE_COUNT; i++) {
+			NET_INFO("[%d] %d\t\t%d\t\t%d", i,
+				 GET_STAT(iface, rxq.queue[i].pkts),
+				 GET_STAT(iface, rxq.queue[i].bytes),
+				 GET_STAT(iface, rxq.queue[i].batches));
+		}
+#endif
+
 		next_print = curr + PRINT_STATISTICS_INTERVAL;
 	}
 }
@@ -251,6 +251,21 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_coalesced(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.coalesced++);
+}
+
+static inline void net_stats_update_tcp_delayed_ack(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.delayed_ack++);
+}
+
+static inline void net_stats_update_tcp_ooo_queued(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.ooo_queued++);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -265,6 +280,9 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_coalesced(iface)
+#define net_stats_update_tcp_delayed_ack(iface)
+#define net_stats_update_tcp_ooo_queued(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
@@ -351,6 +369,23 @@ static inline void net_stats_update_tc_recv_priority(struct net_if *iface,
 #define net_stats_update_tc_recv_priority(iface, tc, priority)
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE) && defined(CONFIG_NET_STATISTICS)
+static inline void net_stats_update_rxq_pkt(struct net_if *iface, u8_t q,
+					    size_t bytes)
+{
+	UPDATE_STAT(iface, stats.rxq.queue[q].pkts++);
+	UPDATE_STAT(iface, stats.rxq.queue[q].bytes += bytes);
+}
+
+static inline void net_stats_update_rxq_batch(struct net_if *iface, u8_t q)
+{
+	UPDATE_STAT(iface, stats.rxq.queue[q].batches++);
+}
+#else
+#define net_stats_update_rxq_pkt(iface, q, bytes)
+#define net_stats_update_rxq_batch(iface, q)
+#endif /* CONFIG_NET_RX_MULTI_QUEUE */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 /* A simple periodic statistic printer, used only in net core */
 void net_print_statistics_all(void);
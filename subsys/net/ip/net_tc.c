@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -24,11 +25,17 @@ NET_STACK_ARRAY_DEFINE(TX, tx_stack,
 		       CONFIG_NET_TX_STACK_SIZE,
 		       NET_TC_TX_COUNT);
 
-/* Stacks for RX work queue */
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+#define RX_THREAD_COUNT CONFIG_NET_RX_QUEUE_COUNT
+#else
+#define RX_THREAD_COUNT NET_TC_RX_COUNT
+#endif
+
+/* Stacks for RX work queue, or for the flow steered RX queues */
 NET_STACK_ARRAY_DEFINE(RX, rx_stack,
 		       CONFIG_NET_RX_STACK_SIZE,
 		       CONFIG_NET_RX_STACK_SIZE,
-		       NET_TC_RX_COUNT);
+		       RX_THREAD_COUNT);
 
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
@@ -43,6 +50,11 @@ void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt)
 	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
 }
 
+void net_tc_submit_work_to_tx_queue(u8_t tc, struct k_work *work)
+{
+	k_work_submit_to_queue(&tx_classes[tc].work_q, work);
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 	if (prio > NET_PRIORITY_NC) {
@@ -177,6 +189,303 @@ static u8_t rx_tc2thread(u8_t tc)
 #define RX_STACK(idx) NET_STACK_GET_NAME(RX, rx_stack, 0)[idx]
 #endif
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+/* Packets are linked through their first word, which is reserved for
+ * queueing, like k_fifo does.  The thread of the queue is only woken up
+ * when the list goes from empty to non-empty, and then takes all the
+ * queued packets at once.
+ */
+struct net_rx_queue {
+	struct k_spinlock lock;
+	sys_slist_t pkts;
+	struct k_sem sem;
+	struct k_thread thread;
+};
+
+static struct net_rx_queue rx_queues[CONFIG_NET_RX_QUEUE_COUNT];
+
+static inline u32_t rx_hash_mix(u32_t hash, u32_t value)
+{
+	/* Multiplicative hashing, the upper bits are the best mixed */
+	return (hash ^ value) * 0x9e3779b1U;
+}
+
+static u32_t rx_hash_addr(u32_t hash, const u8_t *addr, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i += sizeof(u32_t)) {
+		hash = rx_hash_mix(hash, UNALIGNED_GET((u32_t *)&addr[i]));
+	}
+
+	return hash;
+}
+
+/* Moves the cursor of a packet that has not gone through L2 yet to its
+ * IP header.  Returns false if the L2 of the packet is not known to
+ * carry IP packets right after its own header.
+ */
+static bool rx_flow_skip_l2(struct net_pkt *pkt)
+{
+	const struct net_l2 *l2 = net_if_l2(net_pkt_iface(pkt));
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (l2 == &NET_L2_GET_NAME(ETHERNET)) {
+		u16_t type;
+
+		if (net_pkt_skip(pkt, 2 * sizeof(struct net_eth_addr)) ||
+		    net_pkt_read_be16(pkt, &type)) {
+			return false;
+		}
+
+		if (type == NET_ETH_PTYPE_VLAN &&
+		    net_pkt_skip(pkt, sizeof(u16_t) * 2)) {
+			return false;
+		}
+
+		return true;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	/* Loopback and SLIP pass raw IP packets */
+	if (l2 == &NET_L2_GET_NAME(DUMMY)) {
+		return true;
+	}
+#endif
+
+	ARG_UNUSED(l2);
+
+	return false;
+}
+
+/* Hash of the addresses, protocol and ports of a packet that has not
+ * gone through L2 yet.  Fragments, and packets with IPv6 extension
+ * headers, are hashed on their addresses and protocol only so that
+ * they stay together.  Anything else that is not IP, or comes from an
+ * L2 other than Ethernet or raw IP, hashes to 0.
+ */
+static u32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	u32_t hash = 0U;
+	size_t hdr_len;
+	u32_t ports;
+	u8_t vtc;
+
+	net_pkt_cursor_init(pkt);
+
+	if (!rx_flow_skip_l2(pkt)) {
+		goto out;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (net_pkt_read_u8(pkt, &vtc)) {
+		goto out;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (vtc & 0xf0) == 0x40) {
+		NET_PKT_DATA_ACCESS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+		struct net_ipv4_hdr *hdr;
+
+		hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt,
+							       &ipv4_access);
+		if (!hdr) {
+			goto out;
+		}
+
+		hash = rx_hash_mix(hash, hdr->proto);
+		hash = rx_hash_addr(hash, (u8_t *)&hdr->src,
+				    2 * sizeof(struct in_addr));
+
+		/* More fragments flag or fragment offset */
+		if ((hdr->offset[0] & 0x3f) || hdr->offset[1] ||
+		    (hdr->proto != IPPROTO_TCP && hdr->proto != IPPROTO_UDP)) {
+			goto out;
+		}
+
+		hdr_len = (hdr->vhl & 0x0f) * 4U;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (vtc & 0xf0) == 0x60) {
+		NET_PKT_DATA_ACCESS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+		struct net_ipv6_hdr *hdr;
+
+		hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt,
+							       &ipv6_access);
+		if (!hdr) {
+			goto out;
+		}
+
+		hash = rx_hash_mix(hash, hdr->nexthdr);
+		hash = rx_hash_addr(hash, (u8_t *)&hdr->src,
+				    2 * sizeof(struct in6_addr));
+
+		if (hdr->nexthdr != IPPROTO_TCP &&
+		    hdr->nexthdr != IPPROTO_UDP) {
+			goto out;
+		}
+
+		hdr_len = sizeof(struct net_ipv6_hdr);
+	} else {
+		goto out;
+	}
+
+	/* Source and destination ports come first in both TCP and UDP */
+	if (!net_pkt_skip(pkt, hdr_len) &&
+	    !net_pkt_read(pkt, &ports, sizeof(ports))) {
+		hash = rx_hash_mix(hash, ports);
+	}
+
+out:
+	net_pkt_cursor_init(pkt);
+
+	return hash;
+}
+
+static u8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	u32_t hash = rx_flow_hash(pkt);
+	/* Scale the upper bits of the hash to the number of queues */
+	u8_t q = ((hash >> 16) * CONFIG_NET_RX_QUEUE_COUNT) >> 16;
+
+	net_stats_update_rxq_pkt(net_pkt_iface(pkt), q, net_pkt_get_len(pkt));
+
+	return q;
+}
+
+static void rx_queue_append(struct net_rx_queue *rxq, sys_slist_t *pkts)
+{
+	k_spinlock_key_t key;
+	bool was_empty;
+
+	key = k_spin_lock(&rxq->lock);
+	was_empty = sys_slist_is_empty(&rxq->pkts);
+	sys_slist_merge_slist(&rxq->pkts, pkts);
+	k_spin_unlock(&rxq->lock, key);
+
+	if (was_empty) {
+		k_sem_give(&rxq->sem);
+	}
+}
+
+void net_tc_submit_to_rx_flow_queue(struct net_pkt *pkt)
+{
+	sys_slist_t pkts;
+
+	sys_slist_init(&pkts);
+	sys_slist_append(&pkts, (sys_snode_t *)pkt);
+
+	rx_queue_append(&rx_queues[rx_flow_queue(pkt)], &pkts);
+}
+
+/* Sorts the packets per queue first, so that each queue is locked and
+ * woken up once per batch
+ */
+void net_tc_submit_batch_to_rx_flow_queue(struct net_pkt **pkts, int count)
+{
+	sys_slist_t lists[CONFIG_NET_RX_QUEUE_COUNT];
+	int i;
+
+	for (i = 0; i < CONFIG_NET_RX_QUEUE_COUNT; i++) {
+		sys_slist_init(&lists[i]);
+	}
+
+	for (i = 0; i < count; i++) {
+		sys_slist_append(&lists[rx_flow_queue(pkts[i])],
+				 (sys_snode_t *)pkts[i]);
+	}
+
+	for (i = 0; i < CONFIG_NET_RX_QUEUE_COUNT; i++) {
+		if (!sys_slist_is_empty(&lists[i])) {
+			rx_queue_append(&rx_queues[i], &lists[i]);
+		}
+	}
+}
+
+static void rx_queue_thread(void *p1, void *p2, void *p3)
+{
+	struct net_rx_queue *rxq = p1;
+	u8_t q = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_spinlock_key_t key;
+		struct net_pkt *pkt;
+		sys_slist_t batch;
+		sys_snode_t *node;
+
+		k_sem_take(&rxq->sem, K_FOREVER);
+
+		key = k_spin_lock(&rxq->lock);
+		batch = rxq->pkts;
+		sys_slist_init(&rxq->pkts);
+		k_spin_unlock(&rxq->lock, key);
+
+		pkt = (struct net_pkt *)sys_slist_peek_head(&batch);
+		if (!pkt) {
+			continue;
+		}
+
+		net_stats_update_rxq_batch(net_pkt_iface(pkt), q);
+
+		while ((node = sys_slist_get(&batch)) != NULL) {
+			struct k_work *work;
+
+			pkt = (struct net_pkt *)node;
+			work = net_pkt_work(pkt);
+
+			/* The handler was set by net_queue_rx() */
+			work->handler(work);
+		}
+
+		/* Let the other queues of the same priority run */
+		k_yield();
+	}
+}
+
+static void rx_queues_init(void)
+{
+	/* Same priority as the single RX traffic class */
+	u8_t thread_priority = rx_tc2thread(0);
+	int i;
+
+	for (i = 0; i < CONFIG_NET_RX_QUEUE_COUNT; i++) {
+		struct net_rx_queue *rxq = &rx_queues[i];
+
+		sys_slist_init(&rxq->pkts);
+		k_sem_init(&rxq->sem, 0, 1);
+
+#if defined(CONFIG_NET_SHELL)
+		NET_STACK_GET_NAME(RX, rx_stack, 0)[i].stack = rx_stack[i];
+		NET_STACK_GET_NAME(RX, rx_stack, 0)[i].prio = thread_priority;
+		NET_STACK_GET_NAME(RX, rx_stack, 0)[i].idx = i;
+#endif
+
+		NET_DBG("[%d] Starting RX queue %p stack %p size %zd "
+			"prio %d (%d)", i, rxq, RX_STACK(i),
+			K_THREAD_STACK_SIZEOF(rx_stack[i]),
+			thread_priority, K_PRIO_COOP(thread_priority));
+
+		k_thread_create(&rxq->thread, rx_stack[i],
+				K_THREAD_STACK_SIZEOF(rx_stack[i]),
+				rx_queue_thread, rxq, UINT_TO_POINTER(i), NULL,
+				K_PRIO_COOP(thread_priority), 0, K_FOREVER);
+		k_thread_name_set(&rxq->thread, "rx_queue");
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		k_thread_cpu_mask_clear(&rxq->thread);
+		k_thread_cpu_mask_enable(&rxq->thread,
+					 i % CONFIG_MP_NUM_CPUS);
+#endif
+
+		k_thread_start(&rxq->thread);
+	}
+}
+#endif /* CONFIG_NET_RX_MULTI_QUEUE */
+
 #if defined(CONFIG_NET_STATISTICS)
 /* Fixup the traffic class statistics so that "net stats" shell command will
  * print output correctly.
@@ -271,6 +580,11 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
+#if defined(CONFIG_NET_RX_MULTI_QUEUE)
+	ARG_UNUSED(i);
+
+	rx_queues_init();
+#else
 	for (i = 0; i < NET_TC_RX_COUNT; i++) {
 		u8_t thread_priority;
 
@@ -298,4 +612,5 @@ void net_tc_rx_init(void)
 			       K_PRIO_COOP(thread_priority));
 		k_thread_name_set(&rx_classes[i].work_q.thread, "rx_workq");
 	}
+#endif
 }
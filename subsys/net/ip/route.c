@@ -236,6 +236,244 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 	return 0;
 }
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* Path compressed binary trie of the route prefixes.  A node holds the
+ * routes whose prefix it represents, glue nodes (without routes) being
+ * only kept where two branches split, so there are less than two nodes
+ * per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	u8_t prefix_len;
+};
+
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_free;
+static struct route_trie_node *trie_root;
+
+static inline int prefix_bit(const struct in6_addr *addr, u8_t bit)
+{
+	return (addr->s6_addr[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+/* Length of the common part of two prefixes */
+static u8_t prefix_common_len(const struct in6_addr *a, u8_t a_len,
+			      const struct in6_addr *b, u8_t b_len)
+{
+	u8_t max_len = MIN(a_len, b_len);
+	u8_t len = 0U;
+
+	while (len < max_len && a->s6_addr[len / 8] == b->s6_addr[len / 8]) {
+		len += 8U;
+	}
+
+	while (len < max_len && prefix_bit(a, len) == prefix_bit(b, len)) {
+		len++;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct route_trie_node *trie_node_alloc(const struct in6_addr *prefix,
+					       u8_t prefix_len)
+{
+	struct route_trie_node *node = trie_free;
+
+	NET_ASSERT(node);
+
+	trie_free = node->child[0];
+
+	(void)memset(node, 0, sizeof(*node));
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = trie_free;
+	trie_free = node;
+}
+
+static void trie_init(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(trie_nodes); i++) {
+		trie_node_free(&trie_nodes[i]);
+	}
+}
+
+/* Returns the node of the given prefix, creating it if needed */
+static struct route_trie_node *trie_get(const struct in6_addr *prefix,
+					u8_t prefix_len)
+{
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node *node, *split;
+	u8_t len;
+
+	while (*link) {
+		node = *link;
+
+		len = prefix_common_len(prefix, prefix_len,
+					&node->prefix, node->prefix_len);
+		if (len == node->prefix_len) {
+			if (len == prefix_len) {
+				return node;
+			}
+
+			link = &node->child[prefix_bit(prefix, len)];
+			continue;
+		}
+
+		/* The prefixes diverge before the end of this node,
+		 * insert a node where they do.
+		 */
+		split = trie_node_alloc(prefix, len);
+		split->child[prefix_bit(&node->prefix, len)] = node;
+		*link = split;
+
+		if (len == prefix_len) {
+			return split;
+		}
+
+		link = &split->child[prefix_bit(prefix, len)];
+		break;
+	}
+
+	*link = trie_node_alloc(prefix, prefix_len);
+
+	return *link;
+}
+
+static void trie_add(struct net_route_entry *route)
+{
+	struct route_trie_node *node;
+
+	node = trie_get(&route->addr, route->prefix_len);
+	sys_slist_append(&node->routes, &route->trie_node);
+}
+
+/* Removes a node that no longer holds routes, if it is not needed for
+ * branching.  Returns true if the node was removed.
+ */
+static bool trie_collapse(struct route_trie_node **link)
+{
+	struct route_trie_node *node = *link;
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] && node->child[1])) {
+		return false;
+	}
+
+	*link = node->child[0] ? node->child[0] : node->child[1];
+	trie_node_free(node);
+
+	return true;
+}
+
+static void trie_del(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node **parent_link = NULL;
+
+	while (*link && (*link)->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &(*link)->child[prefix_bit(&route->addr,
+						  (*link)->prefix_len)];
+	}
+
+	if (!*link || (*link)->prefix_len != route->prefix_len ||
+	    !sys_slist_find_and_remove(&(*link)->routes, &route->trie_node)) {
+		return;
+	}
+
+	/* A leaf going away can leave its parent with a single child */
+	if (trie_collapse(link) && parent_link) {
+		trie_collapse(parent_link);
+	}
+}
+
+static struct net_route_entry *trie_lookup(struct net_if *iface,
+					   struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node && net_ipv6_is_prefix((u8_t *)dst, (u8_t *)&node->prefix,
+					  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[prefix_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#else
+#define trie_init()
+#define trie_lookup(...) NULL
+#define trie_add(...)
+#define trie_del(...)
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+struct route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+static u8_t route_cache_next;
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(route_cache); i++) {
+		if (route_cache[i].route && route_cache[i].iface == iface &&
+		    net_ipv6_addr_cmp(&route_cache[i].dst, dst)) {
+			return route_cache[i].route;
+		}
+	}
+
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = &route_cache[route_cache_next];
+
+	entry->iface = iface;
+	entry->route = route;
+	net_ipaddr_copy(&entry->dst, dst);
+
+	route_cache_next = (route_cache_next + 1) % ARRAY_SIZE(route_cache);
+}
+
+static void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(...) NULL
+#define route_cache_put(...)
+#define route_cache_flush()
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
 
 #define net_route_info(str, route, dst)					\
 	if (CONFIG_NET_ROUTE_LOG_LEVEL >= LOG_LEVEL_DBG) {		\
@@ -256,8 +494,9 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+/* Compares the destination with every route */
+static struct net_route_entry *table_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	u8_t longest_match = 0U;
@@ -285,10 +524,31 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	found = route_cache_get(iface, dst);
+	if (found) {
+		update_route_access(found);
+		return found;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE)) {
+		found = trie_lookup(iface, dst);
+	} else {
+		found = table_lookup(iface, dst);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
 		update_route_access(found);
+		route_cache_put(iface, dst, found);
 	}
 
 	return found;
@@ -402,6 +662,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	sys_slist_prepend(&routes, &route->node);
 
+	trie_add(route);
+	route_cache_flush();
+
 	tmp = nbr_nexthop_get(iface, nexthop);
 
 	NET_ASSERT(tmp == nbr_nexthop);
@@ -462,6 +725,9 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+	trie_del(route);
+	route_cache_flush();
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -826,6 +1092,8 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 void net_route_init(void)
 {
+	trie_init();
+
 	NET_DBG("Allocated %d routing entries (%zu bytes)",
 		CONFIG_NET_MAX_ROUTES, sizeof(net_route_entries_pool));
 
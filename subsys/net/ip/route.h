@@ -59,6 +59,13 @@ struct net_route_entry {
 
 	/** IPv6 address/prefix length. */
 	u8_t prefix_len;
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Node in the list of the routes with this prefix, in the
+	 * prefix trie.
+	 */
+	sys_snode_t trie_node;
+#endif
 };
 
 /**
@@ -52,6 +52,7 @@ static struct tcp_backlog_entry {
 	struct k_delayed_work ack_timer;
 	struct sockaddr remote;
 	u16_t send_mss;
+	bool sack_permitted;
 } tcp_backlog[CONFIG_NET_TCP_BACKLOG_SIZE];
 
 #if defined(CONFIG_NET_TCP_ACK_TIMEOUT)
@@ -60,6 +61,10 @@ static struct tcp_backlog_entry {
 #define ACK_TIMEOUT K_SECONDS(1)
 #endif
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+#define DELAYED_ACK_TIMEOUT K_MSEC(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT)
+#endif
+
 #define FIN_TIMEOUT K_SECONDS(1)
 
 /* Declares a wrapper function for a net_conn callback that refs the
@@ -161,12 +166,6 @@ static void net_tcp_trace(struct net_pkt *pkt,
 		ntohs(tcp_hdr->chksum));
 }
 
-static inline u32_t retry_timeout(const struct net_tcp *tcp)
-{
-	return ((u32_t)1 << tcp->retry_timeout_shift) *
-				CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
-}
-
 #define is_6lo_technology(pkt)						\
 	(IS_ENABLED(CONFIG_NET_IPV6) &&	net_pkt_family(pkt) == AF_INET6 &&  \
 	 ((IS_ENABLED(CONFIG_NET_L2_BT) &&				\
@@ -208,10 +207,40 @@ static void abort_connection(struct net_tcp *tcp)
 	net_context_unref(ctx);
 }
 
+/* Resend the first unack'd packet */
+static void tcp_retransmit_head(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+
+	pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
+			   struct net_pkt, sent_list);
+
+	if (net_pkt_sent(pkt)) {
+		do_ref_if_needed(tcp, pkt);
+		net_pkt_set_sent(pkt, false);
+	}
+
+	net_pkt_set_queued(pkt, true);
+
+	if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
+		NET_DBG("retry %u: [%p] pkt %p send failed",
+			tcp->retry_timeout_shift, tcp, pkt);
+		net_pkt_unref(pkt);
+	} else {
+		NET_DBG("retry %u: [%p] sent pkt %p",
+			tcp->retry_timeout_shift, tcp, pkt);
+		if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
+		    !is_6lo_technology(pkt)) {
+			net_stats_update_tcp_seg_rexmit(net_pkt_iface(pkt));
+		}
+	}
+
+	net_tcp_cc_retransmitted(tcp);
+}
+
 static void tcp_retry_expired(struct k_work *work)
 {
 	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp, retry_timer);
-	struct net_pkt *pkt;
 
 	/* Double the retry period for exponential backoff and resend
 	 * the first (only the first!) unack'd packet.
@@ -224,31 +253,10 @@ static void tcp_retry_expired(struct k_work *work)
 			return;
 		}
 
-		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
-
-		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
-				   struct net_pkt, sent_list);
-
-		if (net_pkt_sent(pkt)) {
-			do_ref_if_needed(tcp, pkt);
-			net_pkt_set_sent(pkt, false);
-		}
-
-		net_pkt_set_queued(pkt, true);
+		k_delayed_work_submit(&tcp->retry_timer, net_tcp_cc_rto(tcp));
 
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
-			NET_DBG("retry %u: [%p] pkt %p send failed",
-				tcp->retry_timeout_shift, tcp, pkt);
-			net_pkt_unref(pkt);
-		} else {
-			NET_DBG("retry %u: [%p] sent pkt %p",
-				tcp->retry_timeout_shift, tcp, pkt);
-			if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
-			    !is_6lo_technology(pkt)) {
-				net_stats_update_tcp_seg_rexmit(
-							net_pkt_iface(pkt));
-			}
-		}
+		net_tcp_cc_timeout(tcp);
+		tcp_retransmit_head(tcp);
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
 			NET_DBG("[%p] Closing connection (context %p)",
@@ -308,11 +316,208 @@ static void retry_timer_cancel(struct net_tcp *tcp)
 	k_delayed_work_cancel(&tcp->retry_timer);
 }
 
+static void delack_timer_cancel(struct net_tcp *tcp)
+{
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	k_delayed_work_cancel(&tcp->delack_timer);
+#endif
+	tcp->ack_pending = 0U;
+}
+
 static void timewait_timer_cancel(struct net_tcp *tcp)
 {
 	k_delayed_work_cancel(&tcp->timewait_timer);
 }
 
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+/* Drops len bytes from the front of a buffer chain */
+static struct net_buf *tcp_buf_pull(struct net_buf *buf, size_t len)
+{
+	while (buf && len >= buf->len) {
+		len -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf && len) {
+		net_buf_pull(buf, len);
+	}
+
+	return buf;
+}
+
+/* Keeps the payload of a segment received past a hole, unless it is not
+ * worth keeping.  The packet is then left without any buffer.
+ */
+static void tcp_ooo_queue(struct net_tcp *tcp, struct net_pkt *pkt,
+			  u32_t seq, u16_t len)
+{
+	u32_t end = seq + len;
+	struct net_buf *buf;
+	int pos;
+
+	/* Only keep what fits in the advertised window */
+	if (!len || net_tcp_seq_greater(end, tcp->send_ack +
+					net_tcp_get_recv_wnd(tcp))) {
+		return;
+	}
+
+	for (pos = 0; pos < tcp->ooo_count; pos++) {
+		struct net_tcp_ooo *ooo = &tcp->ooo[pos];
+
+		if (net_tcp_seq_greater(ooo->seq, seq)) {
+			break;
+		}
+
+		if (!net_tcp_seq_greater(end, ooo->seq + ooo->len)) {
+			/* Already queued */
+			return;
+		}
+	}
+
+	if (tcp->ooo_count == CONFIG_NET_TCP_OOO_QUEUE_LEN) {
+		/* Keep the data closest to the hole */
+		if (pos == tcp->ooo_count) {
+			return;
+		}
+
+		net_buf_unref(tcp->ooo[--tcp->ooo_count].buf);
+	}
+
+	/* The cursor is on the payload, drop the headers before it */
+	buf = tcp_buf_pull(pkt->buffer, net_pkt_get_len(pkt) - len);
+	pkt->buffer = NULL;
+	net_pkt_cursor_init(pkt);
+
+	memmove(&tcp->ooo[pos + 1], &tcp->ooo[pos],
+		(tcp->ooo_count - pos) * sizeof(tcp->ooo[0]));
+
+	tcp->ooo[pos].buf = buf;
+	tcp->ooo[pos].seq = seq;
+	tcp->ooo[pos].len = len;
+	tcp->ooo_count++;
+	tcp->ooo_last_seq = seq;
+
+	net_stats_update_tcp_ooo_queued(net_pkt_iface(pkt));
+
+	NET_DBG("[%p] queued seq %u len %u (%u segments)", tcp, seq, len,
+		tcp->ooo_count);
+}
+
+/* Chains the queued data that directly follows the in-order segment
+ * in pkt to it.  Returns the new payload length.
+ */
+static u16_t tcp_ooo_merge(struct net_tcp *tcp, struct net_pkt *pkt,
+			   u16_t len)
+{
+	u32_t end = tcp->send_ack + len;
+	int n = 0;
+
+	while (n < tcp->ooo_count &&
+	       !net_tcp_seq_greater(tcp->ooo[n].seq, end)) {
+		struct net_tcp_ooo *ooo = &tcp->ooo[n++];
+		u32_t ooo_end = ooo->seq + ooo->len;
+
+		if (!net_tcp_seq_greater(ooo_end, end)) {
+			/* Retransmitted data covered all of it */
+			net_buf_unref(ooo->buf);
+			continue;
+		}
+
+		net_pkt_append_buffer(pkt, tcp_buf_pull(ooo->buf,
+							end - ooo->seq));
+		len += ooo_end - end;
+		end = ooo_end;
+	}
+
+	tcp->ooo_count -= n;
+	memmove(&tcp->ooo[0], &tcp->ooo[n],
+		tcp->ooo_count * sizeof(tcp->ooo[0]));
+
+	return len;
+}
+
+static void tcp_ooo_flush(struct net_tcp *tcp)
+{
+	while (tcp->ooo_count) {
+		net_buf_unref(tcp->ooo[--tcp->ooo_count].buf);
+	}
+}
+#else
+#define tcp_ooo_queue(...)
+#define tcp_ooo_merge(tcp, pkt, len) (len)
+#define tcp_ooo_flush(...)
+#endif /* CONFIG_NET_TCP_OOO_QUEUE */
+
+#if defined(CONFIG_NET_TCP_SACK)
+#define SACK_OPT_MAX_LEN (4 + NET_TCP_SACK_MAX_BLOCKS * 8)
+
+/* Builds the SACK option reporting the queued out-of-order data, the
+ * block with the latest segment first (RFC 2018, section 4).  Returns
+ * its length, 0 if there is nothing to report.
+ */
+static u8_t tcp_sack_opt(struct net_tcp *tcp, u8_t *options)
+{
+	u32_t blocks[CONFIG_NET_TCP_OOO_QUEUE_LEN][2];
+	int count = 0;
+	int first = 0;
+	u8_t len = 4U;
+	int i;
+
+	if (!(tcp->flags & NET_TCP_SACK_PERMITTED) || !tcp->ooo_count) {
+		return 0;
+	}
+
+	/* Merge adjacent segments into blocks */
+	for (i = 0; i < tcp->ooo_count; i++) {
+		u32_t start = tcp->ooo[i].seq;
+		u32_t end = start + tcp->ooo[i].len;
+
+		if (count && !net_tcp_seq_greater(start, blocks[count - 1][1])) {
+			if (net_tcp_seq_greater(end, blocks[count - 1][1])) {
+				blocks[count - 1][1] = end;
+			}
+		} else {
+			blocks[count][0] = start;
+			blocks[count][1] = end;
+			count++;
+		}
+
+		if (start == tcp->ooo_last_seq) {
+			first = count - 1;
+		}
+	}
+
+	for (i = -1; i < count && len < SACK_OPT_MAX_LEN; i++) {
+		int b = i < 0 ? first : i;
+
+		if (i == first) {
+			continue;
+		}
+
+		sys_put_be32(blocks[b][0], options + len);
+		sys_put_be32(blocks[b][1], options + len + 4);
+		len += 8U;
+	}
+
+	options[0] = NET_TCP_NOP_OPT;
+	options[1] = NET_TCP_NOP_OPT;
+	options[2] = NET_TCP_SACK_OPT;
+	options[3] = len - 2U;
+
+	return len;
+}
+
+static void tcp_set_sack_perm_opt(u8_t *options, u8_t *optionlen)
+{
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_SACK_PERM_OPT;
+	options[(*optionlen)++] = NET_TCP_SACK_PERM_SIZE;
+}
+#else
+#define tcp_set_sack_perm_opt(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
 int net_tcp_release(struct net_tcp *tcp)
 {
 	struct net_pkt *pkt;
@@ -329,18 +534,22 @@ int net_tcp_release(struct net_tcp *tcp)
 		net_pkt_unref(pkt);
 	}
 
+	tcp_ooo_flush(tcp);
+
 	retry_timer_cancel(tcp);
 	k_sem_reset(&tcp->connect_wait);
 
 	ack_timer_cancel(tcp);
 	fin_timer_cancel(tcp);
 	timewait_timer_cancel(tcp);
+	delack_timer_cancel(tcp);
 
 	net_tcp_change_state(tcp, NET_TCP_CLOSED);
 	tcp->context = NULL;
 
 	key = irq_lock();
-	tcp->flags &= ~(NET_TCP_IN_USE | NET_TCP_RECV_MSS_SET);
+	tcp->flags &= ~(NET_TCP_IN_USE | NET_TCP_RECV_MSS_SET |
+			NET_TCP_SACK_PERMITTED | NET_TCP_NODELAY);
 	irq_unlock(key);
 
 	NET_DBG("[%p] Disposed of TCP connection state", tcp);
@@ -674,6 +883,13 @@ static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
 		      (u32_t *)(options + *optionlen));
 
 	*optionlen += NET_TCP_MSS_SIZE;
+
+	/* Offer SACK when connecting, accept it if the peer did */
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (net_tcp_get_state(tcp) == NET_TCP_SYN_SENT ||
+	     (tcp->flags & NET_TCP_SACK_PERMITTED))) {
+		tcp_set_sack_perm_opt(options, optionlen);
+	}
 }
 
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
@@ -700,6 +916,20 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		return net_tcp_prepare_segment(tcp, NET_TCP_FIN | NET_TCP_ACK,
 					       0, 0, NULL, remote, pkt);
 	default:
+#if defined(CONFIG_NET_TCP_SACK)
+		{
+			u8_t sack[SACK_OPT_MAX_LEN];
+
+			optionlen = tcp_sack_opt(tcp, sack);
+			if (optionlen) {
+				return net_tcp_prepare_segment(tcp, NET_TCP_ACK,
+							       sack, optionlen,
+							       NULL, remote,
+							       pkt);
+			}
+		}
+#endif
+
 		return net_tcp_prepare_segment(tcp, NET_TCP_ACK, 0, 0, NULL,
 					       remote, pkt);
 	}
@@ -800,6 +1030,103 @@ const char *net_tcp_state_str(enum net_tcp_state state)
 	return "";
 }
 
+/* Returns the TCP header of a queued segment, and the sequence space
+ * it uses in seq_len.  The pkt cursor is left on the payload.
+ */
+static struct net_tcp_hdr *tcp_pkt_seq_len(struct net_pkt *pkt,
+					   struct net_pkt_data_access *access,
+					   u32_t *seq_len)
+{
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt))) {
+		return NULL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, access);
+	if (!tcp_hdr) {
+		/* The pkt does not contain TCP header, this should
+		 * not happen.
+		 */
+		NET_ERR("pkt %p has no TCP header", pkt);
+		return NULL;
+	}
+
+	net_pkt_acknowledge_data(pkt, access);
+	*seq_len = net_pkt_remaining_data(pkt);
+
+	/* Each of SYN and FIN flags are counted
+	 * as one sequence number.
+	 */
+	if (tcp_hdr->flags & NET_TCP_SYN) {
+		*seq_len += 1U;
+	}
+	if (tcp_hdr->flags & NET_TCP_FIN) {
+		*seq_len += 1U;
+	}
+
+	return tcp_hdr;
+}
+
+#if defined(CONFIG_NET_TCP_NAGLE)
+/* Appends the data in pkt to the last queued segment, if it has not
+ * been sent yet and can hold it.  The pkt is left without buffer.
+ */
+static bool tcp_coalesce(struct net_tcp *tcp, struct net_pkt *pkt,
+			 size_t data_len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *last;
+	u32_t seq_len;
+
+	if (tcp->flags & NET_TCP_NODELAY) {
+		return false;
+	}
+
+	last = SYS_SLIST_PEEK_TAIL_CONTAINER(&tcp->sent_list, last, sent_list);
+	if (!last || net_pkt_queued(last) || net_pkt_sent(last)) {
+		return false;
+	}
+
+	tcp_hdr = tcp_pkt_seq_len(last, &tcp_access, &seq_len);
+	if (!tcp_hdr || tcp_hdr->flags != (NET_TCP_PSH | NET_TCP_ACK) ||
+	    seq_len + data_len > tcp->send_mss) {
+		return false;
+	}
+
+	net_pkt_append_buffer(last, pkt->buffer);
+	pkt->buffer = NULL;
+
+	/* Update the lengths and checksums, the headers being already
+	 * in place this cannot fail.
+	 */
+	(void)finalize_segment(last);
+
+	NET_DBG("[%p] Coalesced %zd bytes into %p", tcp, data_len, last);
+
+	return true;
+}
+
+/* A segment smaller than the MSS waits until all the data sent has
+ * been acknowledged (RFC 896, RFC 1122 section 4.2.3.4).
+ */
+static bool tcp_nagle_hold(struct net_tcp *tcp, struct net_tcp_hdr *tcp_hdr,
+			   u32_t seq_len, bool in_flight)
+{
+	return in_flight && !(tcp->flags & NET_TCP_NODELAY) &&
+	       !(tcp_hdr->flags & (NET_TCP_SYN | NET_TCP_FIN)) &&
+	       seq_len < tcp->send_mss;
+}
+#else
+#define tcp_coalesce(...) false
+#define tcp_nagle_hold(...) false
+#endif /* CONFIG_NET_TCP_NAGLE */
+
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
 	struct net_conn *conn = (struct net_conn *)context->conn_handler;
@@ -817,6 +1144,18 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 		return -ESHUTDOWN;
 	}
 
+	if (tcp_coalesce(context->tcp, pkt, data_len)) {
+		context->tcp->send_seq += data_len;
+
+		net_stats_update_tcp_sent(net_pkt_iface(pkt), data_len);
+		net_stats_update_tcp_coalesced(net_pkt_iface(pkt));
+
+		/* Only the data is kept */
+		net_pkt_unref(pkt);
+
+		return 0;
+	}
+
 	/* Set PSH on all packets, our window is so small that there's
 	 * no point in the remote side trying to finesse things and
 	 * coalesce packets.
@@ -844,7 +1183,7 @@ static int net_tcp_queue_pkt(struct net_context *context, struct net_pkt *pkt)
 	/* We need to restart retry_timer if it is stopped. */
 	if (k_delayed_work_remaining_get(&context->tcp->retry_timer) == 0) {
 		k_delayed_work_submit(&context->tcp->retry_timer,
-				      retry_timeout(context->tcp));
+				      net_tcp_cc_rto(context->tcp));
 	}
 
 	do_ref_if_needed(context->tcp, pkt);
@@ -857,7 +1196,8 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
 	struct net_context *ctx = net_pkt_context(pkt);
 	struct net_tcp_hdr *tcp_hdr;
-	bool calc_chksum = false;
+	bool calc_chksum;
+	u16_t old_val;
 
 	if (!ctx || !ctx->tcp) {
 		NET_ERR("%scontext is not set on pkt %p",
@@ -879,10 +1219,19 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 		return -EMSGSIZE;
 	}
 
+	/* The checksum is only set if it is not offloaded, it is then
+	 * updated for the modified fields instead of computed again.
+	 */
+	calc_chksum = net_if_need_calc_tx_checksum(net_pkt_iface(pkt));
+
 	if (sys_get_be32(tcp_hdr->ack) != ctx->tcp->send_ack) {
+		if (calc_chksum) {
+			tcp_hdr->chksum = net_chksum_update_u32(
+				tcp_hdr->chksum, sys_get_be32(tcp_hdr->ack),
+				ctx->tcp->send_ack);
+		}
+
 		sys_put_be32(ctx->tcp->send_ack, tcp_hdr->ack);
-		tcp_hdr->chksum = 0U;
-		calc_chksum = true;
 	}
 
 	/* The data stream code always sets this flag, because
@@ -892,31 +1241,28 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 	 */
 	if (ctx->tcp->sent_ack != ctx->tcp->send_ack &&
 		(tcp_hdr->flags & NET_TCP_ACK) == 0U) {
+		/* Offset and flags form a single 16-bit word */
+		old_val = (tcp_hdr->offset << 8) | tcp_hdr->flags;
+
 		tcp_hdr->flags |= NET_TCP_ACK;
-		tcp_hdr->chksum = 0U;
-		calc_chksum = true;
+
+		if (calc_chksum) {
+			tcp_hdr->chksum = net_chksum_update_u16(
+				tcp_hdr->chksum, old_val,
+				(tcp_hdr->offset << 8) | tcp_hdr->flags);
+		}
 	}
 
 	/* As we modified the header, we need to write it back.
 	 */
 	net_pkt_set_data(pkt, &tcp_access);
 
-	if (calc_chksum) {
-		net_pkt_cursor_init(pkt);
-		net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
-			     net_pkt_ipv6_ext_len(pkt));
-
-		/* No need to get tcp_hdr again */
-		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
-
-		net_pkt_set_data(pkt, &tcp_access);
-	}
-
 	if (tcp_hdr->flags & NET_TCP_FIN) {
 		ctx->tcp->fin_sent = 1U;
 	}
 
 	ctx->tcp->sent_ack = ctx->tcp->send_ack;
+	ctx->tcp->ack_pending = 0U;
 
 	/* We must have special handling for some network technologies that
 	 * tweak the IP protocol headers during packet sending. This happens
@@ -975,7 +1321,7 @@ static void restart_timer(struct net_tcp *tcp)
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
 		tcp->flags |= NET_TCP_RETRYING;
 		tcp->retry_timeout_shift = 0U;
-		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
+		k_delayed_work_submit(&tcp->retry_timer, net_tcp_cc_rto(tcp));
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0 &&
 			(tcp->fin_sent && tcp->fin_rcvd)) {
 		/* We know sent_list is empty, which means if
@@ -993,22 +1339,54 @@ static void restart_timer(struct net_tcp *tcp)
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
 {
+	bool in_flight = false;
 	struct net_pkt *pkt;
 
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
+	/* Send all queued data synchronously, unless congestion control
+	 * or the Nagle algorithm holds it back. It is then sent from the
+	 * ACK handler.
 	 */
 	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
 		/* Do not resend packets that were sent by expire timer */
 		if (net_pkt_queued(pkt)) {
 			NET_DBG("[%p] Skipping pkt %p because it was already "
 				"sent.", context->tcp, pkt);
+			in_flight = true;
 			continue;
 		}
 
 		if (!net_pkt_sent(pkt)) {
+			NET_PKT_DATA_ACCESS_DEFINE(tcp_access,
+						   struct net_tcp_hdr);
+			struct net_tcp_hdr *tcp_hdr = NULL;
+			u32_t seq_len = 0U;
+			u32_t seq = 0U;
 			int ret;
 
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL) ||
+			    IS_ENABLED(CONFIG_NET_TCP_NAGLE)) {
+				tcp_hdr = tcp_pkt_seq_len(pkt, &tcp_access,
+							  &seq_len);
+			}
+
+			if (tcp_hdr) {
+				if (tcp_nagle_hold(context->tcp, tcp_hdr,
+						   seq_len, in_flight)) {
+					NET_DBG("[%p] pkt %p waits for the "
+						"ACK", context->tcp, pkt);
+					break;
+				}
+
+				if (!net_tcp_cc_can_send(context->tcp,
+							 seq_len)) {
+					NET_DBG("[%p] pkt %p waits for the "
+						"window", context->tcp, pkt);
+					break;
+				}
+
+				seq = sys_get_be32(tcp_hdr->seq);
+			}
+
 			NET_DBG("[%p] Sending pkt %p (%zd bytes)", context->tcp,
 				pkt, net_pkt_get_len(pkt));
 
@@ -1020,6 +1398,11 @@ int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 			}
 
 			net_pkt_set_queued(pkt, true);
+			in_flight = true;
+
+			if (tcp_hdr) {
+				net_tcp_cc_sent(context->tcp, seq, seq_len);
+			}
 		}
 	}
 
@@ -1063,41 +1446,13 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		head = sys_slist_peek_head(list);
 		pkt = CONTAINER_OF(head, struct net_pkt, sent_list);
 
-		net_pkt_cursor_init(pkt);
-		net_pkt_set_overwrite(pkt, true);
-
-		if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
-			 net_pkt_ipv6_ext_len(pkt))) {
-			sys_slist_remove(list, NULL, head);
-			net_pkt_unref(pkt);
-			continue;
-		}
-
-		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt,
-								 &tcp_access);
+		tcp_hdr = tcp_pkt_seq_len(pkt, &tcp_access, &seq_len);
 		if (!tcp_hdr) {
-			/* The pkt does not contain TCP header, this should
-			 * not happen.
-			 */
-			NET_ERR("pkt %p has no TCP header", pkt);
 			sys_slist_remove(list, NULL, head);
 			net_pkt_unref(pkt);
 			continue;
 		}
 
-		net_pkt_acknowledge_data(pkt, &tcp_access);
-		seq_len = net_pkt_remaining_data(pkt);
-
-		/* Each of SYN and FIN flags are counted
-		 * as one sequence number.
-		 */
-		if (tcp_hdr->flags & NET_TCP_SYN) {
-			seq_len += 1U;
-		}
-		if (tcp_hdr->flags & NET_TCP_FIN) {
-			seq_len += 1U;
-		}
-
 		/* Last sequence number in this packet. */
 		last_seq = sys_get_be32(tcp_hdr->seq) + seq_len - 1;
 
@@ -1210,6 +1565,10 @@ void net_tcp_change_state(struct net_tcp *tcp,
 
 	tcp->state = new_state;
 
+	if (new_state == NET_TCP_ESTABLISHED) {
+		net_tcp_cc_init(tcp);
+	}
+
 	if (net_tcp_get_state(tcp) != NET_TCP_CLOSED) {
 		return;
 	}
@@ -1282,6 +1641,170 @@ int net_tcp_finalize(struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+u16_t net_tcp_gso_size(struct net_tcp *tcp, struct net_if *iface,
+		       size_t len)
+{
+	size_t mss;
+
+	/* Only the Ethernet L2 knows how to cut the packet */
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0;
+	}
+
+	/* Segments must fit both the MSS of the peer and our MTU */
+	if (net_context_get_family(tcp->context) == AF_INET6) {
+		mss = net_if_get_mtu(iface) - NET_IPV6TCPH_LEN;
+	} else {
+		mss = net_if_get_mtu(iface) - NET_IPV4TCPH_LEN;
+	}
+
+	mss = MIN(mss, tcp->send_mss);
+	if (len <= mss) {
+		return 0;
+	}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/* The whole packet is sent, and retransmitted, at once: it must
+	 * fit both windows, and losing one of its segments costs all of
+	 * them.  Send single segments while recovering from a loss.
+	 */
+	if (tcp->cc && (len > MIN(tcp->cwnd, tcp->send_wnd) ||
+			net_tcp_cc_recovering(tcp))) {
+		return 0;
+	}
+#endif
+
+	return mss;
+}
+
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				   size_t offset, size_t len, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv6_ext_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+	net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	/* Headers, then this segment's share of the data */
+	net_pkt_cursor_init(pkt);
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	/* FIN and PSH belong to the end of the data */
+	if (!last) {
+		tcp_hdr->flags &= ~(NET_TCP_FIN | NET_TCP_PSH);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		goto fail;
+	}
+
+	if (finalize_segment(seg) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_gso_send(struct net_pkt *pkt,
+		     int (*send)(struct net_if *iface, struct net_pkt *pkt))
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv6_ext_len(pkt);
+	size_t gso_size = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len, offset;
+	bool overwrite;
+	int sent = 0;
+	int ret = 0;
+
+	overwrite = net_pkt_is_being_overwritten(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	hdr_len = ip_len + NET_TCP_HDR_LEN(tcp_hdr);
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0; offset < data_len; offset += gso_size) {
+		size_t len = MIN(gso_size, data_len - offset);
+		struct net_pkt *seg;
+
+		seg = gso_segment(pkt, hdr_len, offset, len,
+				  offset + len == data_len);
+		if (!seg) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = send(net_pkt_iface(pkt), seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+	}
+
+out:
+	net_pkt_set_overwrite(pkt, overwrite);
+	net_pkt_cursor_init(pkt);
+
+	return ret < 0 ? ret : sent;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 		       struct net_tcp_options *opts)
 {
@@ -1336,6 +1859,13 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 				goto error;
 			}
 
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (optlen != 0U) {
+				goto error;
+			}
+
+			opts->sack_permitted = true;
 			break;
 		default:
 			if (net_pkt_skip(pkt, optlen)) {
@@ -1437,6 +1967,37 @@ int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 	return 0;
 }
 
+int net_tcp_set_nodelay(struct net_context *context, bool nodelay)
+{
+	if (!context->tcp) {
+		return -EPROTOTYPE;
+	}
+
+	if (nodelay) {
+		context->tcp->flags |= NET_TCP_NODELAY;
+
+		/* Release what was held back */
+		if (net_context_get_state(context) == NET_CONTEXT_CONNECTED) {
+			net_tcp_send_data(context, NULL, NULL);
+		}
+	} else {
+		context->tcp->flags &= ~NET_TCP_NODELAY;
+	}
+
+	return 0;
+}
+
+int net_tcp_get_nodelay(struct net_context *context, bool *nodelay)
+{
+	if (!context->tcp) {
+		return -EPROTOTYPE;
+	}
+
+	*nodelay = !!(context->tcp->flags & NET_TCP_NODELAY);
+
+	return 0;
+}
+
 static int send_reset(struct net_context *context, struct sockaddr *local,
 		      struct sockaddr *remote);
 
@@ -1575,6 +2136,8 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 	tcp_backlog[empty_slot].send_seq = context->tcp->send_seq;
 	tcp_backlog[empty_slot].send_ack = context->tcp->send_ack;
 	tcp_backlog[empty_slot].send_mss = send_mss;
+	tcp_backlog[empty_slot].sack_permitted =
+		!!(context->tcp->flags & NET_TCP_SACK_PERMITTED);
 
 	k_delayed_work_init(&tcp_backlog[empty_slot].ack_timer,
 			    backlog_ack_timeout);
@@ -1605,6 +2168,9 @@ static int tcp_backlog_ack(struct net_pkt *pkt,
 	context->tcp->send_seq = tcp_backlog[r].send_seq + 1;
 	context->tcp->send_ack = tcp_backlog[r].send_ack;
 	context->tcp->send_mss = tcp_backlog[r].send_mss;
+	if (tcp_backlog[r].sack_permitted) {
+		context->tcp->flags |= NET_TCP_SACK_PERMITTED;
+	}
 
 	k_delayed_work_cancel(&tcp_backlog[r].ack_timer);
 	(void)memset(&tcp_backlog[r], 0, sizeof(struct tcp_backlog_entry));
@@ -1688,6 +2254,30 @@ static void handle_timewait_timeout(struct k_work *work)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+static int send_ack(struct net_context *context,
+		    struct sockaddr *remote, bool force);
+
+static void handle_delack_timeout(struct k_work *work)
+{
+	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp,
+					   delack_timer);
+	struct net_context *context = tcp->context;
+
+	if (!context) {
+		return;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (tcp->ack_pending) {
+		send_ack(context, &context->remote, false);
+	}
+
+	k_mutex_unlock(&context->lock);
+}
+#endif
+
 int net_tcp_get(struct net_context *context)
 {
 	context->tcp = net_tcp_alloc(context);
@@ -1700,6 +2290,10 @@ int net_tcp_get(struct net_context *context)
 	k_delayed_work_init(&context->tcp->fin_timer, handle_fin_timeout);
 	k_delayed_work_init(&context->tcp->timewait_timer,
 			    handle_timewait_timeout);
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	k_delayed_work_init(&context->tcp->delack_timer,
+			    handle_delack_timeout);
+#endif
 
 	return 0;
 }
@@ -1796,6 +2390,8 @@ static inline int send_syn_segment(struct net_context *context,
 
 	if (flags == NET_TCP_SYN) {
 		net_tcp_set_syn_opt(context->tcp, options, &optionlen);
+	} else if (context->tcp->flags & NET_TCP_SACK_PERMITTED) {
+		tcp_set_sack_perm_opt(options, &optionlen);
 	}
 
 	ret = net_tcp_prepare_segment(context->tcp, flags, options, optionlen,
@@ -1862,6 +2458,35 @@ static int send_ack(struct net_context *context,
 	return ret;
 }
 
+/* Acknowledges in-order data, every second segment only, the ACK of
+ * the other ones being delayed (RFC 1122, section 4.2.3.2).
+ */
+static void send_data_ack(struct net_context *context,
+			  struct sockaddr *remote)
+{
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	struct net_tcp *tcp = context->tcp;
+
+	/* Already piggybacked on data sent from the recv callback */
+	if (tcp->send_ack == tcp->sent_ack) {
+		return;
+	}
+
+	if (!tcp->ack_pending &&
+	    net_tcp_get_state(tcp) == NET_TCP_ESTABLISHED) {
+		tcp->ack_pending = 1U;
+		k_delayed_work_submit(&tcp->delack_timer, DELAYED_ACK_TIMEOUT);
+		net_stats_update_tcp_delayed_ack(
+			net_context_get_iface(context));
+		return;
+	}
+
+	k_delayed_work_cancel(&tcp->delack_timer);
+#endif
+
+	send_ack(context, remote, false);
+}
+
 static int send_reset(struct net_context *context,
 		      struct sockaddr *local,
 		      struct sockaddr *remote)
@@ -1884,6 +2509,26 @@ static int send_reset(struct net_context *context,
 	return ret;
 }
 
+static void tcp_cc_ack(struct net_context *context,
+		       struct net_tcp_hdr *tcp_hdr, u16_t data_len)
+{
+	struct net_tcp *tcp = context->tcp;
+	bool dup;
+
+	/* Only pure ACKs count as duplicates */
+	dup = data_len == 0U &&
+	      !(NET_TCP_FLAGS(tcp_hdr) & (NET_TCP_SYN | NET_TCP_FIN));
+
+	if (net_tcp_cc_ack(tcp, sys_get_be32(tcp_hdr->ack),
+			   sys_get_be16(tcp_hdr->wnd), dup) &&
+	    !sys_slist_is_empty(&tcp->sent_list)) {
+		tcp_retransmit_head(tcp);
+	}
+
+	/* Send what the window now allows */
+	net_tcp_send_data(context, NULL, NULL);
+}
+
 /* This is called when we receive data after the connection has been
  * established. The core TCP logic is located here.
  *
@@ -1899,6 +2544,7 @@ NET_CONN_CB(tcp_established)
 	struct net_context *context = (struct net_context *)user_data;
 	struct net_tcp_hdr *tcp_hdr = proto_hdr->tcp;
 	enum net_verdict ret = NET_OK;
+	bool delay_ack = false;
 	u8_t tcp_flags;
 	u16_t data_len;
 
@@ -1915,6 +2561,15 @@ NET_CONN_CB(tcp_established)
 
 	net_tcp_print_recv_info("DATA", pkt, tcp_hdr->src_port);
 
+	/* Only the fixed header has been read, skip the options so that
+	 * what remains is the payload.
+	 */
+	if (net_pkt_skip(pkt, NET_TCP_HDR_LEN(tcp_hdr) -
+			 sizeof(struct net_tcp_hdr))) {
+		ret = NET_DROP;
+		goto unlock;
+	}
+
 	tcp_flags = NET_TCP_FLAGS(tcp_hdr);
 
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
@@ -1934,12 +2589,20 @@ resend_ack:
 
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
 			    context->tcp->send_ack) > 0) {
-		/* Don't try to reorder packets.  If it doesn't
-		 * match the next segment exactly, drop and wait for
-		 * retransmit
+		/* A segment is missing.  Keep the data past the hole if
+		 * there is room for it, otherwise drop and wait for
+		 * retransmit.  Either way the duplicate ACK sent right
+		 * away lets the peer detect the loss before its
+		 * retransmission timer expires (RFC 5681, section 4.2),
+		 * and reports what was queued when SACK is in use.
 		 */
-		ret = NET_DROP;
-		goto unlock;
+		if (!(tcp_flags & (NET_TCP_FIN | NET_TCP_RST | NET_TCP_SYN))) {
+			tcp_ooo_queue(context->tcp, pkt,
+				      sys_get_be32(tcp_hdr->seq),
+				      net_pkt_remaining_data(pkt));
+		}
+
+		goto resend_ack;
 	}
 
 	/*
@@ -1977,6 +2640,14 @@ resend_ack:
 			goto unlock;
 		}
 
+		if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+			tcp_cc_ack(context, tcp_hdr,
+				   net_pkt_remaining_data(pkt));
+		} else if (IS_ENABLED(CONFIG_NET_TCP_NAGLE)) {
+			/* Send what was held back for this ACK */
+			net_tcp_send_data(context, NULL, NULL);
+		}
+
 		/* TCP state might be changed after maintaining the sent pkt
 		 * list, e.g., an ack of FIN is received.
 		 */
@@ -2039,6 +2710,19 @@ resend_ack:
 		goto unlock;
 	}
 
+	/* The hole is filled, hand the queued data over along with this
+	 * segment.  Data queued past a FIN cannot be valid.
+	 */
+	if (tcp_flags & NET_TCP_FIN) {
+		tcp_ooo_flush(context->tcp);
+	} else if (data_len > 0) {
+		u16_t merged_len = tcp_ooo_merge(context->tcp, pkt, data_len);
+
+		/* Only data that arrives in order has its ACK delayed */
+		delay_ack = merged_len == data_len;
+		data_len = merged_len;
+	}
+
 	/* If the pkt has data, notify the recv callback which should
 	 * release the pkt. Otherwise, release the pkt immediately.
 	 */
@@ -2055,7 +2739,11 @@ resend_ack:
 		context->tcp->send_ack += 1U;
 	}
 
-	send_ack(context, &conn->remote_addr, false);
+	if (delay_ack) {
+		send_data_ack(context, &conn->remote_addr);
+	} else {
+		send_ack(context, &conn->remote_addr, false);
+	}
 
 clean_up:
 	if (net_tcp_get_state(context->tcp) == NET_TCP_TIME_WAIT) {
@@ -2131,6 +2819,21 @@ NET_CONN_CB(tcp_synack_received)
 		context->tcp->send_ack =
 			sys_get_be32(tcp_hdr->seq) + 1;
 	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    NET_TCP_FLAGS(tcp_hdr) == (NET_TCP_SYN | NET_TCP_ACK)) {
+		struct net_tcp_options tcp_opts = { };
+
+		if (net_tcp_parse_opts(pkt, NET_TCP_HDR_LEN(tcp_hdr) -
+				       sizeof(struct net_tcp_hdr),
+				       &tcp_opts) < 0) {
+			return NET_DROP;
+		}
+
+		if (tcp_opts.sack_permitted) {
+			context->tcp->flags |= NET_TCP_SACK_PERMITTED;
+		}
+	}
 	/*
 	 * If we receive SYN, we send SYN-ACK and go to SYN_RCVD state.
 	 */
@@ -2282,6 +2985,13 @@ NET_CONN_CB(tcp_syn_rcvd)
 			return NET_DROP;
 		}
 
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    tcp_opts.sack_permitted) {
+			tcp->flags |= NET_TCP_SACK_PERMITTED;
+		} else {
+			tcp->flags &= ~NET_TCP_SACK_PERMITTED;
+		}
+
 		net_tcp_change_state(tcp, NET_TCP_SYN_RCVD);
 
 		/* Set TCP seq and ack which are then stored in the backlog */
@@ -2405,6 +3115,10 @@ NET_CONN_CB(tcp_syn_rcvd)
 		 * check the state transitions. So set the state directly.
 		 */
 		new_context->tcp->state = NET_TCP_ESTABLISHED;
+		/* TCP_NODELAY is inherited from the listening socket */
+		new_context->tcp->flags |= context->tcp->flags &
+					   NET_TCP_NODELAY;
+		net_tcp_cc_init(new_context->tcp);
 
 		net_context_set_state(new_context, NET_CONTEXT_CONNECTED);
 
@@ -2570,7 +3284,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	struct net_tcp_hdr *tcp_hdr;
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
-	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+	    net_pkt_need_calc_rx_checksum(pkt) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
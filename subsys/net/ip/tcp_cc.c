@@ -0,0 +1,442 @@
+/** @file
+ * @brief TCP congestion control
+ *
+ * Congestion window handling (RFC 5681), NewReno fast recovery
+ * (RFC 6582) and retransmission timer computation (RFC 6298). The way
+ * the window grows is delegated to a struct net_tcp_cc algorithm,
+ * NewReno or CUBIC (RFC 8312).
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+
+#include <net/net_ip.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Loss recovery states */
+enum {
+	CC_OPEN,
+	/* Fast recovery, entered on the third duplicate ACK */
+	CC_RECOVERY,
+	/* Entered on a retransmission timeout */
+	CC_LOSS,
+};
+
+#define DUP_ACK_THRESHOLD 3
+
+#define RTO_MIN CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT
+#define RTO_MAX K_SECONDS(60)
+
+/* Without window scaling the peer cannot take more than this */
+#define CWND_MAX 0xffff
+
+static inline u32_t flight_size(struct net_tcp *tcp)
+{
+	return tcp->snd_nxt - tcp->snd_una;
+}
+
+/* Slow start with appropriate byte counting, RFC 3465 with L = 1 */
+static inline void slow_start(struct net_tcp *tcp, u32_t bytes)
+{
+	tcp->cwnd += MIN(bytes, tcp->send_mss);
+}
+
+static void newreno_acked(struct net_tcp *tcp, u32_t bytes)
+{
+	if (tcp->cwnd < tcp->ssthresh) {
+		slow_start(tcp, bytes);
+		return;
+	}
+
+	/* Congestion avoidance: one segment per window of data */
+	tcp->bytes_acked += bytes;
+	if (tcp->bytes_acked >= tcp->cwnd) {
+		tcp->bytes_acked -= tcp->cwnd;
+		tcp->cwnd += tcp->send_mss;
+	}
+}
+
+static u32_t newreno_ssthresh(struct net_tcp *tcp)
+{
+	return MAX(flight_size(tcp) / 2U, 2U * tcp->send_mss);
+}
+
+const struct net_tcp_cc net_tcp_cc_newreno = {
+	.name = "newreno",
+	.acked = newreno_acked,
+	.ssthresh = newreno_ssthresh,
+};
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* Multiplicative decrease factor, 0.7 scaled by 1024 */
+#define CUBIC_BETA 717
+
+/* Growth of the standard TCP window estimate, in segments per RTT:
+ * 3 * (1 - beta) / (1 + beta), scaled by 1024
+ */
+#define CUBIC_FRIENDLY 542
+
+static u32_t cubic_root(u64_t x)
+{
+	u64_t y = 0U;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		u64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return y;
+}
+
+static void cubic_init(struct net_tcp *tcp)
+{
+	(void)memset(&tcp->cubic, 0, sizeof(tcp->cubic));
+}
+
+static void cubic_acked(struct net_tcp *tcp, u32_t bytes)
+{
+	u32_t mss = tcp->send_mss;
+	u32_t now = k_uptime_get_32();
+	s64_t target;
+	s64_t t;
+
+	if (tcp->cwnd < tcp->ssthresh) {
+		slow_start(tcp, bytes);
+		return;
+	}
+
+	if (!tcp->cubic.epoch) {
+		tcp->cubic.epoch = now ? now : 1U;
+		tcp->cubic.w_est = tcp->cwnd;
+
+		if (tcp->cwnd < tcp->cubic.w_max) {
+			/* K = cubic_root((w_max - cwnd) / C), with C = 0.4
+			 * segments/s^3 and K in ms
+			 */
+			tcp->cubic.k = cubic_root(
+				(u64_t)(tcp->cubic.w_max - tcp->cwnd) *
+				2500000000ULL / mss);
+			tcp->cubic.origin = tcp->cubic.w_max;
+		} else {
+			tcp->cubic.k = 0U;
+			tcp->cubic.origin = tcp->cwnd;
+		}
+	}
+
+	/* Window one RTT from now: W(t) = C * (t - K)^3 + origin */
+	t = (s64_t)(now - tcp->cubic.epoch + (tcp->srtt >> 3)) -
+		tcp->cubic.k;
+	t = MIN(MAX(t, -(s64_t)RTO_MAX), (s64_t)RTO_MAX);
+
+	target = tcp->cubic.origin + (t * t * t / 1000) * 4 * mss / 10000000;
+
+	/* TCP-friendly region, do not grow slower than standard TCP */
+	tcp->cubic.w_est += (u64_t)bytes * mss * CUBIC_FRIENDLY / 1024U /
+			    tcp->cwnd;
+	if (target < tcp->cubic.w_est) {
+		target = tcp->cubic.w_est;
+	}
+
+	if (target > tcp->cwnd) {
+		u32_t inc = (u64_t)(target - tcp->cwnd) * bytes / tcp->cwnd;
+
+		/* At most 1.5 times the window per RTT */
+		tcp->cwnd += MIN(inc, bytes / 2U);
+	}
+}
+
+static u32_t cubic_ssthresh(struct net_tcp *tcp)
+{
+	u32_t cwnd = tcp->cwnd;
+
+	/* Fast convergence: the window did not get back to where it
+	 * was at the previous loss, leave some room to new flows.
+	 */
+	if (cwnd < tcp->cubic.w_max) {
+		tcp->cubic.w_max = cwnd * (1024U + CUBIC_BETA) / 2048U;
+	} else {
+		tcp->cubic.w_max = cwnd;
+	}
+
+	tcp->cubic.epoch = 0U;
+
+	return MAX(cwnd * CUBIC_BETA / 1024U, 2U * tcp->send_mss);
+}
+
+const struct net_tcp_cc net_tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.acked = cubic_acked,
+	.ssthresh = cubic_ssthresh,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+static void rtt_sample(struct net_tcp *tcp, u32_t rtt)
+{
+	if (!tcp->srtt) {
+		tcp->srtt = rtt << 3;
+		tcp->rttvar = rtt << 1;
+	} else {
+		s32_t delta = rtt - (tcp->srtt >> 3);
+
+		tcp->srtt += delta;
+
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		tcp->rttvar += delta - (tcp->rttvar >> 2);
+	}
+
+	/* RTO = SRTT + max(G, 4 * RTTVAR), with a 1 ms clock */
+	tcp->rto = (tcp->srtt >> 3) + MAX(tcp->rttvar, 1U);
+	tcp->rto = MIN(MAX(tcp->rto, RTO_MIN), RTO_MAX);
+
+	NET_DBG("[%p] rtt %u srtt %u rttvar %u rto %u", tcp, rtt,
+		tcp->srtt >> 3, tcp->rttvar >> 2, tcp->rto);
+}
+
+void net_tcp_cc_init(struct net_tcp *tcp)
+{
+	u32_t mss = tcp->send_mss;
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	tcp->cc = &net_tcp_cc_cubic;
+#else
+	tcp->cc = &net_tcp_cc_newreno;
+#endif
+
+	/* Initial window, RFC 5681 section 3.1 */
+	tcp->cwnd = MIN(4 * mss, MAX(2 * mss, 4380U));
+	tcp->ssthresh = CWND_MAX;
+	tcp->bytes_acked = 0U;
+
+	tcp->snd_una = tcp->send_seq;
+	tcp->snd_nxt = tcp->send_seq;
+	/* The initial send sequence number, RFC 6582 section 3.2 */
+	tcp->recover = tcp->send_seq - 1;
+
+	tcp->send_wnd = NET_TCP_MAX_WIN;
+	tcp->dup_acks = 0U;
+	tcp->cc_state = CC_OPEN;
+	tcp->rtt_active = 0U;
+
+	if (!tcp->rto) {
+		tcp->rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+	}
+
+	if (tcp->cc->init) {
+		tcp->cc->init(tcp);
+	}
+
+	NET_DBG("[%p] %s cwnd %u", tcp, tcp->cc->name, tcp->cwnd);
+}
+
+bool net_tcp_cc_can_send(struct net_tcp *tcp, u32_t len)
+{
+	u32_t flight;
+
+	if (!tcp->cc) {
+		return true;
+	}
+
+	/* Always allow one segment, this also probes a zero window */
+	flight = flight_size(tcp);
+	if (!flight) {
+		return true;
+	}
+
+	return flight + len <= MIN(tcp->cwnd, tcp->send_wnd);
+}
+
+void net_tcp_cc_sent(struct net_tcp *tcp, u32_t seq, u32_t len)
+{
+	if (!tcp->cc || !len) {
+		return;
+	}
+
+	if (net_tcp_seq_greater(seq + len, tcp->snd_nxt)) {
+		tcp->snd_nxt = seq + len;
+	}
+
+	if (!tcp->rtt_active) {
+		tcp->rtt_active = 1U;
+		tcp->rtt_seq = seq + len - 1;
+		tcp->rtt_start = k_uptime_get_32();
+	}
+}
+
+bool net_tcp_cc_recovering(struct net_tcp *tcp)
+{
+	return tcp->cc && tcp->cc_state != CC_OPEN;
+}
+
+void net_tcp_cc_retransmitted(struct net_tcp *tcp)
+{
+	/* Karn's algorithm: ACKs for retransmitted data give no RTT */
+	tcp->rtt_active = 0U;
+}
+
+static bool new_ack(struct net_tcp *tcp, u32_t ack)
+{
+	u32_t acked = ack - tcp->snd_una;
+	bool rexmit = false;
+
+	tcp->snd_una = ack;
+
+	/* The retransmission timer can send data not counted yet */
+	if (net_tcp_seq_greater(ack, tcp->snd_nxt)) {
+		tcp->snd_nxt = ack;
+	}
+
+	if (tcp->rtt_active && net_tcp_seq_greater(ack, tcp->rtt_seq)) {
+		tcp->rtt_active = 0U;
+		rtt_sample(tcp, k_uptime_get_32() - tcp->rtt_start);
+	}
+
+	switch (tcp->cc_state) {
+	case CC_RECOVERY:
+		if (net_tcp_seq_cmp(ack, tcp->recover) >= 0) {
+			/* Full acknowledgment, deflate the window */
+			tcp->cwnd = MIN(tcp->ssthresh,
+					MAX(flight_size(tcp), tcp->send_mss) +
+					tcp->send_mss);
+			tcp->cc_state = CC_OPEN;
+			break;
+		}
+
+		/* Partial acknowledgment: the next hole is lost too.
+		 * Deflate by the amount acked, add back one segment.
+		 */
+		tcp->cwnd -= MIN(acked, tcp->cwnd - tcp->send_mss);
+		if (acked >= tcp->send_mss) {
+			tcp->cwnd += tcp->send_mss;
+		}
+
+		rexmit = true;
+		break;
+
+	case CC_LOSS:
+		/* Go back N after a timeout, segment by segment */
+		if (net_tcp_seq_cmp(ack, tcp->recover) < 0) {
+			rexmit = true;
+		} else {
+			tcp->cc_state = CC_OPEN;
+		}
+
+		tcp->cc->acked(tcp, acked);
+		break;
+
+	default:
+		tcp->cc->acked(tcp, acked);
+		break;
+	}
+
+	tcp->dup_acks = 0U;
+
+	return rexmit;
+}
+
+static bool dup_ack(struct net_tcp *tcp, u32_t ack)
+{
+	if (tcp->cc_state == CC_RECOVERY) {
+		/* Each duplicate ACK means a segment left the network */
+		tcp->cwnd += tcp->send_mss;
+		return false;
+	}
+
+	if (++tcp->dup_acks != DUP_ACK_THRESHOLD) {
+		return false;
+	}
+
+	/* Do not enter fast recovery again for losses of the window that
+	 * was already recovered, RFC 6582 section 3.2 step 2.
+	 */
+	if (!net_tcp_seq_greater(ack, tcp->recover)) {
+		return false;
+	}
+
+	tcp->ssthresh = tcp->cc->ssthresh(tcp);
+	tcp->cwnd = tcp->ssthresh + DUP_ACK_THRESHOLD * tcp->send_mss;
+	tcp->recover = tcp->snd_nxt;
+	tcp->cc_state = CC_RECOVERY;
+
+	NET_DBG("[%p] fast retransmit, ssthresh %u", tcp, tcp->ssthresh);
+
+	return true;
+}
+
+bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u16_t wnd, bool dup)
+{
+	bool rexmit = false;
+
+	if (!tcp->cc) {
+		return false;
+	}
+
+	if (net_tcp_seq_greater(ack, tcp->snd_una)) {
+		rexmit = new_ack(tcp, ack);
+	} else if (dup && ack == tcp->snd_una && wnd == tcp->send_wnd &&
+		   flight_size(tcp)) {
+		rexmit = dup_ack(tcp, ack);
+	} else {
+		tcp->dup_acks = 0U;
+	}
+
+	tcp->send_wnd = wnd;
+	tcp->cwnd = MIN(tcp->cwnd, CWND_MAX);
+
+	return rexmit;
+}
+
+void net_tcp_cc_timeout(struct net_tcp *tcp)
+{
+	if (!tcp->cc) {
+		return;
+	}
+
+	/* Only reduce the threshold once for back to back timeouts */
+	if (tcp->cc_state != CC_LOSS) {
+		tcp->ssthresh = tcp->cc->ssthresh(tcp);
+	}
+
+	tcp->cwnd = tcp->send_mss;
+	tcp->bytes_acked = 0U;
+	tcp->dup_acks = 0U;
+	tcp->recover = tcp->snd_nxt;
+	tcp->cc_state = CC_LOSS;
+	tcp->rtt_active = 0U;
+
+	NET_DBG("[%p] timeout, ssthresh %u", tcp, tcp->ssthresh);
+}
+
+u32_t net_tcp_cc_rto(const struct net_tcp *tcp)
+{
+	u64_t rto = tcp->rto;
+
+	if (!rto) {
+		rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+	}
+
+	/* Back off the timer, RFC 6298 section 5.5 */
+	return MIN(rto << tcp->retry_timeout_shift, RTO_MAX);
+}
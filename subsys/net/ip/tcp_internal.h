@@ -29,7 +29,11 @@ extern "C" {
 /** Is this TCP context/socket used or not */
 #define NET_TCP_IN_USE BIT(0)
 
-/* BIT(1), BIT(2) are unused and available */
+/** Both ends sent the SACK-permitted option */
+#define NET_TCP_SACK_PERMITTED BIT(1)
+
+/** Do not coalesce small writes (TCP_NODELAY) */
+#define NET_TCP_NODELAY BIT(2)
 
 /** Is the socket shutdown for read/write */
 #define NET_TCP_IS_SHUTDOWN BIT(3)
@@ -90,16 +94,25 @@ enum net_tcp_state {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+
+/* SACK blocks that fit in the 40 bytes of options, along with the
+ * option header and its two NOPs
+ */
+#define NET_TCP_SACK_MAX_BLOCKS   4
 
 /** Parsed TCP option values for net_tcp_parse_opts()  */
 struct net_tcp_options {
 	u16_t mss;
+	bool sack_permitted;
 };
 
 /* Max received bytes to buffer internally */
@@ -109,6 +122,40 @@ struct net_tcp_options {
 #define NET_TCP_MAX_SEG_LIFETIME 60
 
 struct net_context;
+struct net_tcp;
+
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+/** Out-of-order segment kept until the data before it arrives */
+struct net_tcp_ooo {
+	/** Segment payload, without the IP and TCP headers */
+	struct net_buf *buf;
+	u32_t seq;
+	u16_t len;
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/** TCP congestion control algorithm */
+struct net_tcp_cc {
+	const char *name;
+
+	/** Reset the algorithm state, called when the connection is
+	 * established. Can be NULL.
+	 */
+	void (*init)(struct net_tcp *tcp);
+
+	/** Grow the congestion window, @a bytes of new data were
+	 * acknowledged outside of loss recovery.
+	 */
+	void (*acked)(struct net_tcp *tcp, u32_t bytes);
+
+	/** A loss was detected, return the new slow start threshold */
+	u32_t (*ssthresh)(struct net_tcp *tcp);
+};
+
+extern const struct net_tcp_cc net_tcp_cc_newreno;
+extern const struct net_tcp_cc net_tcp_cc_cubic;
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
 
 struct net_tcp {
 	/** Network context back pointer. */
@@ -129,6 +176,11 @@ struct net_tcp {
 	/** TIME_WAIT timer */
 	struct k_delayed_work timewait_timer;
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	/** Delayed ACK timer */
+	struct k_delayed_work delack_timer;
+#endif
+
 	/** List pointer used for TCP retransmit buffering */
 	sys_slist_t sent_list;
 
@@ -171,8 +223,82 @@ struct net_tcp {
 	u32_t fin_sent : 1;
 	/* An inbound FIN packet has been received */
 	u32_t fin_rcvd : 1;
+	/* A received data segment has not been acknowledged yet */
+	u32_t ack_pending : 1;
 	/** Remaining bits in this u32_t */
-	u32_t _padding : 13;
+	u32_t _padding : 12;
+
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+	/** Out-of-order segments, sorted by sequence number */
+	struct net_tcp_ooo ooo[CONFIG_NET_TCP_OOO_QUEUE_LEN];
+	/** Number of segments in ooo */
+	u8_t ooo_count;
+	/** Sequence number of the last queued segment, its block comes
+	 * first in SACK options
+	 */
+	u32_t ooo_last_seq;
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/** Congestion control algorithm, NULL until established */
+	const struct net_tcp_cc *cc;
+
+	/** Congestion window and slow start threshold, in bytes */
+	u32_t cwnd;
+	u32_t ssthresh;
+
+	/** Bytes acknowledged since the last congestion avoidance
+	 * increase of cwnd
+	 */
+	u32_t bytes_acked;
+
+	/** Oldest unacknowledged and next new sequence number */
+	u32_t snd_una;
+	u32_t snd_nxt;
+
+	/** snd_nxt when loss recovery was last entered */
+	u32_t recover;
+
+	/** Sequence number whose ACK completes the RTT measurement */
+	u32_t rtt_seq;
+	/** Uptime when the measured segment was sent, in ms */
+	u32_t rtt_start;
+
+	/** Smoothed RTT scaled by 8 and RTT variation scaled by 4,
+	 * in ms, as in RFC 6298
+	 */
+	u32_t srtt;
+	u32_t rttvar;
+
+	/** Current retransmission timeout, in ms */
+	u32_t rto;
+
+	/** Window advertised by the peer */
+	u16_t send_wnd;
+
+	/** Consecutive duplicate ACKs received */
+	u8_t dup_acks;
+
+	/** Loss recovery state */
+	u8_t cc_state : 2;
+	/** An RTT measurement is in progress */
+	u8_t rtt_active : 1;
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	struct {
+		/** Window before the last reduction, in bytes */
+		u32_t w_max;
+		/** Window the cubic function grows back from */
+		u32_t origin;
+		/** Time to reach w_max from origin, in ms */
+		u32_t k;
+		/** Uptime at the start of the current epoch, 0 if none */
+		u32_t epoch;
+		/** Estimated window of standard TCP, in bytes */
+		u32_t w_est;
+	} cubic;
+#endif
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
 };
 
 typedef void (*net_tcp_cb_t)(struct net_tcp *tcp, void *user_data);
@@ -660,6 +786,51 @@ static inline int net_tcp_update_recv_wnd(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Enable or disable coalescing of small writes
+ *
+ * @param context Network context
+ * @param nodelay Send small writes right away, even when sent data is
+ *        waiting to be acknowledged
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context,
+ *         -EPROTONOSUPPORT if TCP is not supported
+ */
+#if defined(CONFIG_NET_TCP)
+int net_tcp_set_nodelay(struct net_context *context, bool nodelay);
+#else
+static inline int net_tcp_set_nodelay(struct net_context *context,
+				      bool nodelay)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(nodelay);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
+/**
+ * @brief Check whether coalescing of small writes is disabled
+ *
+ * @param context Network context
+ * @param nodelay Set to true if TCP_NODELAY is in effect
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context,
+ *         -EPROTONOSUPPORT if TCP is not supported
+ */
+#if defined(CONFIG_NET_TCP)
+int net_tcp_get_nodelay(struct net_context *context, bool *nodelay);
+#else
+static inline int net_tcp_get_nodelay(struct net_context *context,
+				      bool *nodelay)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(nodelay);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Initialize TCP parts of a context
  *
@@ -785,6 +956,195 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Start congestion control on an established connection
+ *
+ * @param tcp TCP context
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+void net_tcp_cc_init(struct net_tcp *tcp);
+#else
+#define net_tcp_cc_init(...)
+#endif
+
+/**
+ * @brief Check whether a new segment can be sent
+ *
+ * @param tcp TCP context
+ * @param len Sequence space used by the segment
+ *
+ * @return True if the segment fits in both the congestion window and
+ * the peer window, or if nothing is in flight
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+bool net_tcp_cc_can_send(struct net_tcp *tcp, u32_t len);
+#else
+static inline bool net_tcp_cc_can_send(struct net_tcp *tcp, u32_t len)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(len);
+
+	return true;
+}
+#endif
+
+/**
+ * @brief Account for a segment sent for the first time
+ *
+ * @param tcp TCP context
+ * @param seq Sequence number of the segment
+ * @param len Sequence space used by the segment
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+void net_tcp_cc_sent(struct net_tcp *tcp, u32_t seq, u32_t len);
+#else
+static inline void net_tcp_cc_sent(struct net_tcp *tcp, u32_t seq, u32_t len)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(seq);
+	ARG_UNUSED(len);
+}
+#endif
+
+/**
+ * @brief Check whether a loss is being recovered from
+ *
+ * @param tcp TCP context
+ *
+ * @return True in fast recovery or after a retransmission timeout,
+ * until all the data outstanding at that time is acknowledged
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+bool net_tcp_cc_recovering(struct net_tcp *tcp);
+#else
+static inline bool net_tcp_cc_recovering(struct net_tcp *tcp)
+{
+	ARG_UNUSED(tcp);
+
+	return false;
+}
+#endif
+
+/**
+ * @brief Account for a retransmitted segment
+ *
+ * @param tcp TCP context
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+void net_tcp_cc_retransmitted(struct net_tcp *tcp);
+#else
+#define net_tcp_cc_retransmitted(...)
+#endif
+
+/**
+ * @brief Update congestion control on a received, valid ACK
+ *
+ * @param tcp TCP context
+ * @param ack Acknowledgment number
+ * @param wnd Window advertised by the peer
+ * @param dup True if the segment can count as a duplicate ACK, i.e. it
+ * carries neither data nor SYN/FIN
+ *
+ * @return True if the first unacknowledged segment must be
+ * retransmitted right away
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u16_t wnd, bool dup);
+#else
+static inline bool net_tcp_cc_ack(struct net_tcp *tcp, u32_t ack,
+				  u16_t wnd, bool dup)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(ack);
+	ARG_UNUSED(wnd);
+	ARG_UNUSED(dup);
+
+	return false;
+}
+#endif
+
+/**
+ * @brief Update congestion control on a retransmission timeout
+ *
+ * @param tcp TCP context
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+void net_tcp_cc_timeout(struct net_tcp *tcp);
+#else
+#define net_tcp_cc_timeout(...)
+#endif
+
+/**
+ * @brief Get the retransmission timeout
+ *
+ * The timeout is doubled for each retransmission of the oldest
+ * unacknowledged segment, as counted by retry_timeout_shift.
+ *
+ * @param tcp TCP context
+ *
+ * @return Timeout in milliseconds
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+u32_t net_tcp_cc_rto(const struct net_tcp *tcp);
+#else
+static inline u32_t net_tcp_cc_rto(const struct net_tcp *tcp)
+{
+	return ((u32_t)1 << tcp->retry_timeout_shift) *
+		CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
+}
+#endif
+
+/**
+ * @brief Get the segment size of a TCP packet carrying more than one MSS
+ *
+ * @param tcp TCP context
+ * @param iface Network interface the packet is sent on
+ * @param len Amount of data to send
+ *
+ * The packet stays a single entry of the retransmission queue, so it
+ * is retransmitted as a whole even if only one of its segments was
+ * lost.  With congestion control, it is therefore limited to what the
+ * congestion and peer windows allow, and no such packet is built while
+ * recovering from a loss.
+ *
+ * @return Amount of data per segment, to be set with
+ * net_pkt_set_gso_size(), or 0 if len is to be sent in packets of a
+ * single segment
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+u16_t net_tcp_gso_size(struct net_tcp *tcp, struct net_if *iface,
+		       size_t len);
+#else
+static inline u16_t net_tcp_gso_size(struct net_tcp *tcp,
+				     struct net_if *iface, size_t len)
+{
+	ARG_UNUSED(tcp);
+	ARG_UNUSED(iface);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Send a TCP packet carrying more than one MSS as MSS sized
+ * segments
+ *
+ * This is the software fallback for the L2 drivers that cannot segment
+ * such packets themselves. The segments are new packets, with a copy of
+ * the IP and TCP headers, and pkt is left unchanged.
+ *
+ * @param pkt Packet with a non zero net_pkt_gso_size()
+ * @param send Function sending a segment, which takes the ownership of
+ * the segment unless it returns a negative errno
+ *
+ * @return Number of bytes sent, negative errno otherwise
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_pkt *pkt,
+		     int (*send)(struct net_if *iface, struct net_pkt *pkt));
+#endif
+
 #if defined(CONFIG_NET_TCP)
 void net_tcp_init(void);
 #else
@@ -149,7 +149,7 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 	struct net_udp_hdr *udp_hdr;
 
 	if (IS_ENABLED(CONFIG_NET_UDP_CHECKSUM) &&
-	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+	    net_pkt_need_calc_rx_checksum(pkt) &&
 	    net_calc_chksum_udp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -400,32 +400,91 @@ int net_addr_pton(sa_family_t family, const char *src,
 	return 0;
 }
 
-static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+/* Fold a sum of 16-bit words into a 16-bit ones' complement sum */
+static inline u16_t chksum_fold(u64_t acc)
 {
-	const u8_t *end;
-	u16_t tmp;
+	u32_t sum;
 
-	end = data + len - 1;
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	sum = (u32_t)acc + (u32_t)(acc >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	return sum;
+}
+
+/* Ones' complement sum of data taken as 16-bit words in native byte
+ * order, starting from a 16-bit aligned address. Aligned 32-bit words
+ * are added to a 64-bit accumulator, so that carries only need to be
+ * handled once at the end, and the main loop is unrolled four times.
+ */
+static u16_t chksum_aligned(const u8_t *data, size_t len)
+{
+	u64_t acc = 0U;
 
+	if (len >= 2 && ((uintptr_t)data & 2)) {
+		acc += *(const u16_t *)data;
 		data += 2;
+		len -= 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 16) {
+		const u32_t *p = (const u32_t *)data;
+
+		acc += p[0];
+		acc += p[1];
+		acc += p[2];
+		acc += p[3];
+		data += 16;
+		len -= 16;
 	}
 
-	return sum;
+	while (len >= 4) {
+		acc += *(const u32_t *)data;
+		data += 4;
+		len -= 4;
+	}
+
+	if (len >= 2) {
+		acc += *(const u16_t *)data;
+		data += 2;
+		len -= 2;
+	}
+
+	/* Odd trailing byte, padded with a zero byte */
+	if (len) {
+		acc += ntohs((u16_t)(data[0] << 8));
+	}
+
+	return chksum_fold(acc);
+}
+
+static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+{
+	u32_t acc;
+	u16_t tmp;
+
+	if (!len) {
+		return sum;
+	}
+
+	if ((uintptr_t)data & 1) {
+		/* Sum the rest from the next, aligned, byte. Its words
+		 * straddle the ones of data, which is compensated by
+		 * swapping the result.
+		 */
+		tmp = chksum_aligned(data + 1, len - 1);
+		acc = ntohs((u16_t)(data[0] << 8)) +
+			(u16_t)((tmp << 8) | (tmp >> 8));
+		tmp = chksum_fold(acc);
+	} else {
+		tmp = chksum_aligned(data, len);
+	}
+
+	/* The sum is kept in host byte order */
+	acc = sum + ntohs(tmp);
+
+	return chksum_fold(acc);
 }
 
 static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
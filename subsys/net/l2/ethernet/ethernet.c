@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
@@ -425,16 +426,33 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 					    struct net_pkt *pkt,
 					    u32_t ptype)
 {
+	bool vlan = IS_ENABLED(CONFIG_NET_VLAN) &&
+		    net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt));
+	size_t hdr_len = vlan ? sizeof(struct net_eth_vlan_hdr) :
+				sizeof(struct net_eth_hdr);
 	struct net_buf *hdr_frag;
 	struct net_eth_hdr *hdr;
 
-	hdr_frag = net_pkt_get_frag(pkt, NET_BUF_TIMEOUT);
-	if (!hdr_frag) {
-		return NULL;
+	/* The header goes in front of the data if room was reserved
+	 * there when the packet was allocated, and the first buffer is
+	 * not shared with another packet.
+	 */
+	hdr_frag = pkt->buffer;
+	if (hdr_frag && hdr_frag->ref == 1U &&
+	    net_buf_headroom(hdr_frag) >= hdr_len) {
+		net_buf_push(hdr_frag, hdr_len);
+		net_pkt_set_l2_hdr_pushed(pkt, true);
+	} else {
+		hdr_frag = net_pkt_get_frag(pkt, NET_BUF_TIMEOUT);
+		if (!hdr_frag) {
+			return NULL;
+		}
+
+		net_buf_add(hdr_frag, hdr_len);
+		net_pkt_set_l2_hdr_pushed(pkt, false);
 	}
 
-	if (IS_ENABLED(CONFIG_NET_VLAN) &&
-	    net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt))) {
+	if (vlan) {
 		struct net_eth_vlan_hdr *hdr_vlan;
 
 		hdr_vlan = (struct net_eth_vlan_hdr *)(hdr_frag->data);
@@ -451,11 +469,10 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 		hdr_vlan->type = ptype;
 		hdr_vlan->vlan.tpid = htons(NET_ETH_PTYPE_VLAN);
 		hdr_vlan->vlan.tci = htons(net_pkt_vlan_tci(pkt));
-		net_buf_add(hdr_frag, sizeof(struct net_eth_vlan_hdr));
 
 		print_vlan_ll_addrs(pkt, ntohs(hdr_vlan->type),
 				    net_pkt_vlan_tci(pkt),
-				    hdr_frag->len,
+				    hdr_len,
 				    &hdr_vlan->src, &hdr_vlan->dst);
 	} else {
 		hdr = (struct net_eth_hdr *)(hdr_frag->data);
@@ -470,13 +487,14 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 		       sizeof(struct net_eth_addr));
 
 		hdr->type = ptype;
-		net_buf_add(hdr_frag, sizeof(struct net_eth_hdr));
 
 		print_ll_addrs(pkt, ntohs(hdr->type),
-			       hdr_frag->len, &hdr->src, &hdr->dst);
+			       hdr_len, &hdr->src, &hdr->dst);
 	}
 
-	net_pkt_frag_insert(pkt, hdr_frag);
+	if (!net_pkt_is_l2_hdr_pushed(pkt)) {
+		net_pkt_frag_insert(pkt, hdr_frag);
+	}
 
 	return hdr_frag;
 }
@@ -501,6 +519,18 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 {
 	struct net_buf *buf;
 
+	if (net_pkt_is_l2_hdr_pushed(pkt)) {
+		struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+
+		/* Give the headroom used by ethernet_fill_header() back */
+		net_buf_pull(pkt->buffer,
+			     hdr->type == htons(NET_ETH_PTYPE_VLAN) ?
+			     sizeof(struct net_eth_vlan_hdr) :
+			     sizeof(struct net_eth_hdr));
+		net_pkt_set_l2_hdr_pushed(pkt, false);
+		return;
+	}
+
 	/* Remove the buffer added in ethernet_fill_header() */
 	buf = pkt->buffer;
 	pkt->buffer = buf->frags;
@@ -509,6 +539,113 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+#if CONFIG_NET_ETHERNET_TX_BURST_SIZE > 0
+/* For drivers that can send bursts, ethernet_send() stages the packets
+ * once their header is set.  A work item queued behind the first staged
+ * packet in the TX queue then hands over everything that was staged in
+ * the meantime, so a burst covers the packets that were queued back to
+ * back for transmission.  A packet of a higher traffic class than the
+ * queue holding the work item is not left waiting behind it: the burst
+ * is handed over right away instead.
+ */
+
+/* Called with the burst lock held */
+static int tx_burst_take(struct ethernet_context *ctx, struct net_pkt **pkts)
+{
+	int count = ctx->tx_burst.count;
+
+	memcpy(pkts, ctx->tx_burst.pkts, count * sizeof(pkts[0]));
+	ctx->tx_burst.count = 0;
+
+	return count;
+}
+
+static void tx_burst_send(struct net_pkt **pkts, int count)
+{
+	struct device *dev = net_if_get_device(net_pkt_iface(pkts[0]));
+	const struct ethernet_api *api = dev->driver_api;
+	int sent, i;
+
+	sent = api->send_burst(dev, pkts, count);
+
+	for (i = 0; i < count; i++) {
+		struct net_if *iface = net_pkt_iface(pkts[i]);
+
+		if (i < sent) {
+#if defined(CONFIG_NET_STATISTICS_ETHERNET)
+			ethernet_update_tx_stats(iface, pkts[i]);
+#endif
+		} else {
+			eth_stats_update_errors_tx(iface);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_TCP)) {
+			net_pkt_set_queued(pkts[i], false);
+		}
+
+		ethernet_remove_l2_header(pkts[i]);
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+static void tx_burst_flush(struct k_work *work)
+{
+	struct ethernet_context *ctx =
+		CONTAINER_OF(work, struct ethernet_context, tx_burst.work);
+	struct net_pkt *pkts[CONFIG_NET_ETHERNET_TX_BURST_SIZE];
+	k_spinlock_key_t key;
+	int count;
+
+	key = k_spin_lock(&ctx->tx_burst.lock);
+	count = tx_burst_take(ctx, pkts);
+	k_spin_unlock(&ctx->tx_burst.lock, key);
+
+	if (count > 0) {
+		tx_burst_send(pkts, count);
+	}
+}
+
+static void tx_burst_stage(struct ethernet_context *ctx, struct net_pkt *pkt)
+{
+	struct net_pkt *pkts[CONFIG_NET_ETHERNET_TX_BURST_SIZE];
+	u8_t tc = net_tx_priority2tc(net_pkt_priority(pkt));
+	bool submit = false;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	/* Keep TCP from resending the packet until the driver has it */
+	if (IS_ENABLED(CONFIG_NET_TCP) && net_pkt_family(pkt) != AF_UNSPEC) {
+		net_pkt_set_queued(pkt, true);
+	}
+
+	key = k_spin_lock(&ctx->tx_burst.lock);
+
+	/* A work item still pending from an earlier burst will flush
+	 * this one too, from the queue it is in.
+	 */
+	if (ctx->tx_burst.count == 0 &&
+	    !k_work_pending(&ctx->tx_burst.work)) {
+		ctx->tx_burst.tc = tc;
+		submit = true;
+	}
+
+	ctx->tx_burst.pkts[ctx->tx_burst.count++] = pkt;
+
+	if (ctx->tx_burst.count == CONFIG_NET_ETHERNET_TX_BURST_SIZE ||
+	    tc > ctx->tx_burst.tc) {
+		count = tx_burst_take(ctx, pkts);
+	}
+
+	k_spin_unlock(&ctx->tx_burst.lock, key);
+
+	if (count > 0) {
+		tx_burst_send(pkts, count);
+	} else if (submit) {
+		net_tc_submit_work_to_tx_queue(tc, &ctx->tx_burst.work);
+	}
+}
+#endif /* CONFIG_NET_ETHERNET_TX_BURST_SIZE > 0 */
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->driver_api;
@@ -516,6 +653,19 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	u16_t ptype;
 	int ret;
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Cut the packet in segments unless the hardware does it */
+	if (net_pkt_gso_size(pkt) &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		ret = net_tcp_gso_send(pkt, ethernet_send);
+		if (ret >= 0) {
+			net_pkt_unref(pkt);
+		}
+
+		return ret;
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
 		struct net_pkt *tmp;
@@ -583,6 +733,14 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	net_pkt_cursor_init(pkt);
 
 send:
+#if CONFIG_NET_ETHERNET_TX_BURST_SIZE > 0
+	if (api->send_burst) {
+		ret = net_pkt_get_len(pkt);
+		tx_burst_stage(ctx, pkt);
+		return ret;
+	}
+#endif
+
 	ret = api->send(net_if_get_device(iface), pkt);
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
@@ -972,6 +1130,12 @@ void ethernet_init(struct net_if *iface)
 
 	ctx->ethernet_l2_flags = NET_L2_MULTICAST;
 
+#if CONFIG_NET_ETHERNET_TX_BURST_SIZE > 0
+	if (!ctx->is_init) {
+		k_work_init(&ctx->tx_burst.work, tx_burst_flush);
+	}
+#endif
+
 	if (net_eth_get_hw_capabilities(iface) & ETHERNET_PROMISC_MODE) {
 		ctx->ethernet_l2_flags |= NET_L2_PROMISC_MODE;
 	}
@@ -178,6 +178,7 @@ int zsock_close_ctx(struct net_context *ctx)
 	}
 
 	zsock_flush_queue(ctx);
+	zsock_epoll_forget(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
 
@@ -242,6 +243,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		k_fifo_init(&new_ctx->recv_q);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_epoll_notify(parent);
 	}
 }
 
@@ -271,6 +273,8 @@ static void zsock_received_cb(struct net_context *ctx,
 			net_pkt_set_eof(last_pkt, true);
 			NET_DBG("Set EOF flag on pkt %p", last_pkt);
 		}
+
+		zsock_epoll_notify(ctx);
 		return;
 	}
 
@@ -282,6 +286,7 @@ static void zsock_received_cb(struct net_context *ctx,
 	}
 
 	k_fifo_put(&ctx->recv_q, pkt);
+	zsock_epoll_notify(ctx);
 }
 
 int zsock_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -801,6 +806,103 @@ ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 	VTABLE_CALL(recvfrom, sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static ssize_t zsock_recv_pkt_stream(struct net_context *ctx,
+				     struct net_pkt **pkt, s32_t timeout)
+{
+	size_t len;
+
+	do {
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		*pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (*pkt == NULL) {
+			/* Either timeout expired, or wait was cancelled
+			 * due to connection closure by peer.
+			 */
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		if (net_pkt_eof(*pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		/* Whatever zsock_recv() left of a partially read packet */
+		len = net_pkt_remaining_data(*pkt);
+		if (len == 0) {
+			net_pkt_unref(*pkt);
+			*pkt = NULL;
+		}
+	} while (len == 0);
+
+	net_context_update_recv_wnd(ctx, len);
+
+	return len;
+}
+
+ssize_t zsock_recv_pkt_ctx(struct net_context *ctx, struct net_pkt **pkt,
+			   int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	s32_t timeout = K_FOREVER;
+
+	*pkt = NULL;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (!net_context_is_used(ctx)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		return zsock_recv_pkt_stream(ctx, pkt, timeout);
+	}
+
+	*pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (*pkt == NULL) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return net_pkt_remaining_data(*pkt);
+}
+
+ssize_t zsock_recv_pkt(int sock, struct net_pkt **pkt, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = get_sock_vtable(sock, &vtable);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->recv_pkt == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return vtable->recv_pkt(ctx, pkt, flags);
+}
+
+void zsock_recv_pkt_release(struct net_pkt *pkt)
+{
+	net_pkt_unref(pkt);
+}
+
 #ifdef CONFIG_USERSPACE
 Z_SYSCALL_HANDLER(zsock_recvfrom, sock, buf, max_len, flags, src_addr,
 		  addrlen_param)
@@ -1100,6 +1202,35 @@ Z_SYSCALL_HANDLER(zsock_inet_pton, family, src, dst)
 int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 void *optval, socklen_t *optlen)
 {
+	int ret;
+
+	switch (level) {
+	case IPPROTO_TCP:
+		switch (optname) {
+		case TCP_NODELAY: {
+			bool nodelay;
+
+			if (*optlen < sizeof(int)) {
+				errno = EINVAL;
+				return -1;
+			}
+
+			ret = net_context_get_option(ctx, NET_OPT_TCP_NODELAY,
+						     &nodelay, NULL);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			*(int *)optval = nodelay;
+			*optlen = sizeof(int);
+
+			return 0;
+		}
+		}
+		break;
+	}
+
 	errno = ENOPROTOOPT;
 	return -1;
 }
@@ -1126,12 +1257,27 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 	case IPPROTO_TCP:
 		switch (optname) {
-		case TCP_NODELAY:
-			/* Ignore for now. Provided to let port
-			 * existing apps.
-			 */
+		case TCP_NODELAY: {
+			bool nodelay;
+			int ret;
+
+			if (optlen < sizeof(int)) {
+				errno = EINVAL;
+				return -1;
+			}
+
+			nodelay = *(int *)optval != 0;
+
+			ret = net_context_set_option(ctx, NET_OPT_TCP_NODELAY,
+						     &nodelay, sizeof(nodelay));
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
 			return 0;
 		}
+		}
 		break;
 
 	case IPPROTO_IPV6:
@@ -1216,6 +1362,9 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return zsock_poll_update_ctx(obj, pfd, pev);
 	}
 
+	case ZFD_IOCTL_EPOLL_SUPPORTED:
+		return 0;
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -1260,6 +1409,12 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recv_pkt_vmeth(void *obj, struct net_pkt **pkt,
+				   int flags)
+{
+	return zsock_recv_pkt_ctx(obj, pkt, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -1285,6 +1440,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recv_pkt = sock_recv_pkt_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 };
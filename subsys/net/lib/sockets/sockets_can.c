@@ -108,6 +108,7 @@ static void zcan_received_cb(struct net_context *ctx, struct net_pkt *pkt,
 	net_pkt_set_eof(pkt, false);
 
 	k_fifo_put(&ctx->recv_q, pkt);
+	zsock_epoll_notify(ctx);
 }
 
 static int zcan_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Socket interest sets.  Each registered socket has an entry pointed to
+ * by its net_context; the socket receive callbacks put the entry on its
+ * set's ready list and raise the set's poll signal.  Waiting then only
+ * has to look at the ready list, which is rechecked on every wait to
+ * implement level-triggered semantics.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <misc/dlist.h>
+#include <misc/fdtable.h>
+#include <net/net_context.h>
+#include <net/socket.h>
+#include <syscall_handler.h>
+
+#include "sockets_internal.h"
+
+struct zsock_epoll;
+
+struct zsock_epoll_entry {
+	/* Node in the set's ready list */
+	sys_dnode_t node;
+	struct zsock_epoll *ep;
+	/* Registered socket, NULL if the entry is free */
+	struct net_context *ctx;
+	u32_t events;
+	union zsock_epoll_data data;
+	bool ready;
+};
+
+struct zsock_epoll {
+	bool in_use;
+	sys_dlist_t ready;
+	struct k_poll_signal signal;
+	struct zsock_epoll_entry entries[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+};
+
+static struct zsock_epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+/* Protects all sets, entries and the net_context epoll pointers */
+static struct k_spinlock lock;
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static u32_t entry_revents(struct zsock_epoll_entry *entry)
+{
+	struct net_context *ctx = entry->ctx;
+	u32_t revents = 0U;
+
+	/* recv_q is also the accept queue of listening sockets */
+	if ((entry->events & ZSOCK_POLLIN) &&
+	    (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx))) {
+		revents |= ZSOCK_POLLIN;
+	}
+
+	/* As for zsock_poll(), assume that sockets are always writable */
+	if (entry->events & ZSOCK_POLLOUT) {
+		revents |= ZSOCK_POLLOUT;
+	}
+
+	return revents;
+}
+
+/* Queues entry if it is ready, returning the signal to raise once the
+ * lock is released
+ */
+static struct k_poll_signal *entry_check(struct zsock_epoll_entry *entry)
+{
+	if (entry_revents(entry) == 0U) {
+		return NULL;
+	}
+
+	if (!entry->ready) {
+		sys_dlist_append(&entry->ep->ready, &entry->node);
+		entry->ready = true;
+	}
+
+	return &entry->ep->signal;
+}
+
+static void entry_release(struct zsock_epoll_entry *entry)
+{
+	if (entry->ready) {
+		sys_dlist_remove(&entry->node);
+		entry->ready = false;
+	}
+
+	entry->ctx->epoll = NULL;
+	entry->ctx = NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct k_poll_signal *signal = NULL;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (ctx->epoll != NULL) {
+		signal = entry_check(ctx->epoll);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, 0);
+	}
+}
+
+void zsock_epoll_forget(struct net_context *ctx)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (ctx->epoll != NULL) {
+		entry_release(ctx->epoll);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int z_impl_zsock_epoll_create(void)
+{
+	struct zsock_epoll *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->ready);
+	k_poll_signal_init(&ep->signal);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER0_SIMPLE(zsock_epoll_create);
+#endif /* CONFIG_USERSPACE */
+
+static struct zsock_epoll_entry *entry_alloc(struct zsock_epoll *ep)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if (ep->entries[i].ctx == NULL) {
+			return &ep->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct k_poll_signal *signal = NULL;
+	const struct fd_op_vtable *vtable;
+	struct zsock_epoll_entry *entry;
+	struct net_context *ctx;
+	struct zsock_epoll *ep;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* Only sockets whose readiness is their net_context receive
+	 * queue can be registered
+	 */
+	if (z_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_EPOLL_SUPPORTED) < 0) {
+		errno = EPERM;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	key = k_spin_lock(&lock);
+
+	entry = ctx->epoll;
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (entry != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		entry = entry_alloc(ep);
+		if (entry == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		entry->ep = ep;
+		entry->ctx = ctx;
+		entry->ready = false;
+		ctx->epoll = entry;
+
+		entry->events = event->events;
+		entry->data = event->data;
+		signal = entry_check(entry);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (entry == NULL || entry->ep != ep) {
+			ret = -ENOENT;
+			break;
+		}
+
+		entry->events = event->events;
+		entry->data = event->data;
+		signal = entry_check(entry);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (entry == NULL || entry->ep != ep) {
+			ret = -ENOENT;
+			break;
+		}
+
+		entry_release(entry);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, 0);
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_epoll_ctl, epfd, op, fd, event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != 0U) {
+		Z_OOPS(z_user_from_copy(&event_copy, (void *)event,
+					sizeof(event_copy)));
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd,
+				      event != 0U ? &event_copy : NULL);
+}
+#endif /* CONFIG_USERSPACE */
+
+/* Reports up to maxevents ready entries.  Entries that are still ready
+ * go back to the tail of the ready list, behind the ones that did not
+ * fit, so that no socket is starved.
+ */
+static int epoll_collect(struct zsock_epoll *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct zsock_epoll_entry *entry, *next;
+	k_spinlock_key_t key;
+	sys_dlist_t reported;
+	sys_dnode_t *dn;
+	int n = 0;
+
+	sys_dlist_init(&reported);
+
+	key = k_spin_lock(&lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, entry, next, node) {
+		u32_t revents;
+
+		if (n == maxevents) {
+			break;
+		}
+
+		sys_dlist_remove(&entry->node);
+
+		revents = entry_revents(entry);
+		if (revents == 0U) {
+			entry->ready = false;
+			continue;
+		}
+
+		events[n].events = revents;
+		events[n].data = entry->data;
+		n++;
+
+		sys_dlist_append(&reported, &entry->node);
+	}
+
+	while ((dn = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&ep->ready, dn);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return n;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	u32_t entry_time = k_uptime_get_32();
+	struct k_poll_event event;
+	struct zsock_epoll *ep;
+	int n;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		timeout = K_FOREVER;
+	}
+
+	while (true) {
+		s32_t remaining = timeout;
+
+		/* Reset before looking, so that a socket becoming ready
+		 * past this point wakes the k_poll() below up
+		 */
+		k_poll_signal_reset(&ep->signal);
+
+		n = epoll_collect(ep, events, maxevents);
+		if (n > 0 || timeout == K_NO_WAIT) {
+			return n;
+		}
+
+		if (timeout != K_FOREVER) {
+			remaining = timeout - (k_uptime_get_32() - entry_time);
+			if (remaining <= 0) {
+				return 0;
+			}
+		}
+
+		k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+		if (k_poll(&event, 1, remaining) == -EAGAIN) {
+			return 0;
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_epoll_wait, epfd, events, maxevents, timeout)
+{
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+					    sizeof(struct zsock_epoll_event)));
+
+	return z_impl_zsock_epoll_wait(epfd, (struct zsock_epoll_event *)events,
+				       maxevents, timeout);
+}
+#endif /* CONFIG_USERSPACE */
+
+static int epoll_close(struct zsock_epoll *ep)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->entries); i++) {
+		if (ep->entries[i].ctx != NULL) {
+			entry_release(&ep->entries[i]);
+		}
+	}
+
+	ep->in_use = false;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_CLOSE:
+		return epoll_close(obj);
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
@@ -41,12 +41,30 @@ struct socket_op_vtable {
 			  const struct sockaddr *dest_addr, socklen_t addrlen);
 	ssize_t (*recvfrom)(void *obj, void *buf, size_t max_len, int flags,
 			    struct sockaddr *src_addr, socklen_t *addrlen);
+	/* Optional, for sockets whose data sits in net_pkts */
+	ssize_t (*recv_pkt)(void *obj, struct net_pkt **pkt, int flags);
 	int (*getsockopt)(void *obj, int level, int optname,
 			  void *optval, socklen_t *optlen);
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 };
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Called when ctx may have become ready, and when it is closed */
+void zsock_epoll_notify(struct net_context *ctx);
+void zsock_epoll_forget(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void zsock_epoll_forget(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif
+
 int ztls_socket(int family, int type, int proto);
 
 int zpacket_socket(int family, int type, int proto);
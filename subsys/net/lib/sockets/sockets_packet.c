@@ -112,6 +112,7 @@ static void zpacket_received_cb(struct net_context *ctx,
 	net_pkt_set_eof(pkt, false);
 
 	k_fifo_put(&ctx->recv_q, pkt);
+	zsock_epoll_notify(ctx);
 }
 
 static int zpacket_bind_ctx(struct net_context *ctx,
@@ -230,6 +231,34 @@ ssize_t zpacket_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return recv_len;
 }
 
+ssize_t zpacket_recv_pkt_ctx(struct net_context *ctx, struct net_pkt **pkt,
+			     int flags)
+{
+	s32_t timeout = K_FOREVER;
+
+	*pkt = NULL;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	*pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (*pkt == NULL) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Like recvfrom(), hand out the whole packet, headers included */
+	net_pkt_cursor_init(*pkt);
+
+	return net_pkt_get_len(*pkt);
+}
+
 int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			   void *optval, socklen_t *optlen)
 {
@@ -314,6 +343,12 @@ static ssize_t packet_sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				    src_addr, addrlen);
 }
 
+static ssize_t packet_sock_recv_pkt_vmeth(void *obj, struct net_pkt **pkt,
+					  int flags)
+{
+	return zpacket_recv_pkt_ctx(obj, pkt, flags);
+}
+
 static int packet_sock_getsockopt_vmeth(void *obj, int level, int optname,
 					void *optval, socklen_t *optlen)
 {
@@ -338,6 +373,7 @@ static const struct socket_op_vtable packet_sock_fd_op_vtable = {
 	.accept = packet_sock_accept_vmeth,
 	.sendto = packet_sock_sendto_vmeth,
 	.recvfrom = packet_sock_recvfrom_vmeth,
+	.recv_pkt = packet_sock_recv_pkt_vmeth,
 	.getsockopt = packet_sock_getsockopt_vmeth,
 	.setsockopt = packet_sock_setsockopt_vmeth,
 };
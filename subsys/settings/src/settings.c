@@ -19,6 +19,9 @@ LOG_MODULE_REGISTER(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
 sys_slist_t settings_handlers;
 
+/* Registered handlers, by hash of their name */
+static sys_slist_t settings_handler_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+
 static u8_t settings_cmd_inited;
 
 static struct settings_handler *settings_handler_lookup(char *name);
@@ -28,18 +31,37 @@ void settings_init(void)
 {
 	if (!settings_cmd_inited) {
 		sys_slist_init(&settings_handlers);
+		for (int i = 0; i < ARRAY_SIZE(settings_handler_index); i++) {
+			sys_slist_init(&settings_handler_index[i]);
+		}
 		settings_store_init();
 
 		settings_cmd_inited = 1U;
 	}
 }
 
+/*
+ * Bucket of the handler index for a subtree name (djb2 hash).
+ */
+static sys_slist_t *settings_handler_bucket(const char *name)
+{
+	u32_t hash = 5381U;
+
+	while (*name != '\0') {
+		hash = hash * 33U + (u8_t)*name++;
+	}
+
+	return &settings_handler_index[hash % CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+}
+
 int settings_register(struct settings_handler *handler)
 {
 	if (settings_handler_lookup(handler->name)) {
 		return -EEXIST;
 	}
 	sys_slist_prepend(&settings_handlers, &handler->node);
+	sys_slist_prepend(settings_handler_bucket(handler->name),
+			  &handler->index_node);
 
 	return 0;
 }
@@ -51,7 +73,8 @@ static struct settings_handler *settings_handler_lookup(char *name)
 {
 	struct settings_handler *ch;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(settings_handler_bucket(name), ch,
+				     index_node) {
 		if (!strcmp(name, ch->name)) {
 			return ch;
 		}
@@ -19,12 +19,13 @@ LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
 #define SETTINGS_FCB_VERS		1
 
 struct settings_fcb_load_cb_arg {
+	const char *subtree;
 	load_cb cb;
 	void *cb_arg;
 };
 
-static int settings_fcb_load(struct settings_store *cs, load_cb cb,
-			     void *cb_arg);
+static int settings_fcb_load(struct settings_store *cs, const char *subtree,
+			     load_cb cb, void *cb_arg);
 static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 
@@ -89,6 +90,14 @@ static int settings_fcb_load_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
 
 	size_t len_read;
 
+	if (argp->subtree) {
+		rc = settings_line_name_in_subtree(argp->subtree,
+						   (void *)&entry_ctx->loc);
+		if (rc <= 0) {
+			return 0;
+		}
+	}
+
 	rc = settings_line_name_read(buf, sizeof(buf), &len_read,
 				     (void *)&entry_ctx->loc);
 	if (rc) {
@@ -102,13 +111,14 @@ static int settings_fcb_load_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
 	return 0;
 }
 
-static int settings_fcb_load(struct settings_store *cs, load_cb cb,
-			     void *cb_arg)
+static int settings_fcb_load(struct settings_store *cs, const char *subtree,
+			     load_cb cb, void *cb_arg)
 {
 	struct settings_fcb *cf = (struct settings_fcb *)cs;
 	struct settings_fcb_load_cb_arg arg;
 	int rc;
 
+	arg.subtree = subtree;
 	arg.cb = cb;
 	arg.cb_arg = cb_arg;
 	rc = fcb_walk(&cf->cf_fcb, 0, settings_fcb_load_cb, &arg);
@@ -14,8 +14,8 @@
 #include "settings/settings_file.h"
 #include "settings_priv.h"
 
-static int settings_file_load(struct settings_store *cs, load_cb cb,
-			      void *cb_arg);
+static int settings_file_load(struct settings_store *cs, const char *subtree,
+			      load_cb cb, void *cb_arg);
 static int settings_file_save(struct settings_store *cs, const char *name,
 			      const char *value, size_t val_len);
 
@@ -53,8 +53,8 @@ int settings_file_dst(struct settings_file *cf)
  * Called to load configuration items. cb must be called for every configuration
  * item found.
  */
-static int settings_file_load(struct settings_store *cs, load_cb cb,
-			      void *cb_arg)
+static int settings_file_load(struct settings_store *cs, const char *subtree,
+			      load_cb cb, void *cb_arg)
 {
 	struct settings_file *cf = (struct settings_file *)cs;
 	char buf[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
@@ -90,6 +90,19 @@ static int settings_file_load(struct settings_store *cs, load_cb cb,
 			break;
 		}
 
+		if (subtree) {
+			rc = settings_line_name_in_subtree(subtree,
+							   (void *)&entry_ctx);
+			if (rc < 0) {
+				break;
+			}
+			if (rc == 0) {
+				/* not loaded, but still counts for compression */
+				lines++;
+				continue;
+			}
+		}
+
 		rc = settings_line_name_read(buf, sizeof(buf), &len_read,
 					     (void *)&entry_ctx);
 
@@ -410,6 +410,39 @@ int settings_line_name_read(char *out, size_t len_req, size_t *len_read,
 					    &until_char, cb_arg);
 }
 
+int settings_line_name_in_subtree(const char *subtree, void *cb_arg)
+{
+	char buf[16];
+	size_t rem, len, len_read;
+	off_t off = 0;
+	int rc;
+
+	/* compare the name with the subtree a chunk at a time, so that
+	 * records of other subtrees are rejected after a single read
+	 */
+	for (rem = strlen(subtree); rem > 0; rem -= len) {
+		len = MIN(sizeof(buf), rem);
+		rc = settings_line_raw_read(off, buf, len, &len_read, cb_arg);
+		if (rc) {
+			return rc;
+		}
+
+		if (len_read != len || memcmp(buf, &subtree[off], len)) {
+			return 0;
+		}
+		off += len;
+	}
+
+	/* the subtree must be followed by the end of the name or a separator */
+	rc = settings_line_raw_read(off, buf, 1, &len_read, cb_arg);
+	if (rc) {
+		return rc;
+	}
+
+	return len_read == 1 &&
+	       (buf[0] == '=' || buf[0] == *SETTINGS_NAME_SEPARATOR);
+}
+
 
 int settings_entry_copy(void *dst_ctx, off_t dst_off, void *src_ctx,
 			off_t src_off, size_t len)
@@ -85,6 +85,21 @@ int settings_line_val_read(off_t val_off, off_t off, char *out, size_t len_req,
 int settings_line_name_read(char *out, size_t len_req, size_t *len_read,
 			    void *cb_arg);
 
+/**
+ * Check whether the settings line entry name belongs to a subtree, reading
+ * no more of it than needed.
+ *
+ * @param[in] subtree name of the subtree
+ * @param[in] cb_arg settings line storage context expected by the
+ * <p>read_cb</p> implementation
+ *
+ * @retval 1 if the name is <p>subtree</p>, or starts with <p>subtree</p>
+ * followed by the name separator,
+ * 0 if it does not,
+ * -ERCODE on storage errors
+ */
+int settings_line_name_in_subtree(const char *subtree, void *cb_arg);
+
 size_t settings_line_val_get_len(off_t val_off, void *read_cb_ctx);
 
 int settings_entry_copy(void *dst_ctx, off_t dst_off, void *src_ctx,
@@ -107,7 +122,11 @@ typedef void (*load_cb)(char *name, void *val_read_cb_ctx, off_t off,
 			void *cb_arg);
 
 struct settings_store_itf {
-	int (*csi_load)(struct settings_store *cs, load_cb cb, void *cb_arg);
+	/* Call cb for the stored items, or only the ones of subtree if it is
+	 * not NULL (see settings_line_name_in_subtree())
+	 */
+	int (*csi_load)(struct settings_store *cs, const char *subtree,
+			load_cb cb, void *cb_arg);
 	int (*csi_save_start)(struct settings_store *cs);
 	int (*csi_save)(struct settings_store *cs, const char *name,
 			const char *value, size_t val_len);
@@ -74,11 +74,28 @@ int settings_load(void)
 	 */
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
-		cs->cs_itf->csi_load(cs, settings_load_cb, NULL);
+		cs->cs_itf->csi_load(cs, NULL, settings_load_cb, NULL);
 	}
 	return settings_commit(NULL);
 }
 
+int settings_load_subtree(const char *subtree)
+{
+	struct settings_store *cs;
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+
+	/* settings_commit() splits the name in place */
+	if (strlen(subtree) >= sizeof(name)) {
+		return -EINVAL;
+	}
+	strcpy(name, subtree);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
+		cs->cs_itf->csi_load(cs, subtree, settings_load_cb, NULL);
+	}
+	return settings_commit(name);
+}
+
 /* val_off - offset of value-string within line entries */
 static int settings_cmp(char const *val, size_t val_len, void *val_read_cb_ctx,
 		 off_t val_off)
@@ -163,7 +180,7 @@ int settings_save_one(const char *name, void *value, size_t val_len)
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
-	cs->cs_itf->csi_load(cs, settings_dup_check_cb, &cdca);
+	cs->cs_itf->csi_load(cs, name, settings_dup_check_cb, &cdca);
 	if (cdca.is_dup == 1) {
 		return 0;
 	}
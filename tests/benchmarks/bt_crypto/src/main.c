@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <misc/printk.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/crypto.h>
+#include <bluetooth/mesh.h>
+
+#include "common/rpa.h"
+#include "crypto.h"
+
+/* Cost of AES based cryptography with reused keys.  See README.rst. */
+
+#define ROUNDS 64
+#define IRK_COUNT 4
+#define MESH_MAX_LEN 380
+#define MESH_MIC_LEN 4
+#define SRC 0x0001
+#define DST 0x0100
+
+static const u16_t mesh_lens[] = { 11, 96, MESH_MAX_LEN };
+
+static const u8_t app_key[16] = { 0x63, 0x96, 0x47, 0x71, 0x73, 0x4f,
+				  0xbd, 0x76, 0xe3, 0xb4, 0x05, 0x19,
+				  0xd1, 0xd9, 0x4a, 0x48 };
+
+static const u8_t tk[16];
+
+static u8_t irks[IRK_COUNT][16];
+
+static u32_t run_mesh(u16_t len)
+{
+	static const u8_t payload[MESH_MAX_LEN];
+	NET_BUF_SIMPLE_DEFINE(buf, MESH_MAX_LEN + MESH_MIC_LEN);
+	NET_BUF_SIMPLE_DEFINE(out, MESH_MAX_LEN);
+	u32_t start;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		net_buf_simple_reset(&buf);
+		net_buf_simple_add_mem(&buf, payload, len);
+
+		if (bt_mesh_app_encrypt(app_key, false, 0, &buf, NULL, SRC,
+					DST, i, 0)) {
+			printk("Cannot encrypt message %d\n", i);
+			return 0;
+		}
+
+		buf.len -= MESH_MIC_LEN;
+		net_buf_simple_reset(&out);
+
+		if (bt_mesh_app_decrypt(app_key, false, 0, &buf, &out, NULL,
+					SRC, DST, i, 0)) {
+			printk("Cannot decrypt message %d\n", i);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static int legacy_pairing(void)
+{
+	u8_t data[16] = { 0 };
+	int err, i;
+
+	/* Two confirm values of two blocks each, then the STK */
+	for (i = 0; i < 5; i++) {
+		err = bt_encrypt_le(tk, data, data);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static u32_t run_legacy(void)
+{
+	u32_t start;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		if (legacy_pairing()) {
+			printk("Cannot run legacy pairing %d\n", i);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+static u32_t run_rpa(void)
+{
+	bt_addr_t rpa = { .val = { 0, 0, 0, 0x56, 0x34, 0x52 } };
+	u8_t hash[16] = { 0x56, 0x34, 0x52 };
+	u32_t start;
+	int i, j;
+
+	/* bt_rpa_create() needs the random numbers of an enabled stack */
+	if (bt_encrypt_le(irks[IRK_COUNT - 1], hash, hash)) {
+		printk("Cannot create RPA\n");
+		return 0;
+	}
+
+	memcpy(rpa.val, hash, 3);
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		for (j = 0; j < IRK_COUNT; j++) {
+			if (bt_rpa_irk_matches(irks[j], &rpa)) {
+				break;
+			}
+		}
+
+		if (j != IRK_COUNT - 1) {
+			printk("RPA resolved with IRK %d\n", j);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+void main(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(mesh_lens); i++) {
+		printk("mesh %3u bytes %7u cycles/msg\n", mesh_lens[i],
+		       run_mesh(mesh_lens[i]));
+	}
+
+	for (i = 0; i < IRK_COUNT; i++) {
+		(void)memset(irks[i], i + 1, sizeof(irks[i]));
+	}
+
+	printk("smp legacy %6u cycles rpa %6u cycles\n", run_legacy(),
+	       run_rpa());
+
+	printk("fin\n");
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/uuid.h>
+#include <bluetooth/gatt.h>
+
+/* Cost of GATT handle lookups as the database grows.  See README.rst. */
+
+#define SVC_COUNT 24
+#define SVCS_PER_STEP 4
+#define ATTRS_PER_SVC 10
+
+static struct bt_uuid_16 primary_uuid = BT_UUID_INIT_16(0x2800);
+static struct bt_uuid_16 svc_uuid = BT_UUID_INIT_16(0xfff0);
+static struct bt_uuid_16 value_uuid = BT_UUID_INIT_16(0xfff1);
+
+static struct bt_gatt_attr attrs[SVC_COUNT][ATTRS_PER_SVC];
+static struct bt_gatt_service svcs[SVC_COUNT];
+
+static ssize_t read_value(struct bt_conn *conn,
+			  const struct bt_gatt_attr *attr, void *buf,
+			  u16_t len, u16_t offset)
+{
+	return 0;
+}
+
+static void init_service(int i)
+{
+	int j;
+
+	attrs[i][0].uuid = &primary_uuid.uuid;
+	attrs[i][0].perm = BT_GATT_PERM_READ;
+	attrs[i][0].read = bt_gatt_attr_read_service;
+	attrs[i][0].user_data = &svc_uuid;
+
+	for (j = 1; j < ATTRS_PER_SVC; j++) {
+		attrs[i][j].uuid = &value_uuid.uuid;
+		attrs[i][j].perm = BT_GATT_PERM_READ;
+		attrs[i][j].read = read_value;
+	}
+
+	svcs[i].attrs = attrs[i];
+	svcs[i].attr_count = ATTRS_PER_SVC;
+}
+
+static u8_t found(const struct bt_gatt_attr *attr, void *user_data)
+{
+	const struct bt_gatt_attr **result = user_data;
+
+	*result = attr;
+
+	return BT_GATT_ITER_STOP;
+}
+
+static u16_t last_handle(int svc_count)
+{
+	return attrs[svc_count - 1][ATTRS_PER_SVC - 1].handle;
+}
+
+static u32_t run_read(u16_t last)
+{
+	const struct bt_gatt_attr *attr;
+	u32_t start;
+	u16_t handle;
+
+	start = k_cycle_get_32();
+
+	for (handle = 1U; handle <= last; handle++) {
+		attr = NULL;
+		bt_gatt_foreach_attr(handle, handle, found, &attr);
+		if (!attr) {
+			printk("Handle 0x%04x not found\n", handle);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / last;
+}
+
+static u32_t run_next(int svc_count)
+{
+	u32_t start;
+	int i, j;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < svc_count; i++) {
+		for (j = 0; j < ATTRS_PER_SVC - 1; j++) {
+			if (bt_gatt_attr_next(&attrs[i][j]) != &attrs[i][j + 1]) {
+				printk("Wrong attribute after 0x%04x\n",
+				       attrs[i][j].handle);
+				return 0;
+			}
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (svc_count * (ATTRS_PER_SVC - 1));
+}
+
+void main(void)
+{
+	int i;
+
+	for (i = 0; i < SVC_COUNT; i++) {
+		init_service(i);
+
+		if (bt_gatt_service_register(&svcs[i]) < 0) {
+			printk("Cannot register service %d\n", i);
+			return;
+		}
+
+		if ((i + 1) % SVCS_PER_STEP) {
+			continue;
+		}
+
+		printk("attrs %4u read %6u cycles next %6u cycles\n",
+		       last_handle(i + 1), run_read(last_handle(i + 1)),
+		       run_next(i + 1));
+	}
+
+	printk("fin\n");
+}
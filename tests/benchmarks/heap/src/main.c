@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <misc/mempool.h>
+#include <misc/tlsf.h>
+
+/* Heap allocator benchmark: fragmentation and alloc/free cost of
+ * sys_mem_pool versus the TLSF heap.  See README.rst.
+ */
+
+#define ARENA_SIZE (4 * 4096)
+#define MAX_ALLOC 600
+#define MAX_BLOCKS 512
+#define WORKING_SET 48
+#define CHURN_OPS 20000
+
+SYS_MEM_POOL_DEFINE(bench_mempool, NULL, 16, 4096, 4, 4, .data);
+SYS_TLSF_POOL_DEFINE(bench_tlsf, ARENA_SIZE, .data);
+
+struct heap_ops {
+	const char *name;
+	void (*init)(void);
+	void *(*alloc)(size_t size);
+	void (*free)(void *ptr);
+};
+
+static void mempool_init(void)
+{
+	sys_mem_pool_init(&bench_mempool);
+}
+
+static void *mempool_alloc(size_t size)
+{
+	return sys_mem_pool_alloc(&bench_mempool, size);
+}
+
+static void mempool_free(void *ptr)
+{
+	sys_mem_pool_free(ptr);
+}
+
+static void tlsf_init(void)
+{
+	sys_tlsf_pool_init(&bench_tlsf);
+}
+
+static void *tlsf_alloc(size_t size)
+{
+	return sys_tlsf_pool_alloc(&bench_tlsf, size);
+}
+
+static void tlsf_free(void *ptr)
+{
+	sys_tlsf_pool_free(&bench_tlsf, ptr);
+}
+
+static const struct heap_ops heaps[] = {
+	{ "mempool", mempool_init, mempool_alloc, mempool_free },
+	{ "tlsf   ", tlsf_init, tlsf_alloc, tlsf_free },
+};
+
+static void *blocks[MAX_BLOCKS];
+static u32_t seed;
+
+/* Same sequence on every platform, unlike sys_rand32_get() */
+static u32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+	return seed >> 8;
+}
+
+static size_t rand_size(void)
+{
+	return 1 + next_rand() % MAX_ALLOC;
+}
+
+static void fill(const struct heap_ops *h)
+{
+	size_t bytes = 0;
+	int n;
+
+	seed = 1U;
+	for (n = 0; n < MAX_BLOCKS; n++) {
+		size_t size = rand_size();
+
+		blocks[n] = h->alloc(size);
+		if (blocks[n] == NULL) {
+			break;
+		}
+		bytes += size;
+	}
+
+	printk("%s fill  %4d blocks %6u bytes (%u%% of arena)\n", h->name,
+	       n, (u32_t)bytes, (u32_t)(bytes * 100 / ARENA_SIZE));
+
+	while (n-- > 0) {
+		h->free(blocks[n]);
+	}
+}
+
+static void churn(const struct heap_ops *h)
+{
+	u32_t start, cycles, fails = 0U;
+
+	seed = 2U;
+	for (int i = 0; i < WORKING_SET; i++) {
+		blocks[i] = h->alloc(rand_size());
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CHURN_OPS; i++) {
+		int slot = next_rand() % WORKING_SET;
+
+		h->free(blocks[slot]);
+		blocks[slot] = h->alloc(rand_size());
+		if (blocks[slot] == NULL) {
+			fails++;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	printk("%s churn %6u cycles/op %6u failed\n", h->name,
+	       cycles / CHURN_OPS, fails);
+
+	for (int i = 0; i < WORKING_SET; i++) {
+		h->free(blocks[i]);
+	}
+}
+
+void main(void)
+{
+	printk("arena %u bytes, allocations of 1..%u bytes\n",
+	       ARENA_SIZE, MAX_ALLOC);
+
+	for (int i = 0; i < ARRAY_SIZE(heaps); i++) {
+		heaps[i].init();
+		fill(&heaps[i]);
+		churn(&heaps[i]);
+	}
+
+	printk("fin\n");
+}
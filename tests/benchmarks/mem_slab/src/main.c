@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <stats.h>
+
+/* Memory slab throughput benchmark: 1..CONFIG_MP_NUM_CPUS threads
+ * allocate and free bursts of blocks from one slab for RUN_MS
+ * milliseconds each.  See README.rst.
+ */
+
+#define MAX_THREADS CONFIG_MP_NUM_CPUS
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define PRIO 5
+#define BURST 4
+#define BLK_SIZE 64
+#define NUM_BLOCKS (MAX_THREADS * (BURST + 8))
+
+K_MEM_SLAB_DEFINE(bench_slab, BLK_SIZE, NUM_BLOCKS, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static u32_t counts[MAX_THREADS];
+static volatile bool running;
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	u32_t *count = p1;
+	void *blocks[BURST];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		for (int i = 0; i < BURST; i++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[i],
+					     K_FOREVER) != 0) {
+				printk("alloc failed\n");
+				return;
+			}
+		}
+
+		for (int i = 0; i < BURST; i++) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+
+		*count += BURST;
+	}
+}
+
+static void run(int nthreads)
+{
+	u32_t total = 0U;
+
+	running = true;
+
+	for (int i = 0; i < nthreads; i++) {
+		counts[i] = 0U;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				worker, &counts[i], NULL, NULL,
+				PRIO, 0, K_NO_WAIT);
+	}
+
+	k_sleep(RUN_MS);
+	running = false;
+
+	/* Let the workers finish their last burst */
+	k_sleep(10);
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_abort(&threads[i]);
+		total += counts[i];
+	}
+
+	printk("threads %2d ops %8u per_ms %6u\n", nthreads, total,
+	       total / RUN_MS);
+}
+
+#if defined(CONFIG_MEM_SLAB_MAGAZINE) && defined(CONFIG_STATS_NAMES)
+static int print_stat(struct stats_hdr *hdr, void *arg, const char *name,
+		      u16_t off)
+{
+	ARG_UNUSED(arg);
+
+	printk("  %s: %u\n", name, *(u32_t *)((u8_t *)hdr + off));
+	return 0;
+}
+
+static void print_mag_stats(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		char name[sizeof("slab_mag255")];
+		struct stats_hdr *hdr;
+
+		snprintk(name, sizeof(name), "slab_mag%d", i);
+		hdr = stats_group_find(name);
+		if (hdr != NULL) {
+			printk("%s:\n", name);
+			stats_walk(hdr, print_stat, NULL);
+		}
+	}
+}
+#else
+static void print_mag_stats(void) { }
+#endif
+
+void main(void)
+{
+	printk("CPUs: %d, magazines: %s\n", CONFIG_MP_NUM_CPUS,
+	       IS_ENABLED(CONFIG_MEM_SLAB_MAGAZINE) ? "yes" : "no");
+
+	/* Main must outrank the workers to stop them reliably */
+	k_thread_priority_set(k_current_get(), PRIO - 1);
+
+	for (int n = 1; n <= MAX_THREADS; n++) {
+		run(n);
+	}
+
+	print_mag_stats();
+	printk("fin\n");
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/mesh.h>
+
+#include "net.h"
+#include "access.h"
+
+/* Cost of dispatching access messages to models as the composition
+ * data grows.  See README.rst.
+ */
+
+#define ROUNDS 256
+#define ELEM_COUNT 16
+#define ELEM_STEP 4
+#define MODEL_COUNT 4
+#define OP_COUNT 4
+#define ADDR 0x0001
+#define GROUP 0xc000
+#define APP_IDX 0x0000
+
+#define OP(m, o) BT_MESH_MODEL_OP_2(0x82, 0x40 + (m) * OP_COUNT + (o))
+#define LAST_OP OP(MODEL_COUNT - 1, OP_COUNT - 1)
+
+static u32_t received;
+
+static void handle(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		   struct net_buf_simple *buf)
+{
+	received++;
+}
+
+#define MODEL_OPS(m)				\
+	{					\
+		{ OP(m, 0), 0, handle },	\
+		{ OP(m, 1), 0, handle },	\
+		{ OP(m, 2), 0, handle },	\
+		{ OP(m, 3), 0, handle },	\
+		BT_MESH_MODEL_OP_END,		\
+	}
+
+static const struct bt_mesh_model_op model_ops[MODEL_COUNT][OP_COUNT + 1] = {
+	MODEL_OPS(0), MODEL_OPS(1), MODEL_OPS(2), MODEL_OPS(3),
+};
+
+static struct bt_mesh_model models[ELEM_COUNT][MODEL_COUNT] = {
+	[0 ... (ELEM_COUNT - 1)] = {
+		BT_MESH_MODEL(0x1000, model_ops[0], NULL, NULL),
+		BT_MESH_MODEL(0x1001, model_ops[1], NULL, NULL),
+		BT_MESH_MODEL(0x1002, model_ops[2], NULL, NULL),
+		BT_MESH_MODEL(0x1003, model_ops[3], NULL, NULL),
+	},
+};
+
+#define ELEM(i) BT_MESH_ELEM(i, models[i], BT_MESH_MODEL_NONE)
+
+static struct bt_mesh_elem elements[ELEM_COUNT] = {
+	ELEM(0), ELEM(1), ELEM(2), ELEM(3), ELEM(4), ELEM(5), ELEM(6),
+	ELEM(7), ELEM(8), ELEM(9), ELEM(10), ELEM(11), ELEM(12), ELEM(13),
+	ELEM(14), ELEM(15),
+};
+
+static struct bt_mesh_comp comp = {
+	.elem = elements,
+};
+
+static int setup(int elem_count)
+{
+	int err, i, j;
+
+	comp.elem_count = elem_count;
+
+	err = bt_mesh_comp_register(&comp);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_comp_provision(ADDR);
+
+	for (i = 0; i < elem_count; i++) {
+		for (j = 0; j < MODEL_COUNT; j++) {
+			models[i][j].keys[0] = APP_IDX;
+		}
+	}
+
+	return 0;
+}
+
+static u32_t run(u16_t dst)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, 2);
+	struct bt_mesh_net_rx rx = {
+		.ctx = {
+			.app_idx = APP_IDX,
+			.addr = 0x0100,
+			.recv_dst = dst,
+		},
+	};
+	u32_t start;
+	int i;
+
+	received = 0U;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		net_buf_simple_reset(&buf);
+		net_buf_simple_add_be16(&buf, LAST_OP);
+
+		bt_mesh_model_recv(&rx, &buf);
+	}
+
+	if (received != ROUNDS) {
+		printk("%u messages received out of %u\n", received, ROUNDS);
+		return 0;
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+void main(void)
+{
+	struct bt_mesh_model *last;
+	u32_t unicast, group;
+	int err, i;
+
+	for (i = ELEM_STEP; i <= ELEM_COUNT; i += ELEM_STEP) {
+		err = setup(i);
+		if (err) {
+			printk("Cannot register %d elements (err %d)\n", i, err);
+			return;
+		}
+
+		last = &models[i - 1][MODEL_COUNT - 1];
+
+		unicast = run(ADDR + i - 1);
+
+		last->groups[0] = GROUP;
+		group = run(GROUP);
+		last->groups[0] = BT_MESH_ADDR_UNASSIGNED;
+
+		printk("elems %3u unicast %6u cycles group %6u cycles\n", i,
+		       unicast, group);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <misc/printk.h>
+#include <misc/byteorder.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/mesh.h>
+
+#include "crypto.h"
+#include "net.h"
+
+/* Cost of decoding network PDUs when several network keys share the
+ * same NID.  See README.rst.
+ */
+
+#define ROUNDS 64
+#define SRC 0x0100
+#define DST 0x0001
+#define PDU_LEN 29
+
+#define TARGET (CONFIG_BT_MESH_SUBNET_COUNT - 1)
+
+static struct bt_mesh_cfg_srv cfg_srv = {
+	.default_ttl = 7,
+};
+
+static struct bt_mesh_model models[] = {
+	BT_MESH_MODEL_CFG_SRV(&cfg_srv),
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static const u8_t dev_uuid[16] = { 0xdd, 0xdd };
+
+static const struct bt_mesh_prov prov = {
+	.uuid = dev_uuid,
+};
+
+static struct {
+	u8_t data[PDU_LEN];
+	u8_t len;
+} pdus[ROUNDS];
+
+/* Looks for a network key, starting from key, with the given NID */
+static int find_key(u8_t key[16], u8_t nid)
+{
+	u8_t p[] = { 0 };
+	u8_t enc[16], priv[16];
+	u8_t key_nid;
+	int err;
+
+	for (;;) {
+		err = bt_mesh_k2(key, p, sizeof(p), &key_nid, enc, priv);
+		if (err) {
+			return err;
+		}
+
+		if (key_nid == nid) {
+			return 0;
+		}
+
+		sys_put_be32(sys_get_be32(key) + 1, key);
+	}
+}
+
+static int setup_subnets(void)
+{
+	u8_t key[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+	u8_t nid;
+	int err, i;
+
+	err = bt_mesh_net_keys_create(&bt_mesh.sub[TARGET].keys[0], key);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh.sub[TARGET].net_idx = TARGET;
+	nid = bt_mesh.sub[TARGET].keys[0].nid;
+
+	/* Decoys stay disabled until their net_idx is set */
+	for (i = 0; i < TARGET; i++) {
+		sys_put_be32(sys_get_be32(key) + 1, key);
+
+		err = find_key(key, nid);
+		if (err) {
+			return err;
+		}
+
+		err = bt_mesh_net_keys_create(&bt_mesh.sub[i].keys[0], key);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int encode(int i)
+{
+	static const u8_t payload[] = { 0x00, 0x82, 0x01, 0x00, 0x00,
+					0x00, 0x00, 0x00, 0x00 };
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = TARGET,
+		.app_idx = BT_MESH_KEY_DEV,
+		.addr = DST,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = &bt_mesh.sub[TARGET],
+		.ctx = &ctx,
+		.src = SRC + i,
+	};
+	int err;
+
+	net_buf_simple_reserve(&buf, BT_MESH_NET_HDR_LEN);
+	net_buf_simple_add_mem(&buf, payload, sizeof(payload));
+
+	err = bt_mesh_net_encode(&tx, &buf, false);
+	if (err) {
+		return err;
+	}
+
+	memcpy(pdus[i].data, buf.data, buf.len);
+	pdus[i].len = buf.len;
+
+	return 0;
+}
+
+static u32_t run(void)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_net_rx rx;
+	u32_t start;
+	int i;
+
+	for (i = 0; i < ROUNDS; i++) {
+		if (encode(i)) {
+			printk("Cannot encode PDU %d\n", i);
+			return 0;
+		}
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		struct net_buf_simple data = {
+			.data = pdus[i].data,
+			.len = pdus[i].len,
+			.size = sizeof(pdus[i].data),
+			.__buf = pdus[i].data,
+		};
+
+		(void)memset(&rx, 0, sizeof(rx));
+
+		if (bt_mesh_net_decode(&data, BT_MESH_NET_IF_ADV, &rx, &buf) ||
+		    rx.sub != &bt_mesh.sub[TARGET]) {
+			printk("Cannot decode PDU %d\n", i);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+void main(void)
+{
+	int err, i;
+
+	err = bt_mesh_init(&prov, &comp);
+	if (err) {
+		printk("Cannot initialize mesh (err %d)\n", err);
+		return;
+	}
+
+	err = setup_subnets();
+	if (err) {
+		printk("Cannot set subnets up (err %d)\n", err);
+		return;
+	}
+
+	for (i = 0; i <= TARGET; i++) {
+		if (i > 0) {
+			bt_mesh.sub[i - 1].net_idx = i - 1;
+		}
+
+		printk("attempts %2u cycles/pdu %7u\n", i + 1, run());
+	}
+
+	printk("fin\n");
+}
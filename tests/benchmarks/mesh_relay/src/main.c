@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <misc/printk.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/mesh.h>
+
+#include "net.h"
+#include "transport.h"
+
+/* Cost of the duplicate and replay checks of a relay node as the number
+ * of sources grows.  See README.rst.
+ */
+
+#define SRC_COUNT 256
+#define SRC_STEP 32
+#define SRC_BASE 0x0100
+#define DST 0x0001
+#define PDU_LEN 29
+
+static struct bt_mesh_cfg_srv cfg_srv = {
+	.relay = BT_MESH_RELAY_ENABLED,
+	.default_ttl = 7,
+};
+
+static struct bt_mesh_model models[] = {
+	BT_MESH_MODEL_CFG_SRV(&cfg_srv),
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static const u8_t dev_uuid[16] = { 0xdd, 0xdd };
+
+static const struct bt_mesh_prov prov = {
+	.uuid = dev_uuid,
+};
+
+static const u8_t net_key[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+				  0xcd, 0xef, 0x01, 0x23, 0x45, 0x67,
+				  0x89, 0xab, 0xcd, 0xef };
+
+/* Network PDU of each source, as received over the air */
+static struct {
+	u8_t data[PDU_LEN];
+	u8_t len;
+} pdus[SRC_COUNT];
+
+/* Network PDU of each source, as passed to the transport layer */
+static struct {
+	struct bt_mesh_net_rx rx;
+	u8_t data[PDU_LEN];
+	u8_t len;
+} decoded[SRC_COUNT];
+
+static int encode(int i)
+{
+	static const u8_t payload[] = { 0x00, 0x82, 0x01, 0x00, 0x00,
+					0x00, 0x00, 0x00, 0x00 };
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = 0,
+		.app_idx = BT_MESH_KEY_DEV,
+		.addr = DST,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = &bt_mesh.sub[0],
+		.ctx = &ctx,
+		.src = SRC_BASE + i,
+	};
+	int err;
+
+	net_buf_simple_reserve(&buf, BT_MESH_NET_HDR_LEN);
+	net_buf_simple_add_mem(&buf, payload, sizeof(payload));
+
+	err = bt_mesh_net_encode(&tx, &buf, false);
+	if (err) {
+		return err;
+	}
+
+	memcpy(pdus[i].data, buf.data, buf.len);
+	pdus[i].len = buf.len;
+
+	return 0;
+}
+
+static int decode(int i, struct bt_mesh_net_rx *rx,
+		  struct net_buf_simple *buf)
+{
+	struct net_buf_simple data = {
+		.data = pdus[i].data,
+		.len = pdus[i].len,
+		.size = sizeof(pdus[i].data),
+		.__buf = pdus[i].data,
+	};
+
+	(void)memset(rx, 0, sizeof(*rx));
+
+	return bt_mesh_net_decode(&data, BT_MESH_NET_IF_ADV, rx, buf);
+}
+
+static int trans_recv(int i)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_net_rx rx = decoded[i].rx;
+
+	net_buf_simple_add_mem(&buf, decoded[i].data, decoded[i].len);
+
+	return bt_mesh_trans_recv(&buf, &rx);
+}
+
+static int add_source(int i)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	int err;
+
+	err = encode(i);
+	if (err) {
+		return err;
+	}
+
+	err = decode(i, &decoded[i].rx, &buf);
+	if (err) {
+		return err;
+	}
+
+	decoded[i].rx.local_match = 1U;
+	memcpy(decoded[i].data, buf.data, buf.len);
+	decoded[i].len = buf.len;
+
+	/* Only adds the source to the replay protection list, the access
+	 * payload is not meant to be decrypted.
+	 */
+	(void)trans_recv(i);
+
+	return 0;
+}
+
+static u32_t run_cache(int count)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_net_rx rx;
+	u32_t start;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < count; i++) {
+		if (decode(i, &rx, &buf) != -EALREADY) {
+			printk("Message %d not in the cache\n", i);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / count;
+}
+
+static u32_t run_rpl(int count)
+{
+	u32_t start;
+	int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < count; i++) {
+		if (trans_recv(i) != -EINVAL) {
+			printk("Message %d not detected as replay\n", i);
+			return 0;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / count;
+}
+
+void main(void)
+{
+	int err, i;
+
+	err = bt_mesh_init(&prov, &comp);
+	if (err) {
+		printk("Cannot initialize mesh (err %d)\n", err);
+		return;
+	}
+
+	/* Only the network keys are needed, not the whole provisioning */
+	err = bt_mesh_net_create(0, 0, net_key, 0);
+	if (err) {
+		printk("Cannot create network (err %d)\n", err);
+		return;
+	}
+
+	for (i = 0; i < SRC_COUNT; i++) {
+		err = add_source(i);
+		if (err) {
+			printk("Cannot add source %d (err %d)\n", i, err);
+			return;
+		}
+
+		if ((i + 1) % SRC_STEP) {
+			continue;
+		}
+
+		printk("sources %4u cache %6u cycles rpl %6u cycles\n", i + 1,
+		       run_cache(i + 1), run_rpl(i + 1));
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+#include "connection.h"
+#include "udp_internal.h"
+
+/* Cost of finding the handler of received UDP packets with many
+ * registered connections.  See README.rst.
+ */
+
+#define CONNS 128
+#define ROUNDS 1000
+#define LOCAL_PORT 5000
+#define LISTEN_PORT 6000
+#define PEER_PORT 7000
+
+static struct net_conn_handle *handles[CONNS + 1];
+static u32_t delivered;
+
+static struct {
+	struct net_ipv4_hdr ipv4;
+	struct net_udp_hdr udp;
+} __packed hdr;
+
+static enum net_verdict conn_cb(struct net_conn *conn,
+				struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	/* Keep the packet, it is fed again in the next round */
+	delivered++;
+
+	return NET_OK;
+}
+
+static int register_conns(int count)
+{
+	struct sockaddr_in local = { .sin_family = AF_INET };
+	struct sockaddr_in peer = { .sin_family = AF_INET };
+	int i, ret;
+
+	net_ipaddr_copy(&local.sin_addr, &hdr.ipv4.dst);
+	net_ipaddr_copy(&peer.sin_addr, &hdr.ipv4.src);
+
+	for (i = 0; i < count; i++) {
+		ret = net_udp_register(AF_INET, (struct sockaddr *)&peer,
+				       (struct sockaddr *)&local,
+				       PEER_PORT + i, LOCAL_PORT,
+				       conn_cb, NULL, &handles[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return net_udp_register(AF_INET, NULL, (struct sockaddr *)&local,
+				0, LISTEN_PORT, conn_cb, NULL,
+				&handles[count]);
+}
+
+static void unregister_conns(int count)
+{
+	for (int i = 0; i <= count; i++) {
+		net_udp_unregister(handles[i]);
+	}
+}
+
+static u32_t run(struct net_pkt *pkt, u16_t src_port, u16_t dst_port)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &hdr.ipv4 };
+	union net_proto_header proto_hdr = { .udp = &hdr.udp };
+	u32_t start;
+
+	hdr.udp.src_port = htons(src_port);
+	hdr.udp.dst_port = htons(dst_port);
+
+	delivered = 0U;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	if (delivered != ROUNDS) {
+		printk("%u packets out of %u delivered\n", delivered, ROUNDS);
+	}
+
+	return (k_cycle_get_32() - start) / ROUNDS;
+}
+
+void main(void)
+{
+	static const int counts[] = { 8, 32, CONNS };
+	struct net_pkt *pkt;
+
+	hdr.ipv4.vhl = 0x45;
+	hdr.ipv4.proto = IPPROTO_UDP;
+	net_addr_pton(AF_INET, "192.0.2.2", &hdr.ipv4.src);
+	net_addr_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &hdr.ipv4.dst);
+
+	/* Handlers do not look at the packet data, only the headers
+	 * passed alongside matter
+	 */
+	pkt = net_pkt_rx_alloc(K_NO_WAIT);
+	if (!pkt) {
+		printk("Cannot allocate packet\n");
+		return;
+	}
+
+	net_pkt_set_iface(pkt, net_if_get_default());
+	net_pkt_set_family(pkt, AF_INET);
+
+	for (int c = 0; c < ARRAY_SIZE(counts); c++) {
+		u32_t connected, listener;
+		int ret;
+
+		ret = register_conns(counts[c]);
+		if (ret < 0) {
+			printk("Cannot register handlers (%d)\n", ret);
+			return;
+		}
+
+		connected = run(pkt, PEER_PORT + counts[c] - 1, LOCAL_PORT);
+		listener = run(pkt, PEER_PORT, LISTEN_PORT);
+
+		printk("conns %3d connected %6u cycles listener %6u cycles\n",
+		       counts[c], connected, listener);
+
+		unregister_conns(counts[c]);
+	}
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+}
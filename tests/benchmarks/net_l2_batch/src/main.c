@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/net_core.h>
+#include <net/net_context.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/ethernet.h>
+
+/* Packet rate between an Ethernet driver and the stack, with packets
+ * handed over one at a time or in bursts.  See README.rst.
+ */
+
+#define ROUNDS 2048
+#define BURST 8
+#define PORT 4242
+#define PAYLOAD 64
+
+struct bench_eth_context {
+	struct net_if *iface;
+	u8_t mac_addr[6];
+};
+
+static struct bench_eth_context eth_context = {
+	.mac_addr = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static u32_t tx_pkts;
+static u32_t tx_calls;
+static u32_t tx_target;
+static K_SEM_DEFINE(tx_done, 0, 1);
+
+static u32_t rx_pkts;
+static K_SEM_DEFINE(rx_done, 0, 1);
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+/* Ethernet, IPv6 and UDP headers followed by the payload */
+static u8_t frame[14 + 40 + 8 + PAYLOAD];
+
+static void tx_account(int count)
+{
+	tx_calls++;
+	tx_pkts += count;
+
+	if (tx_pkts == tx_target) {
+		k_sem_give(&tx_done);
+	}
+}
+
+static int bench_eth_send(struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	tx_account(1);
+
+	return 0;
+}
+
+static int bench_eth_send_burst(struct device *dev, struct net_pkt **pkts,
+				int count)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkts);
+
+	tx_account(count);
+
+	return count;
+}
+
+static enum ethernet_hw_caps bench_eth_caps(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	/* Keeps checksums out of the measurement */
+	return ETHERNET_HW_TX_CHKSUM_OFFLOAD | ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static void bench_eth_iface_init(struct net_if *iface)
+{
+	struct bench_eth_context *ctx = net_if_get_device(iface)->driver_data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int bench_eth_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct ethernet_api bench_eth_api = {
+	.iface_api.init = bench_eth_iface_init,
+	.get_capabilities = bench_eth_caps,
+	.send = bench_eth_send,
+	.send_burst = bench_eth_send_burst,
+};
+
+ETH_NET_DEVICE_INIT(bench_eth, "bench_eth", bench_eth_init, &eth_context,
+		    NULL, CONFIG_ETH_INIT_PRIORITY, &bench_eth_api,
+		    NET_ETH_MTU);
+
+static void build_frame(void)
+{
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)frame;
+	struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)(eth + 1);
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)(ip + 1);
+
+	memcpy(&eth->dst, eth_context.mac_addr, sizeof(eth->dst));
+	memcpy(&eth->src, eth_context.mac_addr, sizeof(eth->src));
+	eth->src.addr[5]++;
+	eth->type = htons(NET_ETH_PTYPE_IPV6);
+
+	ip->vtc = 0x60;
+	ip->len = htons(sizeof(*udp) + PAYLOAD);
+	ip->nexthdr = IPPROTO_UDP;
+	ip->hop_limit = 64U;
+	net_ipaddr_copy(&ip->src, &peer_addr);
+	net_ipaddr_copy(&ip->dst, &my_addr);
+
+	udp->src_port = htons(PORT + 1);
+	udp->dst_port = htons(PORT);
+	udp->len = htons(sizeof(*udp) + PAYLOAD);
+}
+
+static void udp_received(struct net_context *context, struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 union net_proto_header *proto_hdr,
+			 int status, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(status);
+	ARG_UNUSED(user_data);
+
+	if (pkt) {
+		net_pkt_unref(pkt);
+	}
+
+	if (++rx_pkts == ROUNDS) {
+		k_sem_give(&rx_done);
+	}
+}
+
+static u32_t pps(u32_t cycles)
+{
+	return (u64_t)ROUNDS * sys_clock_hw_cycles_per_sec() / MAX(cycles, 1);
+}
+
+static u32_t run_rx(struct net_if *iface, bool batch)
+{
+	struct net_pkt *pkts[BURST];
+	u32_t start;
+	int i, j;
+
+	rx_pkts = 0U;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i += BURST) {
+		for (j = 0; j < BURST; j++) {
+			pkts[j] = net_pkt_rx_alloc_with_buffer(iface,
+							       sizeof(frame),
+							       AF_UNSPEC, 0,
+							       K_FOREVER);
+			if (!pkts[j] ||
+			    net_pkt_write(pkts[j], frame, sizeof(frame))) {
+				printk("Cannot build frame\n");
+				return 0;
+			}
+		}
+
+		if (batch) {
+			net_recv_data_batch(iface, pkts, BURST);
+			continue;
+		}
+
+		for (j = 0; j < BURST; j++) {
+			net_recv_data(iface, pkts[j]);
+		}
+	}
+
+	if (k_sem_take(&rx_done, K_SECONDS(10))) {
+		printk("%u packets received out of %u\n", rx_pkts, ROUNDS);
+		return 0;
+	}
+
+	return pps(k_cycle_get_32() - start);
+}
+
+static u32_t run_tx(struct net_context *ctx)
+{
+	static const u8_t payload[PAYLOAD];
+	struct sockaddr_in6 dst = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT + 1),
+	};
+	u32_t start;
+	int i;
+
+	net_ipaddr_copy(&dst.sin6_addr, &peer_addr);
+
+	tx_pkts = 0U;
+	tx_calls = 0U;
+	tx_target = ROUNDS;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		if (net_context_sendto(ctx, payload, sizeof(payload),
+				       (struct sockaddr *)&dst, sizeof(dst),
+				       NULL, K_FOREVER, NULL) < 0) {
+			printk("Cannot send packet %d\n", i);
+			return 0;
+		}
+	}
+
+	if (k_sem_take(&tx_done, K_SECONDS(10))) {
+		printk("%u packets sent out of %u\n", tx_pkts, ROUNDS);
+		return 0;
+	}
+
+	return pps(k_cycle_get_32() - start);
+}
+
+void main(void)
+{
+	struct net_if *iface = eth_context.iface;
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT),
+	};
+	struct net_context *ctx;
+	u32_t single, batch, tx;
+
+	if (!net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot add address\n");
+		return;
+	}
+
+	net_ipaddr_copy(&addr.sin6_addr, &my_addr);
+
+	if (net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP, &ctx) < 0 ||
+	    net_context_bind(ctx, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    net_context_recv(ctx, udp_received, K_NO_WAIT, NULL) < 0) {
+		printk("Cannot set UDP context up\n");
+		return;
+	}
+
+	build_frame();
+
+	single = run_rx(iface, false);
+	batch = run_rx(iface, true);
+
+	printk("rx single %7u pps batch %7u pps\n", single, batch);
+
+	tx = run_tx(ctx);
+
+	printk("tx        %7u pps %2u pkts per driver call\n", tx,
+	       tx_pkts / MAX(tx_calls, 1U));
+
+	net_context_put(ctx);
+
+	printk("fin\n");
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/net_core.h>
+#include <net/net_context.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/ethernet.h>
+
+/* Cost of sending and receiving packets of different sizes, depending
+ * on the data buffer allocator.  See README.rst.
+ */
+
+#define ROUNDS 1024
+#define PORT 4242
+#define HDRS_LEN (sizeof(struct net_eth_hdr) + NET_IPV6H_LEN + NET_UDPH_LEN)
+
+static const u16_t payload_lens[] = { 64, 512, 1024 };
+
+struct bench_eth_context {
+	struct net_if *iface;
+	u8_t mac_addr[6];
+};
+
+static struct bench_eth_context eth_context = {
+	.mac_addr = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static u32_t tx_pkts;
+static u32_t tx_bufs;
+static K_SEM_DEFINE(tx_done, 0, 1);
+
+static u32_t rx_pkts;
+static K_SEM_DEFINE(rx_done, 0, 1);
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static u8_t frame[HDRS_LEN + 1024];
+static const u8_t payload[1024];
+
+static u32_t count_bufs(struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+	u32_t count = 0U;
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		count++;
+	}
+
+	return count;
+}
+
+static int bench_eth_send(struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	tx_bufs += count_bufs(pkt);
+
+	if (++tx_pkts == ROUNDS) {
+		k_sem_give(&tx_done);
+	}
+
+	return 0;
+}
+
+static enum ethernet_hw_caps bench_eth_caps(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	/* Keeps checksums out of the measurement */
+	return ETHERNET_HW_TX_CHKSUM_OFFLOAD | ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static void bench_eth_iface_init(struct net_if *iface)
+{
+	struct bench_eth_context *ctx = net_if_get_device(iface)->driver_data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_addr, sizeof(ctx->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int bench_eth_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static const struct ethernet_api bench_eth_api = {
+	.iface_api.init = bench_eth_iface_init,
+	.get_capabilities = bench_eth_caps,
+	.send = bench_eth_send,
+};
+
+ETH_NET_DEVICE_INIT(bench_eth, "bench_eth", bench_eth_init, &eth_context,
+		    NULL, CONFIG_ETH_INIT_PRIORITY, &bench_eth_api,
+		    NET_ETH_MTU);
+
+static void build_frame(u16_t len)
+{
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)frame;
+	struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)(eth + 1);
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)(ip + 1);
+
+	memcpy(&eth->dst, eth_context.mac_addr, sizeof(eth->dst));
+	memcpy(&eth->src, eth_context.mac_addr, sizeof(eth->src));
+	eth->src.addr[5]++;
+	eth->type = htons(NET_ETH_PTYPE_IPV6);
+
+	ip->vtc = 0x60;
+	ip->len = htons(sizeof(*udp) + len);
+	ip->nexthdr = IPPROTO_UDP;
+	ip->hop_limit = 64U;
+	net_ipaddr_copy(&ip->src, &peer_addr);
+	net_ipaddr_copy(&ip->dst, &my_addr);
+
+	udp->src_port = htons(PORT + 1);
+	udp->dst_port = htons(PORT);
+	udp->len = htons(sizeof(*udp) + len);
+}
+
+static void udp_received(struct net_context *context, struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 union net_proto_header *proto_hdr,
+			 int status, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(status);
+	ARG_UNUSED(user_data);
+
+	if (pkt) {
+		net_pkt_unref(pkt);
+	}
+
+	if (++rx_pkts == ROUNDS) {
+		k_sem_give(&rx_done);
+	}
+}
+
+static void run_rx(struct net_if *iface, u16_t len)
+{
+	size_t frame_len = HDRS_LEN + len;
+	u32_t bufs = 0U;
+	u32_t start;
+	int i;
+
+	build_frame(len);
+
+	rx_pkts = 0U;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		struct net_pkt *pkt;
+
+		pkt = net_pkt_rx_alloc_with_buffer(iface, frame_len,
+						   AF_UNSPEC, 0, K_FOREVER);
+		if (!pkt || net_pkt_write(pkt, frame, frame_len)) {
+			printk("Cannot build frame\n");
+			return;
+		}
+
+		bufs += count_bufs(pkt);
+
+		if (net_recv_data(iface, pkt) < 0) {
+			printk("Cannot receive frame\n");
+			net_pkt_unref(pkt);
+			return;
+		}
+	}
+
+	if (k_sem_take(&rx_done, K_SECONDS(10))) {
+		printk("%u packets received out of %u\n", rx_pkts, ROUNDS);
+		return;
+	}
+
+	printk("rx %4u bytes %7u cycles/pkt %2u bufs/pkt\n", len,
+	       (k_cycle_get_32() - start) / ROUNDS, bufs / ROUNDS);
+}
+
+static void run_tx(struct net_context *ctx, u16_t len)
+{
+	struct sockaddr_in6 dst = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT + 1),
+	};
+	u32_t start;
+	int i;
+
+	net_ipaddr_copy(&dst.sin6_addr, &peer_addr);
+
+	tx_pkts = 0U;
+	tx_bufs = 0U;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < ROUNDS; i++) {
+		if (net_context_sendto(ctx, payload, len,
+				       (struct sockaddr *)&dst, sizeof(dst),
+				       NULL, K_FOREVER, NULL) < 0) {
+			printk("Cannot send packet %d\n", i);
+			return;
+		}
+	}
+
+	if (k_sem_take(&tx_done, K_SECONDS(10))) {
+		printk("%u packets sent out of %u\n", tx_pkts, ROUNDS);
+		return;
+	}
+
+	printk("tx %4u bytes %7u cycles/pkt %2u bufs/pkt\n", len,
+	       (k_cycle_get_32() - start) / ROUNDS, tx_bufs / ROUNDS);
+}
+
+void main(void)
+{
+	struct net_if *iface = eth_context.iface;
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT),
+	};
+	struct net_context *ctx;
+	int i;
+
+	if (!net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("Cannot add address\n");
+		return;
+	}
+
+	net_ipaddr_copy(&addr.sin6_addr, &my_addr);
+
+	if (net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP, &ctx) < 0 ||
+	    net_context_bind(ctx, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    net_context_recv(ctx, udp_received, K_NO_WAIT, NULL) < 0) {
+		printk("Cannot set UDP context up\n");
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(payload_lens); i++) {
+		run_rx(iface, payload_lens[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(payload_lens); i++) {
+		run_tx(ctx, payload_lens[i]);
+	}
+
+	net_context_put(ctx);
+
+	printk("fin\n");
+}
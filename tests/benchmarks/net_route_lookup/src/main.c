@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+/* Cost of the route lookup of forwarded packets with many routes.  See
+ * README.rst.
+ */
+
+#define ROUTES 1024
+#define NEXTHOPS 8
+#define ROUNDS 4096
+#define HOT 4
+
+static struct net_route_entry *routes[ROUTES];
+static struct in6_addr dests[ROUTES];
+static struct in6_addr nexthops[NEXTHOPS];
+
+/* Even routes cover 2001:db8:<hash>::/64, odd ones the single host
+ * 2001:db8:ffff:<i>::1, so that no route covers another one
+ */
+static void route_addr(int i, struct in6_addr *addr, u8_t *prefix_len)
+{
+	u32_t hash = i * 2654435761U;
+
+	(void)memset(addr, 0, sizeof(*addr));
+	addr->s6_addr16[0] = htons(0x2001);
+	addr->s6_addr16[1] = htons(0x0db8);
+
+	if (i % 2) {
+		addr->s6_addr16[2] = htons(0xffff);
+		addr->s6_addr16[3] = htons(i);
+		addr->s6_addr[15] = 1U;
+		*prefix_len = 128U;
+	} else {
+		addr->s6_addr16[2] = htons((hash >> 16) % 0xffff);
+		addr->s6_addr16[3] = htons(hash);
+		*prefix_len = 64U;
+	}
+}
+
+static int add_nexthops(struct net_if *iface)
+{
+	u8_t lladdr[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 };
+	struct net_linkaddr ll = {
+		.addr = lladdr,
+		.len = sizeof(lladdr),
+		.type = NET_LINK_DUMMY,
+	};
+
+	for (int i = 0; i < NEXTHOPS; i++) {
+		net_addr_pton(AF_INET6, "fe80::10", &nexthops[i]);
+		nexthops[i].s6_addr[15] += i;
+		lladdr[5] = i + 1;
+
+		if (!net_ipv6_nbr_add(iface, &nexthops[i], &ll, false,
+				      NET_IPV6_NBR_STATE_REACHABLE)) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static int add_routes(struct net_if *iface, int count)
+{
+	for (int i = 0; i < count; i++) {
+		u8_t prefix_len;
+
+		route_addr(i, &dests[i], &prefix_len);
+
+		routes[i] = net_route_add(iface, &dests[i], prefix_len,
+					  &nexthops[i % NEXTHOPS]);
+		if (!routes[i]) {
+			return -ENOMEM;
+		}
+
+		/* Look up a host inside the prefix */
+		if (prefix_len == 64U) {
+			dests[i].s6_addr[15] = 0x42;
+		}
+	}
+
+	return 0;
+}
+
+static void del_routes(int count)
+{
+	for (int i = 0; i < count; i++) {
+		net_route_del(routes[i]);
+	}
+}
+
+/* Looks up ROUNDS destinations, picked among the first range ones */
+static u32_t run(struct net_if *iface, int range, bool miss)
+{
+	struct in6_addr none;
+	u32_t found = 0U;
+	u32_t start;
+
+	net_addr_pton(AF_INET6, "2001:db8:fffe::1", &none);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		if (net_route_lookup(iface, miss ? &none : &dests[i % range])) {
+			found++;
+		}
+	}
+
+	start = (k_cycle_get_32() - start) / ROUNDS;
+
+	if (found != (miss ? 0 : ROUNDS)) {
+		printk("%u routes found out of %u\n", found, ROUNDS);
+	}
+
+	return start;
+}
+
+void main(void)
+{
+	static const int counts[] = { 16, 256, ROUTES };
+	struct net_if *iface = net_if_get_default();
+
+	if (add_nexthops(iface) < 0) {
+		printk("Cannot add next hops\n");
+		return;
+	}
+
+	for (int c = 0; c < ARRAY_SIZE(counts); c++) {
+		u32_t spread, hot, miss;
+
+		if (add_routes(iface, counts[c]) < 0) {
+			printk("Cannot add %d routes\n", counts[c]);
+			return;
+		}
+
+		spread = run(iface, counts[c], false);
+		hot = run(iface, HOT, false);
+		miss = run(iface, 1, true);
+
+		printk("routes %4d spread %6u cycles hot %6u cycles "
+		       "miss %6u cycles\n", counts[c], spread, hot, miss);
+
+		del_routes(counts[c]);
+	}
+
+	printk("fin\n");
+}
@@ -41,9 +41,13 @@
 #define N_RUNS 1000
 #define N_SETTLE 10
 
-
+#ifdef CONFIG_SMP
+/* See smp.c */
+void smp_scaling(void);
+#else
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
+#endif
 
 _wait_q_t waitq;
 
@@ -79,6 +83,7 @@ static inline int _stamp(int state)
 /* #define stamp(s) printk("%s @ %d\n", #s, _stamp(s)) */
 #define stamp(s) _stamp(s)
 
+#ifndef CONFIG_SMP
 static void partner_fn(void *arg1, void *arg2, void *arg3)
 {
 	ARG_UNUSED(arg1);
@@ -94,9 +99,13 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 		stamp(PARTNER_AWAKE_PENDING);
 	}
 }
+#endif
 
 void main(void)
 {
+#ifdef CONFIG_SMP
+	smp_scaling();
+#else
 	z_waitq_init(&waitq);
 
 	int main_prio = k_thread_priority_get(k_current_get());
@@ -157,5 +166,6 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+#endif
 	printk("fin\n");
 }
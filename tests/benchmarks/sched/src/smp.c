@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+
+/* SMP scheduler scaling benchmark: pairs of threads ping-pong a
+ * semaphore for RUN_MS milliseconds and the aggregate handoff rate is
+ * reported for an increasing number of pairs.  Replaces the latency
+ * measurement of main.c on SMP builds.  See README.rst.
+ */
+
+#define MAX_PAIRS (2 * CONFIG_MP_NUM_CPUS)
+#define RUN_MS 1000
+#define STACK_SIZE 1024
+#define PRIO 5
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	u32_t count;
+};
+
+static struct pair pairs[MAX_PAIRS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_PAIRS];
+static volatile bool running;
+
+static void ping_fn(void *p1, void *p2, void *p3)
+{
+	struct pair *p = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		k_sem_give(&p->ping);
+		k_sem_take(&p->pong, K_FOREVER);
+		p->count++;
+	}
+
+	/* Release the partner if it is waiting */
+	k_sem_give(&p->ping);
+}
+
+static void pong_fn(void *p1, void *p2, void *p3)
+{
+	struct pair *p = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (running) {
+		k_sem_take(&p->ping, K_FOREVER);
+		k_sem_give(&p->pong);
+	}
+}
+
+static void run(int npairs)
+{
+	u32_t total = 0U;
+
+	running = true;
+
+	for (int i = 0; i < npairs; i++) {
+		k_sem_init(&pairs[i].ping, 0, 1);
+		k_sem_init(&pairs[i].pong, 0, 1);
+		pairs[i].count = 0U;
+
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				ping_fn, &pairs[i], NULL, NULL,
+				PRIO, 0, K_NO_WAIT);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, pong_fn, &pairs[i], NULL, NULL,
+				PRIO, 0, K_NO_WAIT);
+	}
+
+	k_sleep(RUN_MS);
+	running = false;
+
+	for (int i = 0; i < npairs; i++) {
+		total += pairs[i].count;
+		k_thread_abort(&threads[2 * i]);
+		k_thread_abort(&threads[2 * i + 1]);
+	}
+
+	printk("pairs %2d handoffs %8u per_ms %6u\n", npairs, total,
+	       total / RUN_MS);
+}
+
+void smp_scaling(void)
+{
+	printk("CPUs: %d, ready queues: %s\n", CONFIG_MP_NUM_CPUS,
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per-CPU" : "shared");
+
+	/* Main must outrank the workers to stop them reliably */
+	k_thread_priority_set(k_current_get(), PRIO - 1);
+
+	for (int n = 1; n <= MAX_PAIRS; n++) {
+		run(n);
+	}
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <stdio.h>
+#include <string.h>
+#include <settings/settings.h>
+#include <flash_map.h>
+
+/* Boot-time cost of settings with many handlers.  See README.rst. */
+
+#define HANDLERS 40
+#define KEYS 16
+#define LOOKUPS 1000
+
+static char names[HANDLERS][4];
+static struct settings_handler handlers[HANDLERS];
+static u32_t value;
+static u32_t set_calls;
+
+static int handler_set(int argc, char **argv, void *value_ctx)
+{
+	if (argc != 1 || argv[0][0] != 'k') {
+		return -ENOENT;
+	}
+
+	set_calls++;
+
+	/* all handlers share the same storage, only the cost matters */
+	return settings_val_read_cb(value_ctx, &value, sizeof(value)) < 0 ?
+	       -EIO : 0;
+}
+
+static u32_t elapsed_us(u32_t start)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(k_cycle_get_32() - start) /
+		       NSEC_PER_USEC);
+}
+
+static int store_records(void)
+{
+	const struct flash_area *fap;
+	char name[16];
+	int rc;
+
+	/* start from an empty storage area, so that records are only
+	 * written once
+	 */
+	rc = flash_area_open(DT_FLASH_AREA_STORAGE_ID, &fap);
+	if (rc == 0) {
+		rc = flash_area_erase(fap, 0, fap->fa_size);
+		flash_area_close(fap);
+	}
+	if (rc) {
+		return rc;
+	}
+
+	rc = settings_subsys_init();
+	if (rc) {
+		return rc;
+	}
+
+	for (int h = 0; h < HANDLERS; h++) {
+		for (int k = 0; k < KEYS; k++) {
+			snprintf(name, sizeof(name), "%s/k%d", names[h], k);
+			value = h * KEYS + k;
+			rc = settings_save_one(name, &value, sizeof(value));
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	char name[16];
+	u32_t start, cycles;
+	int rc;
+
+	for (int h = 0; h < HANDLERS; h++) {
+		snprintf(names[h], sizeof(names[h]), "h%02d", h);
+		handlers[h].name = names[h];
+		handlers[h].h_set = handler_set;
+	}
+
+	rc = store_records();
+	if (rc) {
+		printk("storing records failed: %d\n", rc);
+		return;
+	}
+
+	for (int h = 0; h < HANDLERS; h++) {
+		rc = settings_register(&handlers[h]);
+		if (rc) {
+			printk("settings_register failed: %d\n", rc);
+			return;
+		}
+	}
+
+	set_calls = 0U;
+	start = k_cycle_get_32();
+	rc = settings_load();
+	if (rc) {
+		printk("settings_load failed: %d\n", rc);
+		return;
+	}
+	printk("load         %4u records %8u us\n", set_calls,
+	       elapsed_us(start));
+
+	set_calls = 0U;
+	start = k_cycle_get_32();
+	rc = settings_load_subtree(names[HANDLERS / 2]);
+	if (rc) {
+		printk("settings_load_subtree failed: %d\n", rc);
+		return;
+	}
+	printk("load_subtree %4u records %8u us\n", set_calls,
+	       elapsed_us(start));
+
+	/* handlers[0] was registered first, it ends the handler list */
+	snprintf(name, sizeof(name), "%s/k0", names[0]);
+	start = k_cycle_get_32();
+	for (int i = 0; i < LOOKUPS; i++) {
+		(void)settings_set_value(name, &value, sizeof(value));
+	}
+	cycles = (k_cycle_get_32() - start) / LOOKUPS;
+	printk("lookup       %4u handlers %8u cycles\n", HANDLERS, cycles);
+
+	printk("fin\n");
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+
+/* Cost of poll() versus zsock_epoll_wait() over a growing number of
+ * sockets with one of them ready.  See README.rst.
+ */
+
+#define MAX_SOCKETS 128
+#define BASE_PORT 4242
+#define ITERATIONS 1000
+
+static const int set_sizes[] = { 8, 32, MAX_SOCKETS };
+
+static int socks[MAX_SOCKETS];
+static struct zsock_pollfd fds[MAX_SOCKETS];
+static struct zsock_epoll_event events[MAX_SOCKETS];
+static struct sockaddr_in addr;
+
+static u32_t bench_poll(int count)
+{
+	u32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		if (zsock_poll(fds, count, 0) != 1) {
+			printk("poll: unexpected result\n");
+			break;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ITERATIONS;
+}
+
+static u32_t bench_epoll(int ep)
+{
+	u32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		if (zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0) != 1) {
+			printk("epoll: unexpected result\n");
+			break;
+		}
+	}
+
+	return (k_cycle_get_32() - start) / ITERATIONS;
+}
+
+static void run(int count, int sender)
+{
+	struct zsock_epoll_event event = { .events = ZSOCK_POLLIN };
+	char byte = 0;
+	int ep;
+
+	ep = zsock_epoll_create();
+	if (ep < 0) {
+		printk("epoll_create failed: %d\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < count; i++) {
+		fds[i].fd = socks[i];
+		fds[i].events = ZSOCK_POLLIN;
+
+		event.data.fd = socks[i];
+		if (zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_ADD, socks[i],
+				    &event) < 0) {
+			printk("epoll_ctl failed: %d\n", errno);
+			goto out;
+		}
+	}
+
+	/* Leave one datagram pending on the last socket of the set */
+	addr.sin_port = htons(BASE_PORT + count - 1);
+	zsock_sendto(sender, &byte, sizeof(byte), 0,
+		     (struct sockaddr *)&addr, sizeof(addr));
+	k_sleep(K_MSEC(10));
+
+	printk("poll  %3d sockets %8u cycles/op\n", count, bench_poll(count));
+	printk("epoll %3d sockets %8u cycles/op\n", count, bench_epoll(ep));
+
+	zsock_recv(socks[count - 1], &byte, sizeof(byte), 0);
+
+out:
+	zsock_close(ep);
+}
+
+void main(void)
+{
+	int sender;
+
+	addr.sin_family = AF_INET;
+	zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+			&addr.sin_addr);
+
+	for (int i = 0; i < MAX_SOCKETS; i++) {
+		socks[i] = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		addr.sin_port = htons(BASE_PORT + i);
+		if (socks[i] < 0 ||
+		    zsock_bind(socks[i], (struct sockaddr *)&addr,
+			       sizeof(addr)) < 0) {
+			printk("socket setup failed: %d\n", errno);
+			return;
+		}
+	}
+
+	sender = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	for (int i = 0; i < ARRAY_SIZE(set_sizes); i++) {
+		run(set_sizes[i], sender);
+	}
+
+	zsock_close(sender);
+	for (int i = 0; i < MAX_SOCKETS; i++) {
+		zsock_close(socks[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+#include <net/net_pkt.h>
+
+/* Receive throughput of recv() versus zsock_recv_pkt() over loopback
+ * TCP.  See README.rst.
+ */
+
+#define TOTAL_BYTES (256 * 1024)
+#define CHUNK 1024
+#define PORT 4242
+#define SENDER_STACK 1024
+#define SENDER_PRIO 7
+
+static K_THREAD_STACK_DEFINE(sender_stack, SENDER_STACK);
+static struct k_thread sender_thread;
+
+static struct sockaddr_in server_addr;
+static u8_t tx_buf[CHUNK];
+static u8_t rx_buf[CHUNK];
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	size_t left = TOTAL_BYTES;
+	int sock;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (zsock_connect(sock, (struct sockaddr *)&server_addr,
+			  sizeof(server_addr)) < 0) {
+		printk("connect failed: %d\n", errno);
+		zsock_close(sock);
+		return;
+	}
+
+	while (left > 0) {
+		ssize_t sent = zsock_send(sock, tx_buf, MIN(left, CHUNK), 0);
+
+		if (sent < 0) {
+			printk("send failed: %d\n", errno);
+			break;
+		}
+		left -= sent;
+	}
+
+	zsock_close(sock);
+}
+
+static u32_t checksum(u32_t sum, const u8_t *data, size_t len)
+{
+	while (len--) {
+		sum += *data++;
+	}
+
+	return sum;
+}
+
+static ssize_t recv_copy(int sock, u32_t *sum)
+{
+	ssize_t len = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+
+	if (len > 0) {
+		*sum = checksum(*sum, rx_buf, len);
+	}
+
+	return len;
+}
+
+static ssize_t recv_zerocopy(int sock, u32_t *sum)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	u8_t *pos;
+	ssize_t len;
+	size_t left;
+
+	len = zsock_recv_pkt(sock, &pkt, 0);
+	if (len <= 0) {
+		return len;
+	}
+
+	frag = pkt->cursor.buf;
+	pos = pkt->cursor.pos;
+	for (left = len; frag != NULL && left > 0; frag = frag->frags) {
+		size_t n = MIN(left, frag->data + frag->len - pos);
+
+		*sum = checksum(*sum, pos, n);
+		left -= n;
+		if (frag->frags != NULL) {
+			pos = frag->frags->data;
+		}
+	}
+
+	zsock_recv_pkt_release(pkt);
+
+	return len;
+}
+
+static void run(const char *name, int listen_sock,
+		ssize_t (*receive)(int sock, u32_t *sum))
+{
+	u32_t start, elapsed, sum = 0U;
+	size_t total = 0;
+	ssize_t len;
+	int sock;
+
+	k_thread_create(&sender_thread, sender_stack, SENDER_STACK,
+			sender, NULL, NULL, NULL, SENDER_PRIO, 0, K_NO_WAIT);
+
+	sock = zsock_accept(listen_sock, NULL, NULL);
+	if (sock < 0) {
+		printk("accept failed: %d\n", errno);
+		return;
+	}
+
+	start = k_uptime_get_32();
+	while ((len = receive(sock, &sum)) > 0) {
+		total += len;
+	}
+	elapsed = MAX(k_uptime_get_32() - start, 1);
+
+	zsock_close(sock);
+
+	/* Let the sender finish closing its end */
+	k_sleep(K_MSEC(100));
+
+	printk("%-8s %7u bytes %6u ms %6u KiB/s (sum %08x)\n", name,
+	       (u32_t)total, elapsed, (u32_t)(total * 1000U / 1024U / elapsed),
+	       sum);
+}
+
+void main(void)
+{
+	int sock;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_port = htons(PORT);
+	zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+			&server_addr.sin_addr);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (zsock_bind(sock, (struct sockaddr *)&server_addr,
+		       sizeof(server_addr)) < 0 ||
+	    zsock_listen(sock, 1) < 0) {
+		printk("server setup failed: %d\n", errno);
+		return;
+	}
+
+	run("copy", sock, recv_copy);
+	run("zerocopy", sock, recv_zerocopy);
+
+	zsock_close(sock);
+	printk("fin\n");
+}
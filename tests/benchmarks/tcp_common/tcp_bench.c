@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+
+#include "tcp_bench.h"
+
+#define TCP_BENCH_PORT 4242
+#define TCP_BENCH_MAX_WRITE 1024
+#define TCP_BENCH_SENDER_STACK 1024
+#define TCP_BENCH_SENDER_PRIO 7
+
+static K_THREAD_STACK_DEFINE(sender_stack, TCP_BENCH_SENDER_STACK);
+static struct k_thread sender_thread;
+
+static struct sockaddr_in addr;
+static u8_t tx_buf[TCP_BENCH_MAX_WRITE];
+static u8_t rx_buf[1024];
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	size_t left = POINTER_TO_UINT(p1);
+	size_t write_size = POINTER_TO_UINT(p2);
+	int nodelay = POINTER_TO_INT(p3);
+	int sock;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (nodelay &&
+	    zsock_setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &nodelay,
+			     sizeof(nodelay)) < 0) {
+		printk("setsockopt failed: %d\n", errno);
+	}
+
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed: %d\n", errno);
+		zsock_close(sock);
+		return;
+	}
+
+	while (left > 0) {
+		ssize_t sent = zsock_send(sock, tx_buf, MIN(left, write_size),
+					  0);
+
+		if (sent < 0) {
+			printk("send failed: %d\n", errno);
+			break;
+		}
+		left -= sent;
+	}
+
+	zsock_close(sock);
+}
+
+int tcp_bench_listen(void)
+{
+	int sock;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(TCP_BENCH_PORT);
+	zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+			&addr.sin_addr);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_listen(sock, 1) < 0) {
+		printk("server setup failed: %d\n", errno);
+		zsock_close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+int tcp_bench_accept(int listen_sock, size_t total, size_t write_size,
+		     bool nodelay)
+{
+	int sock;
+
+	k_thread_create(&sender_thread, sender_stack,
+			K_THREAD_STACK_SIZEOF(sender_stack), sender,
+			UINT_TO_POINTER(total),
+			UINT_TO_POINTER(MIN(write_size, TCP_BENCH_MAX_WRITE)),
+			INT_TO_POINTER(nodelay), TCP_BENCH_SENDER_PRIO, 0,
+			K_NO_WAIT);
+
+	sock = zsock_accept(listen_sock, NULL, NULL);
+	if (sock < 0) {
+		printk("accept failed: %d\n", errno);
+	}
+
+	return sock;
+}
+
+size_t tcp_bench_recv_all(int sock)
+{
+	size_t total = 0;
+	ssize_t len;
+
+	while ((len = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0)) > 0) {
+		total += len;
+	}
+
+	return total;
+}
+
+void tcp_bench_close(int sock)
+{
+	zsock_close(sock);
+
+	/* Let the sender finish closing its end */
+	k_sleep(K_MSEC(500));
+}
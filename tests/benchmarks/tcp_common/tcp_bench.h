@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Common part of the TCP benchmarks over the loopback interface.  Each
+ * run connects a sender thread to the listening socket, which pushes a
+ * given amount of data in fixed size writes, while the benchmark reads
+ * it back as fast as it can.
+ */
+
+#ifndef __TCP_BENCH_H
+#define __TCP_BENCH_H
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Returns the listening socket, or a negative value on error */
+int tcp_bench_listen(void);
+
+/* Starts a sender writing total bytes in write_size chunks, with
+ * TCP_NODELAY set if nodelay is true.  Returns the accepted socket,
+ * or a negative value on error.
+ */
+int tcp_bench_accept(int listen_sock, size_t total, size_t write_size,
+		     bool nodelay);
+
+/* Reads until the sender closes its end, returns the bytes received */
+size_t tcp_bench_recv_all(int sock);
+
+void tcp_bench_close(int sock);
+
+#endif /* __TCP_BENCH_H */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+#include <net/loopback.h>
+
+#include "tcp_bench.h"
+
+/* TCP throughput versus loss rate over the loopback interface.  See
+ * README.rst.
+ */
+
+#define TOTAL_BYTES (64 * 1024)
+#define CHUNK 1024
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+#define CC_NAME "cubic"
+#elif defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#define CC_NAME "newreno"
+#else
+#define CC_NAME "none"
+#endif
+
+/* Loss rates, in 1/1000 */
+static const u32_t loss_rates[] = { 0, 5, 10, 20, 50 };
+
+static void run(int listen_sock, u32_t loss)
+{
+	u32_t start, elapsed;
+	size_t total;
+	int sock;
+
+	sock = tcp_bench_accept(listen_sock, TOTAL_BYTES, CHUNK, false);
+	if (sock < 0) {
+		return;
+	}
+
+	/* Only lose data and ACKs, not the handshake */
+	loopback_set_packet_drop_ratio(loss);
+
+	start = k_uptime_get_32();
+	total = tcp_bench_recv_all(sock);
+	elapsed = MAX(k_uptime_get_32() - start, 1);
+
+	loopback_set_packet_drop_ratio(0);
+	tcp_bench_close(sock);
+
+	printk("loss %2u.%u%% %7u bytes %6u ms %6u KiB/s\n",
+	       loss / 10U, loss % 10U, (u32_t)total, elapsed,
+	       (u32_t)(total * 1000U / 1024U / elapsed));
+}
+
+void main(void)
+{
+	int sock;
+
+	sock = tcp_bench_listen();
+	if (sock < 0) {
+		return;
+	}
+
+	printk("congestion control: %s\n", CC_NAME);
+
+	for (int i = 0; i < ARRAY_SIZE(loss_rates); i++) {
+		run(sock, loss_rates[i]);
+	}
+
+	zsock_close(sock);
+	printk("fin\n");
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+
+#include "tcp_bench.h"
+
+/* TCP segments per KiB of data sent in small writes, over the loopback
+ * interface.  See README.rst.
+ */
+
+#define TOTAL_BYTES (16 * 1024)
+
+static const size_t write_sizes[] = { 16, 64, 256 };
+
+static u32_t segments_sent(void)
+{
+	struct net_stats_tcp stats;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &stats,
+		     sizeof(stats)) < 0) {
+		return 0;
+	}
+
+	return stats.sent;
+}
+
+static void run(int listen_sock, size_t write_size, bool nodelay)
+{
+	u32_t start, segments;
+	size_t total;
+	int sock;
+
+	sock = tcp_bench_accept(listen_sock, TOTAL_BYTES, write_size,
+				nodelay);
+	if (sock < 0) {
+		return;
+	}
+
+	/* Do not count the handshake */
+	start = segments_sent();
+	total = tcp_bench_recv_all(sock);
+	segments = segments_sent() - start;
+
+	tcp_bench_close(sock);
+
+	printk("write %3u %-7s %6u bytes %5u segments %4u per KiB\n",
+	       (u32_t)write_size, nodelay ? "nodelay" : "nagle",
+	       (u32_t)total, segments,
+	       (u32_t)(segments * 1024U / MAX(total, 1)));
+}
+
+void main(void)
+{
+	int sock;
+
+	sock = tcp_bench_listen();
+	if (sock < 0) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(write_sizes); i++) {
+		run(sock, write_sizes[i], false);
+		run(sock, write_sizes[i], true);
+	}
+
+	zsock_close(sock);
+	printk("fin\n");
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <random/rand32.h>
+#include <timeout_q.h>
+
+/* Timeout queue microbenchmark: measures z_add_timeout() and
+ * z_abort_timeout() latency against queues holding an increasing
+ * number of armed timeouts.  See README.rst.
+ */
+
+#define MAX_TIMEOUTS 1000
+#define N_RUNS 200
+
+/* Keep everything well clear of expiring during the run */
+#define MIN_DELAY_TICKS 100000
+#define DELAY_RANGE_TICKS 1000000
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+static struct _timeout probe;
+
+static const int sizes[] = { 10, 100, 1000 };
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("unexpected expiry\n");
+}
+
+static s32_t rand_delay(void)
+{
+	return MIN_DELAY_TICKS + (sys_rand32_get() % DELAY_RANGE_TICKS);
+}
+
+static void run(int n)
+{
+	u64_t add_tot = 0U, abort_tot = 0U;
+
+	for (int i = 0; i < n; i++) {
+		z_add_timeout(&timeouts[i], dummy_fn, rand_delay());
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		s32_t delay = rand_delay();
+		u32_t t0, t1, t2;
+
+		t0 = k_cycle_get_32();
+		z_add_timeout(&probe, dummy_fn, delay);
+		t1 = k_cycle_get_32();
+		z_abort_timeout(&probe);
+		t2 = k_cycle_get_32();
+
+		add_tot += t1 - t0;
+		abort_tot += t2 - t1;
+	}
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+
+	printk("n %4d add %6u abort %6u\n", n,
+	       (u32_t)(add_tot / N_RUNS), (u32_t)(abort_tot / N_RUNS));
+}
+
+void main(void)
+{
+	printk("Timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_WHEEL) ? "wheel" : "delta list");
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run(sizes[i]);
+	}
+
+	printk("fin\n");
+}
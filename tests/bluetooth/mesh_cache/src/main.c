@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <errno.h>
+#include <string.h>
+#include <misc/printk.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/mesh.h>
+#include <settings/settings.h>
+
+#include "settings.h"
+#include "mesh/net.h"
+#include "mesh/transport.h"
+
+#define CACHE_SIZE CONFIG_BT_MESH_MSG_CACHE_SIZE
+#define CACHE_INDEX_SIZE (2 * CONFIG_BT_MESH_MSG_CACHE_SIZE)
+#define RPL_INDEX_SIZE (2 * CONFIG_BT_MESH_CRPL)
+
+/* Size of the duplicate cache in front of the message cache */
+#define DUP_CACHE_SIZE 4
+
+#define MSG_COUNT (4 * CACHE_SIZE)
+#define SRC_BASE 0x0100
+#define DST 0x0001
+#define PDU_LEN 29
+#define JUNK_LEN (BT_MESH_NET_HDR_LEN + 1 + 8)
+
+static struct bt_mesh_cfg_srv cfg_srv = {
+	.relay = BT_MESH_RELAY_ENABLED,
+	.default_ttl = 7,
+};
+
+static struct bt_mesh_model models[] = {
+	BT_MESH_MODEL_CFG_SRV(&cfg_srv),
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static const u8_t dev_uuid[16] = { 0xdd, 0xdd };
+
+static const struct bt_mesh_prov prov = {
+	.uuid = dev_uuid,
+};
+
+static const u8_t net_key[16] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab,
+				  0xcd, 0xef, 0x01, 0x23, 0x45, 0x67,
+				  0x89, 0xab, 0xcd, 0xef };
+
+/* Network PDUs, as received over the air */
+static struct {
+	u16_t src;
+	u32_t seq;
+	u8_t data[PDU_LEN];
+	u8_t len;
+} msgs[MSG_COUNT];
+
+/* Messages expected in the cache, in ring order */
+static int cached[CACHE_SIZE] = {
+	[0 ... (CACHE_SIZE - 1)] = -1,
+};
+static int cached_next;
+
+/* Sources whose home slots are the last one of the replay protection
+ * list index and the first two, so that the probe chains wrap around.
+ */
+static const u16_t rpl_src[] = {
+	RPL_INDEX_SIZE - 1,
+	2 * RPL_INDEX_SIZE - 1,
+	3 * RPL_INDEX_SIZE - 1,
+	RPL_INDEX_SIZE,
+	RPL_INDEX_SIZE + 1,
+};
+
+/* Home slot of a message in the message cache index, as computed by
+ * msg_hash() and msg_cache_slot() for IV Index 0.
+ */
+static int cache_slot(u16_t src, u32_t seq)
+{
+	u8_t data[4] = { seq >> 8, seq, src >> 8, src };
+	u32_t hash1 = seq >> 16;
+	u32_t hash2;
+
+	memcpy(&hash2, data, sizeof(hash2));
+
+	return (hash1 ^ hash2) % CACHE_INDEX_SIZE;
+}
+
+static void encode(int i, int slot)
+{
+	static const u8_t payload[] = { 0x00, 0x82, 0x01, 0x00, 0x00,
+					0x00, 0x00, 0x00, 0x00 };
+	static u32_t next;
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = 0,
+		.app_idx = BT_MESH_KEY_DEV,
+		.addr = DST,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = &bt_mesh.sub[0],
+		.ctx = &ctx,
+	};
+	int err;
+
+	/* Both byte orders of the hash reach every slot within a few
+	 * thousand candidates.
+	 */
+	do {
+		next++;
+		zassert_true(next < 0x10000, "No message for slot %d", slot);
+
+		msgs[i].src = SRC_BASE + next % CACHE_INDEX_SIZE;
+		msgs[i].seq = next;
+	} while (slot >= 0 && cache_slot(msgs[i].src, msgs[i].seq) != slot);
+
+	tx.src = msgs[i].src;
+	bt_mesh.seq = msgs[i].seq;
+
+	net_buf_simple_reserve(&buf, BT_MESH_NET_HDR_LEN);
+	net_buf_simple_add_mem(&buf, payload, sizeof(payload));
+
+	err = bt_mesh_net_encode(&tx, &buf, false);
+	zassert_equal(err, 0, "Cannot encode message %d (err %d)", i, err);
+
+	memcpy(msgs[i].data, buf.data, buf.len);
+	msgs[i].len = buf.len;
+}
+
+/* Repeated lookups of a message would otherwise be dropped by the
+ * duplicate cache before they reach the message cache.
+ */
+static void flush_dup_cache(void)
+{
+	static u8_t junk;
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	u8_t pdu[JUNK_LEN] = { 0 };
+	struct net_buf_simple data = {
+		.data = pdu,
+		.len = sizeof(pdu),
+		.size = sizeof(pdu),
+		.__buf = pdu,
+	};
+	struct bt_mesh_net_rx rx;
+	int err, i;
+
+	/* Matches no subnet, so the message cache is not touched */
+	pdu[0] = (bt_mesh.sub[0].keys[0].nid + 1) & 0x7f;
+
+	for (i = 0; i < DUP_CACHE_SIZE; i++) {
+		pdu[JUNK_LEN - 1] = ++junk;
+
+		(void)memset(&rx, 0, sizeof(rx));
+		err = bt_mesh_net_decode(&data, BT_MESH_NET_IF_ADV, &rx, &buf);
+		zassert_equal(err, -ENOENT, "Junk decoded (err %d)", err);
+	}
+}
+
+/* Receives message i and checks whether it hit the cache against the
+ * messages expected there. Returns the message it evicted, or -1.
+ */
+static int lookup(int i)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, PDU_LEN);
+	struct net_buf_simple data = {
+		.data = msgs[i].data,
+		.len = msgs[i].len,
+		.size = sizeof(msgs[i].data),
+		.__buf = msgs[i].data,
+	};
+	struct bt_mesh_net_rx rx;
+	int err, evicted, j;
+
+	flush_dup_cache();
+
+	(void)memset(&rx, 0, sizeof(rx));
+	err = bt_mesh_net_decode(&data, BT_MESH_NET_IF_ADV, &rx, &buf);
+
+	for (j = 0; j < CACHE_SIZE; j++) {
+		if (cached[j] == i) {
+			zassert_equal(err, -EALREADY,
+				      "Message %d not in the cache (err %d)",
+				      i, err);
+			return -1;
+		}
+	}
+
+	zassert_equal(err, 0, "Message %d in the cache (err %d)", i, err);
+
+	evicted = cached[cached_next];
+	cached[cached_next++] = i;
+	cached_next %= CACHE_SIZE;
+
+	return evicted;
+}
+
+static void test_msg_cache(void)
+{
+	int evicted, i, j;
+
+	/* The first half of the initial messages all hash to the last
+	 * slot and the second half to the first one, so that their probe
+	 * chain crosses the end of the index. The messages which evict
+	 * them hash to the last slot too, the remaining ones anywhere.
+	 */
+	for (i = 0; i < MSG_COUNT; i++) {
+		if (i < CACHE_SIZE / 2 ||
+		    (i >= CACHE_SIZE && i < 2 * CACHE_SIZE)) {
+			encode(i, CACHE_INDEX_SIZE - 1);
+		} else if (i < CACHE_SIZE) {
+			encode(i, 0);
+		} else {
+			encode(i, -1);
+		}
+	}
+
+	for (i = 0; i < MSG_COUNT; i++) {
+		evicted = lookup(i);
+
+		/* The evicted message is added back, evicting the next one */
+		if (evicted >= 0) {
+			(void)lookup(evicted);
+		}
+
+		for (j = 0; j < CACHE_SIZE; j++) {
+			if (cached[j] >= 0) {
+				(void)lookup(cached[j]);
+			}
+		}
+	}
+}
+
+static void rpl_fill(void)
+{
+	struct bt_mesh_rpl *rpl;
+	int i;
+
+	bt_mesh_rpl_clear();
+
+	for (i = 0; i < ARRAY_SIZE(rpl_src); i++) {
+		zassert_is_null(bt_mesh_rpl_find(rpl_src[i]),
+				"0x%04x in the list", rpl_src[i]);
+
+		rpl = bt_mesh_rpl_alloc(rpl_src[i]);
+		zassert_not_null(rpl, "Cannot allocate 0x%04x", rpl_src[i]);
+
+		rpl->seq = i + 1;
+	}
+}
+
+static void rpl_check(int i, bool old_iv)
+{
+	struct bt_mesh_rpl *rpl = bt_mesh_rpl_find(rpl_src[i]);
+
+	zassert_not_null(rpl, "0x%04x not found", rpl_src[i]);
+	zassert_equal(rpl->src, rpl_src[i], "src 0x%04x", rpl->src);
+	zassert_equal(rpl->seq, i + 1, "seq %u", rpl->seq);
+	zassert_equal(rpl->old_iv, old_iv, "old_iv %u", rpl->old_iv);
+}
+
+static void test_rpl_reset(void)
+{
+	int i;
+
+	rpl_fill();
+
+	for (i = 0; i < ARRAY_SIZE(rpl_src); i++) {
+		rpl_check(i, false);
+	}
+
+	/* Entries of the IV Index before the previous one are dropped,
+	 * including ones in front of others in their probe chain.
+	 */
+	bt_mesh_rpl_find(rpl_src[0])->old_iv = true;
+	bt_mesh_rpl_find(rpl_src[2])->old_iv = true;
+
+	bt_mesh_rpl_reset();
+
+	zassert_is_null(bt_mesh_rpl_find(rpl_src[0]), "0x%04x found",
+			rpl_src[0]);
+	zassert_is_null(bt_mesh_rpl_find(rpl_src[2]), "0x%04x found",
+			rpl_src[2]);
+	rpl_check(1, true);
+	rpl_check(3, true);
+	rpl_check(4, true);
+
+	bt_mesh_rpl_reset();
+
+	for (i = 0; i < ARRAY_SIZE(rpl_src); i++) {
+		zassert_is_null(bt_mesh_rpl_find(rpl_src[i]), "0x%04x found",
+				rpl_src[i]);
+	}
+
+	/* The freed entries are reused */
+	rpl_fill();
+
+	for (i = 0; i < ARRAY_SIZE(rpl_src); i++) {
+		rpl_check(i, false);
+	}
+}
+
+static void test_rpl_settings_delete(void)
+{
+#if defined(CONFIG_BT_SETTINGS)
+	char name[sizeof("bt/mesh/RPL/ffff")];
+	int err;
+
+	rpl_fill();
+
+	/* Deleting the head of the wrapping chain and an entry in its
+	 * middle leaves the others reachable.
+	 */
+	snprintk(name, sizeof(name), "bt/mesh/RPL/%x", rpl_src[0]);
+	err = settings_set_value(name, NULL, 0);
+	zassert_equal(err, 0, "Cannot delete %s (err %d)", name, err);
+
+	snprintk(name, sizeof(name), "bt/mesh/RPL/%x", rpl_src[3]);
+	err = settings_set_value(name, NULL, 0);
+	zassert_equal(err, 0, "Cannot delete %s (err %d)", name, err);
+
+	zassert_is_null(bt_mesh_rpl_find(rpl_src[0]), "0x%04x found",
+			rpl_src[0]);
+	zassert_is_null(bt_mesh_rpl_find(rpl_src[3]), "0x%04x found",
+			rpl_src[3]);
+	rpl_check(1, false);
+	rpl_check(2, false);
+	rpl_check(4, false);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_init(void)
+{
+	int err;
+
+	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+		err = bt_settings_init();
+		zassert_equal(err, 0, "Cannot initialize settings (err %d)",
+			      err);
+	}
+
+	err = bt_mesh_init(&prov, &comp);
+	zassert_equal(err, 0, "Cannot initialize mesh (err %d)", err);
+
+	/* Only the network keys are needed, not the whole provisioning */
+	err = bt_mesh_net_create(0, 0, net_key, 0);
+	zassert_equal(err, 0, "Cannot create network (err %d)", err);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mesh_cache,
+			 ztest_unit_test(test_init),
+			 ztest_unit_test(test_msg_cache),
+			 ztest_unit_test(test_rpl_reset),
+			 ztest_unit_test(test_rpl_settings_delete));
+
+	ztest_run_test_suite(mesh_cache);
+}
@@ -512,6 +512,46 @@ void test_timer_remaining_get(void)
 	zassert_true(remaining <= (DURATION / 2), NULL);
 }
 
+/**
+ * @brief Test listing timeouts expiring within a window
+ *
+ * Validates that k_timeout_expiring_within() reports a timer due
+ * inside the window, with an O(1) remaining time, and leaves out a
+ * timer due after it.
+ *
+ * @see k_timeout_expiring_within(), k_timer_remaining_get()
+ */
+void test_timeout_expiring_within(void)
+{
+	static struct k_timer late_timer;
+	struct _timeout *list[8];
+	bool found = false, found_late = false;
+	int n;
+
+	init_timer_data();
+	k_timer_init(&timer, NULL, NULL);
+	k_timer_init(&late_timer, NULL, NULL);
+	k_timer_start(&timer, DURATION, 0);
+	k_timer_start(&late_timer, DURATION * 10, 0);
+
+	n = k_timeout_expiring_within(z_ms_to_ticks(DURATION * 2), list,
+				      ARRAY_SIZE(list));
+	for (int i = 0; i < MIN(n, ARRAY_SIZE(list)); i++) {
+		found = found || (list[i] == &timer.timeout);
+		found_late = found_late || (list[i] == &late_timer.timeout);
+	}
+
+	zassert_true(k_timer_remaining_get(&timer) <= DURATION, NULL);
+	zassert_true(k_timer_remaining_get(&late_timer) > DURATION * 2, NULL);
+
+	k_timer_stop(&timer);
+	k_timer_stop(&late_timer);
+
+	zassert_true(n >= 1, NULL);
+	zassert_true(found, NULL);
+	zassert_false(found_late, NULL);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(timer_api,
@@ -524,6 +564,7 @@ void test_main(void)
 			 ztest_unit_test(test_timer_status_sync),
 			 ztest_unit_test(test_timer_k_define),
 			 ztest_unit_test(test_timer_user_data),
-			 ztest_unit_test(test_timer_remaining_get));
+			 ztest_unit_test(test_timer_remaining_get),
+			 ztest_unit_test(test_timeout_expiring_within));
 	ztest_run_test_suite(timer_api);
 }
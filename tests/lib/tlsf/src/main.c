@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+#include <string.h>
+#include <kernel_internal.h>
+#include <misc/tlsf.h>
+
+#define ARENA_SIZE 8192
+#define MAX_BLOCKS 128
+
+static char __aligned(sizeof(void *)) arena[ARENA_SIZE];
+static struct sys_tlsf heap;
+
+static void *blocks[MAX_BLOCKS];
+static size_t sizes[MAX_BLOCKS];
+
+static u32_t seed = 1U;
+
+static u32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+	return seed >> 8;
+}
+
+static u8_t pattern(int i)
+{
+	return (u8_t)(i * 7 + 1);
+}
+
+static void check_block(int i)
+{
+	u8_t *p = blocks[i];
+
+	for (size_t j = 0; j < sizes[i]; j++) {
+		zassert_equal(p[j], pattern(i), "block %d corrupted", i);
+	}
+}
+
+static size_t initial_free(void)
+{
+	struct sys_tlsf_stats stats;
+
+	sys_tlsf_init(&heap, arena, sizeof(arena));
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_equal(stats.free_bytes, stats.max_free_block,
+		      "fresh heap is not a single block");
+
+	return stats.free_bytes;
+}
+
+/**
+ * @brief Test basic allocation, alignment and whole-arena allocation
+ */
+void test_tlsf_alloc_free(void)
+{
+	size_t total = initial_free();
+	struct sys_tlsf_stats stats;
+	void *p, *q;
+
+	zassert_true(total > ARENA_SIZE - 8 * sizeof(void *),
+		     "too much overhead");
+	zassert_is_null(sys_tlsf_alloc(&heap, 0), "zero size allocated");
+	zassert_is_null(sys_tlsf_alloc(&heap, total + 1), "oversized alloc");
+
+	p = sys_tlsf_alloc(&heap, 1);
+	zassert_not_null(p, "alloc failed");
+	zassert_true(((uintptr_t)p & 7) == 0, "misaligned");
+	zassert_true(sys_tlsf_contains(&heap, p), "not in heap");
+	zassert_true(sys_tlsf_usable_size(p) >= 1, "usable size too small");
+
+	q = sys_tlsf_alloc(&heap, 100);
+	zassert_not_null(q, "alloc failed");
+	zassert_true(sys_tlsf_usable_size(q) >= 100, "usable size too small");
+	zassert_true((u8_t *)q >= (u8_t *)p + sys_tlsf_usable_size(p),
+		     "blocks overlap");
+
+	sys_tlsf_free(&heap, p);
+	sys_tlsf_free(&heap, q);
+	sys_tlsf_free(&heap, NULL);
+
+	/* Everything merged back: the whole arena is one block again */
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_equal(stats.free_bytes, total, "free bytes leaked");
+	zassert_equal(stats.max_free_block, total, "heap fragmented");
+
+	p = sys_tlsf_alloc(&heap, total);
+	zassert_not_null(p, "whole-arena alloc failed");
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_equal(stats.free_bytes, 0, "heap not empty");
+	zassert_is_null(sys_tlsf_alloc(&heap, 1), "alloc from empty heap");
+	sys_tlsf_free(&heap, p);
+}
+
+/**
+ * @brief Test random allocation patterns for corruption and leaks
+ */
+void test_tlsf_random(void)
+{
+	size_t total = initial_free();
+	struct sys_tlsf_stats stats;
+	int allocated = 0;
+
+	(void)memset(blocks, 0, sizeof(blocks));
+
+	for (int iter = 0; iter < 20000; iter++) {
+		int i = next_rand() % MAX_BLOCKS;
+
+		if (blocks[i] == NULL) {
+			sizes[i] = 1 + next_rand() % 300;
+			blocks[i] = sys_tlsf_alloc(&heap, sizes[i]);
+			if (blocks[i] != NULL) {
+				zassert_true(((uintptr_t)blocks[i] & 7) == 0,
+					     "misaligned");
+				(void)memset(blocks[i], pattern(i), sizes[i]);
+				allocated++;
+			}
+		} else {
+			check_block(i);
+			sys_tlsf_free(&heap, blocks[i]);
+			blocks[i] = NULL;
+		}
+	}
+
+	zassert_true(allocated > MAX_BLOCKS, "too few allocations");
+
+	for (int i = 0; i < MAX_BLOCKS; i++) {
+		if (blocks[i] != NULL) {
+			check_block(i);
+			sys_tlsf_free(&heap, blocks[i]);
+			blocks[i] = NULL;
+		}
+	}
+
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_equal(stats.free_bytes, total, "free bytes leaked");
+	zassert_equal(stats.max_free_block, total, "heap fragmented");
+}
+
+/**
+ * @brief Test in-place and moving reallocation
+ */
+void test_tlsf_realloc(void)
+{
+	size_t total = initial_free();
+	struct sys_tlsf_stats stats;
+	void *p, *q, *r;
+
+	p = sys_tlsf_alloc(&heap, 64);
+	(void)memset(p, 0xa5, 64);
+
+	/* Nothing after p is allocated: grow in place */
+	q = sys_tlsf_realloc(&heap, p, 512);
+	zassert_equal_ptr(p, q, "grow did not happen in place");
+	for (int i = 0; i < 64; i++) {
+		zassert_equal(((u8_t *)q)[i], 0xa5, "data lost");
+	}
+
+	/* Shrink in place and give the tail back */
+	q = sys_tlsf_realloc(&heap, q, 32);
+	zassert_equal_ptr(p, q, "shrink moved the block");
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_true(stats.free_bytes >=
+		     total - ROUND_UP(32 + sizeof(void *), 8),
+		     "tail not released");
+
+	/* Block right behind: must move */
+	r = sys_tlsf_alloc(&heap, 16);
+	q = sys_tlsf_realloc(&heap, p, 256);
+	zassert_not_null(q, "realloc failed");
+	zassert_not_equal(p, q, "block did not move");
+	for (int i = 0; i < 32; i++) {
+		zassert_equal(((u8_t *)q)[i], 0xa5, "data lost");
+	}
+
+	zassert_is_null(sys_tlsf_realloc(&heap, q, total), "oversized");
+	zassert_is_null(sys_tlsf_realloc(&heap, q, 0), "zero size");
+	sys_tlsf_free(&heap, r);
+
+	sys_tlsf_stats_get(&heap, &stats);
+	zassert_equal(stats.free_bytes, total, "free bytes leaked");
+}
+
+/**
+ * @brief Test k_malloc() and k_free() when backed by a TLSF heap
+ */
+void test_tlsf_k_malloc(void)
+{
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+	void *p[8];
+
+	/* The buddy allocator would round these up to 1024 bytes and
+	 * only fit four of them
+	 */
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = k_malloc(300);
+		zassert_not_null(p[i], "k_malloc failed");
+	}
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		k_free(p[i]);
+	}
+
+	k_thread_system_pool_assign(k_current_get());
+	p[0] = z_thread_malloc(CONFIG_HEAP_MEM_POOL_SIZE / 2);
+	zassert_not_null(p[0], "system pool allocation failed");
+	k_free(p[0]);
+	zassert_is_null(z_thread_malloc(CONFIG_HEAP_MEM_POOL_SIZE * 2),
+			"overflow check failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_tlsf,
+			 ztest_unit_test(test_tlsf_alloc_free),
+			 ztest_unit_test(test_tlsf_random),
+			 ztest_unit_test(test_tlsf_realloc),
+			 ztest_unit_test(test_tlsf_k_malloc));
+	ztest_run_test_suite(test_tlsf);
+}
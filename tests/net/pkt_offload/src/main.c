@@ -0,0 +1,470 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define NET_LOG_LEVEL CONFIG_NET_L2_ETHERNET_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/net_ip.h>
+#include <net/net_l2.h>
+#include <net/net_pkt.h>
+
+#include "ipv4.h"
+#include "icmpv4.h"
+#include "connection.h"
+#include "tcp_internal.h"
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#define LOCAL_PORT 4242
+#define PEER_PORT 9999
+
+#define GSO_SIZE 536
+#define GSO_DATA_LEN 2000
+#define GSO_SEQ 1000U
+
+#define MAX_SEGMENTS 8
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+
+/* Segments handed to the driver, without their Ethernet header */
+static u8_t segments[MAX_SEGMENTS][NET_ETH_MTU];
+static size_t segment_lens[MAX_SEGMENTS];
+static int segment_count;
+static int fail_segment = -1;
+static bool capture;
+
+static u8_t test_data[GSO_DATA_LEN];
+
+static int received;
+
+struct eth_context {
+	u8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->driver_data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt) - sizeof(struct net_eth_hdr);
+
+	if (!capture) {
+		return 0;
+	}
+
+	if (segment_count == fail_segment) {
+		return -EIO;
+	}
+
+	zassert_true(segment_count < MAX_SEGMENTS, "Too many segments");
+	zassert_true(len <= NET_ETH_MTU, "Segment larger than the MTU");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_pkt_skip(pkt, sizeof(struct net_eth_hdr)), 0,
+		      "No Ethernet header");
+	zassert_equal(net_pkt_read(pkt, segments[segment_count], len), 0,
+		      "Cannot read segment");
+
+	segment_lens[segment_count++] = len;
+
+	return 0;
+}
+
+/* Neither TSO nor checksum offload: the stack does everything */
+static enum ethernet_hw_caps eth_capabilities(struct device *dev)
+{
+	return 0;
+}
+
+static struct ethernet_api api_funcs = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_capabilities,
+	.send = eth_tx,
+};
+
+static int eth_init(struct device *dev)
+{
+	struct eth_context *context = dev->driver_data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_pkt_offload_test, "eth_pkt_offload_test",
+		    eth_init, &eth_context, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &api_funcs, NET_ETH_MTU);
+
+static void iface_cb(struct net_if *iface_found, void *user_data)
+{
+	if (net_if_get_device(iface_found)->driver_data == &eth_context) {
+		iface = iface_found;
+	}
+}
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+	int i;
+
+	net_if_foreach(iface_cb, NULL);
+	zassert_not_null(iface, "Interface not found");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface);
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = i;
+	}
+}
+
+static size_t free_tx_pkts(void)
+{
+	struct k_mem_slab *rx, *tx;
+	struct net_buf_pool *rx_data, *tx_data;
+
+	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
+
+	return k_mem_slab_num_free_get(tx);
+}
+
+static struct net_pkt *gso_pkt(u8_t flags)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_gso_size(pkt, GSO_SIZE);
+
+	zassert_equal(net_pkt_alloc_buffer(pkt, GSO_DATA_LEN, IPPROTO_TCP,
+					   K_NO_WAIT), 0,
+		      "Cannot allocate buffer");
+
+	zassert_equal(net_ipv4_create(pkt, &my_addr, &peer_addr), 0,
+		      "Cannot create IPv4 header");
+
+	tcp_hdr.src_port = htons(LOCAL_PORT);
+	tcp_hdr.dst_port = htons(PEER_PORT);
+	sys_put_be32(GSO_SEQ, tcp_hdr.seq);
+	tcp_hdr.offset = (sizeof(tcp_hdr) / 4U) << 4;
+	tcp_hdr.flags = flags;
+	sys_put_be16(NET_TCP_MAX_WIN, tcp_hdr.wnd);
+
+	zassert_equal(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), 0,
+		      "Cannot write TCP header");
+	zassert_equal(net_pkt_write(pkt, test_data, sizeof(test_data)), 0,
+		      "Cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, IPPROTO_TCP), 0,
+		      "Cannot finalize packet");
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void gso_send(struct net_pkt *pkt, int fail_at)
+{
+	segment_count = 0;
+	fail_segment = fail_at;
+	capture = true;
+
+	if (net_if_l2(iface)->send(iface, pkt) < 0) {
+		/* The packet is still ours on error */
+		net_pkt_unref(pkt);
+	}
+
+	capture = false;
+	fail_segment = -1;
+}
+
+/* Check a segment with the checksum functions of the stack */
+static void check_segment_chksums(int n)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, segment_lens[n], AF_INET,
+					IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_equal(net_pkt_write(pkt, segments[n], segment_lens[n]), 0,
+		      "Cannot write segment");
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv4_hdr));
+	net_pkt_cursor_init(pkt);
+
+	zassert_equal(net_calc_chksum_ipv4(pkt), 0,
+		      "Segment %d: invalid IPv4 checksum", n);
+	zassert_equal(net_calc_chksum_tcp(pkt), 0,
+		      "Segment %d: invalid TCP checksum", n);
+
+	net_pkt_unref(pkt);
+}
+
+static void test_gso_segments(void)
+{
+	size_t free_pkts = free_tx_pkts();
+	size_t offset = 0;
+	int i;
+
+	gso_send(gso_pkt(NET_TCP_ACK | NET_TCP_PSH | NET_TCP_FIN), -1);
+
+	zassert_equal(segment_count, DIV_ROUND_UP(GSO_DATA_LEN, GSO_SIZE),
+		      "Wrong number of segments (%d)", segment_count);
+
+	for (i = 0; i < segment_count; i++) {
+		struct net_ipv4_hdr *ip_hdr =
+			(struct net_ipv4_hdr *)segments[i];
+		struct net_tcp_hdr *tcp_hdr =
+			(struct net_tcp_hdr *)(segments[i] + sizeof(*ip_hdr));
+		size_t hdr_len = sizeof(*ip_hdr) + NET_TCP_HDR_LEN(tcp_hdr);
+		size_t len = MIN(GSO_SIZE, GSO_DATA_LEN - offset);
+		bool last = i == segment_count - 1;
+
+		zassert_equal(segment_lens[i], hdr_len + len,
+			      "Segment %d: wrong length", i);
+		zassert_equal(ntohs(ip_hdr->len), hdr_len + len,
+			      "Segment %d: wrong IPv4 length", i);
+		zassert_equal(sys_get_be32(tcp_hdr->seq), GSO_SEQ + offset,
+			      "Segment %d: wrong sequence number", i);
+		zassert_equal(tcp_hdr->flags,
+			      last ? NET_TCP_ACK | NET_TCP_PSH | NET_TCP_FIN :
+			      NET_TCP_ACK,
+			      "Segment %d: wrong flags 0x%02x", i,
+			      tcp_hdr->flags);
+		zassert_mem_equal(segments[i] + hdr_len, test_data + offset,
+				  len, "Segment %d: wrong data", i);
+
+		check_segment_chksums(i);
+
+		offset += len;
+	}
+
+	zassert_equal(free_tx_pkts(), free_pkts, "Packets leaked");
+}
+
+static void test_gso_partial_failure(void)
+{
+	size_t free_pkts = free_tx_pkts();
+
+	gso_send(gso_pkt(NET_TCP_ACK | NET_TCP_PSH), 2);
+
+	/* The segments before the failing one are sent, then it stops */
+	zassert_equal(segment_count, 2, "Wrong number of segments (%d)",
+		      segment_count);
+	zassert_equal(free_tx_pkts(), free_pkts, "Packets leaked");
+}
+
+static enum net_verdict conn_cb(struct net_conn *conn,
+				struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	received++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static enum net_verdict icmp_cb(struct net_pkt *pkt,
+				struct net_ipv4_hdr *ip_hdr,
+				struct net_icmp_hdr *icmp_hdr)
+{
+	received++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static struct net_icmpv4_handler echo_reply_handler = {
+	.type = NET_ICMPV4_ECHO_REPLY,
+	.code = 0,
+	.handler = icmp_cb,
+};
+
+/* Builds a received packet whose IPv4 and upper layer checksums are
+ * both wrong
+ */
+static struct net_pkt *corrupt_pkt(u8_t proto)
+{
+	union {
+		struct net_udp_hdr udp;
+		struct net_tcp_hdr tcp;
+		struct {
+			struct net_icmp_hdr hdr;
+			u8_t echo[4];
+		} icmp;
+	} hdr = { 0 };
+	struct net_ipv4_hdr *ip_hdr;
+	size_t hdr_len, data_len = 64;
+	struct net_pkt *pkt;
+	u16_t *chksum;
+
+	if (proto == IPPROTO_UDP) {
+		hdr.udp.src_port = htons(PEER_PORT);
+		hdr.udp.dst_port = htons(LOCAL_PORT);
+		hdr.udp.len = htons(sizeof(hdr.udp) + data_len);
+		hdr_len = sizeof(hdr.udp);
+		chksum = &hdr.udp.chksum;
+	} else if (proto == IPPROTO_TCP) {
+		hdr.tcp.src_port = htons(PEER_PORT);
+		hdr.tcp.dst_port = htons(LOCAL_PORT);
+		hdr.tcp.offset = (sizeof(hdr.tcp) / 4U) << 4;
+		hdr.tcp.flags = NET_TCP_ACK;
+		hdr_len = sizeof(hdr.tcp);
+		chksum = &hdr.tcp.chksum;
+	} else {
+		hdr.icmp.hdr.type = NET_ICMPV4_ECHO_REPLY;
+		hdr_len = sizeof(hdr.icmp);
+		chksum = &hdr.icmp.hdr.chksum;
+	}
+
+	pkt = net_pkt_alloc_with_buffer(iface, hdr_len + data_len, AF_INET,
+					proto, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_equal(net_ipv4_create(pkt, &peer_addr, &my_addr), 0,
+		      "Cannot create IPv4 header");
+	zassert_equal(net_pkt_write(pkt, &hdr, hdr_len), 0,
+		      "Cannot write header");
+	zassert_equal(net_pkt_write(pkt, test_data, data_len), 0,
+		      "Cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, proto), 0,
+		      "Cannot finalize packet");
+
+	/* Corrupt both checksums, the headers are in the first buffer */
+	ip_hdr = NET_IPV4_HDR(pkt);
+	ip_hdr->chksum ^= 0x5a5a;
+	chksum = (u16_t *)((u8_t *)ip_hdr + sizeof(*ip_hdr) +
+			   ((u8_t *)chksum - (u8_t *)&hdr));
+	UNALIGNED_PUT(UNALIGNED_GET(chksum) ^ 0x5a5a, chksum);
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void check_chksum_verified(u8_t proto)
+{
+	struct net_pkt *pkt;
+
+	/* Without the mark, the checksums are checked */
+	received = 0;
+	pkt = corrupt_pkt(proto);
+	zassert_equal(net_ipv4_input(pkt), NET_DROP,
+		      "Corrupt packet accepted");
+	net_pkt_unref(pkt);
+	zassert_equal(received, 0, "Corrupt packet delivered");
+
+	/* With the mark, they are not checked again */
+	pkt = corrupt_pkt(proto);
+	net_pkt_set_chksum_verified(pkt, true);
+	zassert_equal(net_ipv4_input(pkt), NET_OK,
+		      "Verified packet dropped");
+	zassert_equal(received, 1, "Verified packet not delivered");
+}
+
+static void test_chksum_verified_udp(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+	};
+	struct net_conn_handle *handle;
+
+	zassert_equal(net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+					(struct sockaddr *)&local, 0,
+					LOCAL_PORT, conn_cb, NULL, &handle),
+		      0, "Cannot register UDP handler");
+
+	check_chksum_verified(IPPROTO_UDP);
+
+	net_conn_unregister(handle);
+}
+
+static void test_chksum_verified_tcp(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+	};
+	struct net_conn_handle *handle;
+
+	zassert_equal(net_conn_register(IPPROTO_TCP, AF_INET, NULL,
+					(struct sockaddr *)&local, 0,
+					LOCAL_PORT, conn_cb, NULL, &handle),
+		      0, "Cannot register TCP handler");
+
+	check_chksum_verified(IPPROTO_TCP);
+
+	net_conn_unregister(handle);
+}
+
+static void test_chksum_verified_icmp(void)
+{
+	net_icmpv4_register_handler(&echo_reply_handler);
+
+	check_chksum_verified(IPPROTO_ICMP);
+
+	net_icmpv4_unregister_handler(&echo_reply_handler);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_pkt_offload_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_gso_segments),
+			 ztest_unit_test(test_gso_partial_failure),
+			 ztest_unit_test(test_chksum_verified_udp),
+			 ztest_unit_test(test_chksum_verified_tcp),
+			 ztest_unit_test(test_chksum_verified_icmp)
+			 );
+
+	ztest_run_test_suite(net_pkt_offload_test);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <ztest_assert.h>
+
+#include <net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define TEST_STR_SMALL "test"
+
+#define SERVER_PORT 4242
+#define SERVER_PORT2 4243
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait takes +10ms from the requested time. */
+#define FUZZ 10
+
+static int epoll_add(int ep, int op, int sock, u32_t events)
+{
+	struct zsock_epoll_event event = {
+		.events = events,
+		.data.fd = sock,
+	};
+
+	return zsock_epoll_ctl(ep, op, sock, &event);
+}
+
+void test_epoll(void)
+{
+	int res;
+	int ep;
+	int c_sock;
+	int s_sock;
+	int s_sock2;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct sockaddr_in6 s_addr2;
+	struct zsock_epoll_event events[2];
+	u32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT2,
+			    &s_sock2, &s_addr2);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+	res = bind(s_sock2, (struct sockaddr *)&s_addr2, sizeof(s_addr2));
+	zassert_equal(res, 0, "bind failed");
+
+	ep = zsock_epoll_create();
+	zassert_true(ep >= 0, "epoll_create failed");
+
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_ADD, s_sock, POLLIN);
+	zassert_equal(res, 0, "epoll_ctl failed");
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_ADD, s_sock2, POLLIN);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_ADD, s_sock, POLLIN);
+	zassert_equal(res, -1, "double add accepted");
+	zassert_equal(errno, EEXIST, "");
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_MOD, c_sock, POLLIN);
+	zassert_equal(res, -1, "unregistered socket modified");
+	zassert_equal(errno, ENOENT, "");
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_ADD, ep, POLLIN);
+	zassert_equal(res, -1, "set added to itself");
+
+
+	/* Nothing ready, with timeout of 0 and 30 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ, "");
+	zassert_equal(res, 0, "");
+
+
+	/* Send pkt for s_sock2 and wait */
+	len = sendto(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		     (struct sockaddr *)&s_addr2, sizeof(s_addr2));
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, POLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock2, "");
+
+	/* Level-triggered: still ready until the data is read */
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock2, "");
+
+	len = recv(s_sock2, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+
+	/* A removed socket is no longer reported */
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	len = sendto(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		     (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	/* Registering it again picks up the pending data right away */
+	res = epoll_add(ep, ZSOCK_EPOLL_CTL_ADD, s_sock, POLLIN | POLLOUT);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, POLLIN | POLLOUT, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+
+	/* Closed sockets leave the set */
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = close(ep);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(s_sock2);
+	zassert_equal(res, 0, "close failed");
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_epoll,
+			 ztest_unit_test(test_epoll));
+
+	ztest_run_test_suite(socket_epoll);
+}
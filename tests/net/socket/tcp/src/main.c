@@ -9,8 +9,13 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <ztest_assert.h>
 #include <net/socket.h>
+#include <net/net_pkt.h>
+#include <net/loopback.h>
+#include <net/net_stats.h>
+#include <misc/fdtable.h>
 
 #include "../../socket_helpers.h"
+#include "tcp_internal.h"
 
 #define TEST_STR_SMALL "test"
 
@@ -352,6 +357,270 @@ void test_v6_sendto_recvfrom_null_dest(void)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+void test_v4_recv_pkt(void)
+{
+	/* Test zero-copy receive, after a partial recv() */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_pkt *pkt;
+	char rx_buf[8];
+	ssize_t len;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	len = zsock_recv_pkt(new_sock, &pkt, MSG_PEEK);
+	zassert_equal(len, -1, "MSG_PEEK accepted");
+	zassert_equal(errno, EINVAL, "unexpected errno");
+
+	len = recv(new_sock, rx_buf, 1, 0);
+	zassert_equal(len, 1, "recv failed");
+
+	len = zsock_recv_pkt(new_sock, &pkt, 0);
+	zassert_equal(len, strlen(TEST_STR_SMALL) - 1, "unexpected length");
+	zassert_not_null(pkt, "no packet");
+	zassert_equal(net_pkt_read(pkt, rx_buf + 1, len), 0, "read failed");
+	zassert_equal(strncmp(rx_buf, TEST_STR_SMALL, strlen(TEST_STR_SMALL)),
+		      0, "unexpected data");
+	zsock_recv_pkt_release(pkt);
+
+	len = zsock_recv_pkt(new_sock, &pkt, MSG_DONTWAIT);
+	zassert_equal(len, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "unexpected errno");
+
+	test_close(c_sock);
+
+	len = zsock_recv_pkt(new_sock, &pkt, 0);
+	zassert_equal(len, 0, "EOF not detected");
+	zassert_is_null(pkt, "packet returned at EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#define REORDER_CHUNKS 16
+#define REORDER_CHUNK_LEN 32
+
+static u32_t tcp_ooo_queued(void)
+{
+	struct net_stats_tcp stats;
+
+	zassert_equal(net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &stats,
+			       sizeof(stats)), 0, "cannot read statistics");
+
+	return stats.ooo_queued;
+}
+
+void test_v4_reorder(void)
+{
+	/* Test that segments arriving out of order are delivered in order */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	static u8_t tx_buf[REORDER_CHUNKS * REORDER_CHUNK_LEN];
+	static u8_t rx_buf[REORDER_CHUNKS * REORDER_CHUNK_LEN];
+	size_t recved = 0;
+	u32_t ooo_queued;
+	ssize_t len;
+	int i;
+
+	for (i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ooo_queued = tcp_ooo_queued();
+	loopback_set_packet_reorder_interval(3);
+
+	for (i = 0; i < REORDER_CHUNKS; i++) {
+		test_send(c_sock, tx_buf + i * REORDER_CHUNK_LEN,
+			  REORDER_CHUNK_LEN, 0);
+	}
+
+	while (recved < sizeof(rx_buf)) {
+		len = recv(new_sock, rx_buf + recved, sizeof(rx_buf) - recved,
+			   0);
+		zassert_true(len > 0, "recv failed");
+		recved += len;
+	}
+
+	loopback_set_packet_reorder_interval(0);
+
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(tx_buf), "data mismatch");
+	/* The reordered segments must have been kept, not retransmitted */
+	zassert_true(tcp_ooo_queued() > ooo_queued,
+		     "no segment queued out of order");
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+/* All the TCP options fit in 40 bytes */
+#define TCP_OPT_MAX_LEN 40
+
+/* Reads the TCP options of the ACK the connection would send now */
+static int ack_options(struct net_context *ctx, u8_t *opts)
+{
+	struct net_tcp_hdr hdr;
+	struct net_pkt *pkt;
+	int len;
+
+	zassert_equal(net_tcp_prepare_ack(ctx->tcp, &ctx->remote, &pkt), 0,
+		      "cannot prepare ACK");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt)), 0, "");
+	zassert_equal(net_pkt_read(pkt, &hdr, sizeof(hdr)), 0, "");
+	zassert_equal(NET_TCP_FLAGS((&hdr)), NET_TCP_ACK, "not an ACK");
+
+	len = NET_TCP_HDR_LEN(&hdr) - sizeof(hdr);
+	zassert_true(len <= TCP_OPT_MAX_LEN, "options too long");
+	zassert_equal(net_pkt_read(pkt, opts, len), 0, "");
+
+	net_pkt_unref(pkt);
+
+	return len;
+}
+
+static void check_sack_block(const u8_t *block, u32_t left, u32_t right)
+{
+	zassert_equal(sys_get_be32(block), left, "left edge %u instead of %u",
+		      sys_get_be32(block), left);
+	zassert_equal(sys_get_be32(block + 4), right,
+		      "right edge %u instead of %u", sys_get_be32(block + 4),
+		      right);
+}
+
+void test_v4_sack(void)
+{
+	/* Test SACK-permitted negotiation and the SACK option of ACKs */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	u8_t opts[TCP_OPT_MAX_LEN];
+	struct net_context *c_ctx;
+	struct net_context *s_ctx;
+	struct net_tcp *tcp;
+	u32_t rcv_nxt;
+	int len;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* The SYN offered SACK and the SYN-ACK accepted it */
+	c_ctx = z_get_fd_obj(c_sock, NULL, 0);
+	s_ctx = z_get_fd_obj(new_sock, NULL, 0);
+	zassert_not_null(c_ctx, "no client context");
+	zassert_not_null(s_ctx, "no server context");
+	zassert_true(c_ctx->tcp->flags & NET_TCP_SACK_PERMITTED,
+		     "SACK not permitted by the SYN-ACK");
+	zassert_true(s_ctx->tcp->flags & NET_TCP_SACK_PERMITTED,
+		     "SACK not permitted by the SYN");
+
+	/* Nothing is in flight, queue fake out-of-order segments on
+	 * the server side, they only need a sequence number and length.
+	 */
+	tcp = s_ctx->tcp;
+	rcv_nxt = tcp->send_ack;
+
+	len = ack_options(s_ctx, opts);
+	zassert_equal(len, 0, "options without out-of-order data");
+
+	/* One hole */
+	tcp->ooo[0].seq = rcv_nxt + 100;
+	tcp->ooo[0].len = 50;
+	tcp->ooo_count = 1;
+	tcp->ooo_last_seq = rcv_nxt + 100;
+
+	len = ack_options(s_ctx, opts);
+	zassert_equal(len, 12, "option length %d", len);
+	zassert_equal(opts[0], NET_TCP_NOP_OPT, "");
+	zassert_equal(opts[1], NET_TCP_NOP_OPT, "");
+	zassert_equal(opts[2], NET_TCP_SACK_OPT, "not a SACK option");
+	zassert_equal(opts[3], 10, "SACK length %u", opts[3]);
+	check_sack_block(opts + 4, rcv_nxt + 100, rcv_nxt + 150);
+
+	/* Two holes, with adjacent segments merged into one block and
+	 * the block of the latest segment first, RFC 2018 section 4.
+	 */
+	tcp->ooo[1].seq = rcv_nxt + 300;
+	tcp->ooo[1].len = 50;
+	tcp->ooo[2].seq = rcv_nxt + 350;
+	tcp->ooo[2].len = 20;
+	tcp->ooo_count = 3;
+	tcp->ooo_last_seq = rcv_nxt + 350;
+
+	len = ack_options(s_ctx, opts);
+	zassert_equal(len, 20, "option length %d", len);
+	zassert_equal(opts[2], NET_TCP_SACK_OPT, "not a SACK option");
+	zassert_equal(opts[3], 18, "SACK length %u", opts[3]);
+	check_sack_block(opts + 4, rcv_nxt + 300, rcv_nxt + 370);
+	check_sack_block(opts + 12, rcv_nxt + 100, rcv_nxt + 150);
+
+	/* No SACK option when the peer did not permit it */
+	tcp->flags &= ~NET_TCP_SACK_PERMITTED;
+	len = ack_options(s_ctx, opts);
+	zassert_equal(len, 0, "SACK option sent without permission");
+
+	tcp->ooo_count = 0;
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_tcp,
@@ -360,7 +629,10 @@ void test_main(void)
 			 ztest_user_unit_test(test_v4_sendto_recvfrom),
 			 ztest_user_unit_test(test_v6_sendto_recvfrom),
 			 ztest_user_unit_test(test_v4_sendto_recvfrom_null_dest),
-			 ztest_user_unit_test(test_v6_sendto_recvfrom_null_dest));
+			 ztest_user_unit_test(test_v6_sendto_recvfrom_null_dest),
+			 ztest_unit_test(test_v4_recv_pkt),
+			 ztest_unit_test(test_v4_reorder),
+			 ztest_unit_test(test_v4_sack));
 
 	ztest_run_test_suite(socket_tcp);
 }
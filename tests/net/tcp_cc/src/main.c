@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <string.h>
+#include <net/net_ip.h>
+
+#include "tcp_internal.h"
+
+/* The congestion control state of a connection is driven directly,
+ * with segments of MSS bytes starting at ISN and a constant peer
+ * window, so that every step can be checked against the RFCs.
+ */
+
+#define MSS 1000U
+#define ISN 1000U
+#define WND 0xffffU
+
+#define RTO_MIN CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT
+
+static struct net_tcp tcp;
+
+static void setup(const struct net_tcp_cc *cc)
+{
+	(void)memset(&tcp, 0, sizeof(tcp));
+	tcp.send_mss = MSS;
+	tcp.send_seq = ISN;
+
+	net_tcp_cc_init(&tcp);
+
+	/* Test the given algorithm whatever the configured one is */
+	tcp.cc = cc;
+	if (cc->init) {
+		cc->init(&tcp);
+	}
+
+	tcp.send_wnd = WND;
+}
+
+static void send_segments(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_true(net_tcp_cc_can_send(&tcp, MSS),
+			     "segment %d not allowed, cwnd %u", i, tcp.cwnd);
+		net_tcp_cc_sent(&tcp, tcp.snd_nxt, MSS);
+	}
+}
+
+static bool ack(u32_t seq)
+{
+	return net_tcp_cc_ack(&tcp, seq, WND, false);
+}
+
+static bool dup_ack(void)
+{
+	return net_tcp_cc_ack(&tcp, tcp.snd_una, WND, true);
+}
+
+static void test_slow_start(void)
+{
+	setup(&net_tcp_cc_newreno);
+
+	/* RFC 5681 section 3.1, 4 segments for an MSS up to 1095 bytes */
+	zassert_equal(tcp.cwnd, 4 * MSS, "initial window %u", tcp.cwnd);
+	zassert_equal(tcp.ssthresh, 0xffff, "initial ssthresh %u",
+		      tcp.ssthresh);
+
+	send_segments(4);
+	zassert_false(net_tcp_cc_can_send(&tcp, MSS), "window exceeded");
+
+	/* One segment more per ACK ... */
+	zassert_false(ack(ISN + MSS), "unexpected retransmission");
+	zassert_equal(tcp.cwnd, 5 * MSS, "cwnd %u", tcp.cwnd);
+
+	/* ... even when it covers two segments, RFC 3465 with L = 1 */
+	ack(ISN + 3 * MSS);
+	zassert_equal(tcp.cwnd, 6 * MSS, "cwnd %u", tcp.cwnd);
+
+	ack(ISN + 4 * MSS);
+	zassert_equal(tcp.cwnd, 7 * MSS, "cwnd %u", tcp.cwnd);
+}
+
+static void test_congestion_avoidance(void)
+{
+	setup(&net_tcp_cc_newreno);
+	tcp.cwnd = 10 * MSS;
+	tcp.ssthresh = 10 * MSS;
+
+	send_segments(10);
+
+	/* One segment more once a whole window was acknowledged */
+	for (int i = 1; i < 10; i++) {
+		ack(ISN + i * MSS);
+		zassert_equal(tcp.cwnd, 10 * MSS, "cwnd %u after %d ACKs",
+			      tcp.cwnd, i);
+	}
+
+	ack(ISN + 10 * MSS);
+	zassert_equal(tcp.cwnd, 11 * MSS, "cwnd %u", tcp.cwnd);
+}
+
+static void test_fast_recovery(void)
+{
+	setup(&net_tcp_cc_newreno);
+	tcp.cwnd = 10 * MSS;
+
+	send_segments(10);
+
+	zassert_false(dup_ack(), "retransmission on the first dup ACK");
+	zassert_false(dup_ack(), "retransmission on the second dup ACK");
+	zassert_equal(tcp.cwnd, 10 * MSS, "cwnd %u", tcp.cwnd);
+
+	/* RFC 5681 section 3.2 steps 2 and 3 */
+	zassert_true(dup_ack(), "no fast retransmit");
+	zassert_equal(tcp.ssthresh, 5 * MSS, "ssthresh %u", tcp.ssthresh);
+	zassert_equal(tcp.cwnd, 8 * MSS, "cwnd %u", tcp.cwnd);
+	zassert_true(net_tcp_cc_recovering(&tcp), "not in recovery");
+
+	/* Step 4, inflate the window */
+	zassert_false(dup_ack(), "retransmission on a later dup ACK");
+	zassert_equal(tcp.cwnd, 9 * MSS, "cwnd %u", tcp.cwnd);
+
+	/* RFC 6582 section 3.2 step 3, partial acknowledgment: deflate
+	 * by the 2 segments acked and add one back.
+	 */
+	zassert_true(ack(ISN + 2 * MSS), "no retransmission of the hole");
+	zassert_equal(tcp.cwnd, 8 * MSS, "cwnd %u", tcp.cwnd);
+	zassert_true(net_tcp_cc_recovering(&tcp), "left recovery");
+
+	/* Full acknowledgment, min(ssthresh, FlightSize + MSS) */
+	zassert_false(ack(ISN + 10 * MSS), "unexpected retransmission");
+	zassert_equal(tcp.cwnd, 2 * MSS, "cwnd %u", tcp.cwnd);
+	zassert_false(net_tcp_cc_recovering(&tcp), "still in recovery");
+
+	/* Step 2, no new recovery for duplicates of the recovered ACK */
+	send_segments(2);
+	for (int i = 0; i < 3; i++) {
+		zassert_false(dup_ack(), "recovery entered again");
+	}
+	zassert_equal(tcp.ssthresh, 5 * MSS, "ssthresh %u", tcp.ssthresh);
+}
+
+static void test_timeout(void)
+{
+	setup(&net_tcp_cc_newreno);
+	tcp.cwnd = 10 * MSS;
+
+	send_segments(10);
+
+	/* RFC 5681 section 3.1, equation 4 and loss window */
+	net_tcp_cc_timeout(&tcp);
+	zassert_equal(tcp.ssthresh, 5 * MSS, "ssthresh %u", tcp.ssthresh);
+	zassert_equal(tcp.cwnd, MSS, "cwnd %u", tcp.cwnd);
+	zassert_true(net_tcp_cc_recovering(&tcp), "not in recovery");
+
+	/* Go back N in slow start */
+	zassert_true(ack(ISN + MSS), "no retransmission of the next one");
+	zassert_equal(tcp.cwnd, 2 * MSS, "cwnd %u", tcp.cwnd);
+
+	/* ssthresh is only reduced by the first of back to back
+	 * timeouts, the second one would halve 9 segments.
+	 */
+	net_tcp_cc_timeout(&tcp);
+	zassert_equal(tcp.ssthresh, 5 * MSS, "ssthresh %u", tcp.ssthresh);
+	zassert_equal(tcp.cwnd, MSS, "cwnd %u", tcp.cwnd);
+
+	zassert_false(ack(ISN + 10 * MSS), "unexpected retransmission");
+	zassert_false(net_tcp_cc_recovering(&tcp), "still in recovery");
+}
+
+static void test_rtt(void)
+{
+	u32_t rtt, srtt, rto;
+
+	setup(&net_tcp_cc_newreno);
+	zassert_equal(net_tcp_cc_rto(&tcp), RTO_MIN, "initial RTO");
+
+	/* RFC 6298 section 2.2, first measurement of R = 1 s:
+	 * SRTT = R, RTTVAR = R / 2, RTO = SRTT + 4 * RTTVAR
+	 */
+	send_segments(1);
+	tcp.rtt_start -= 1000U;
+	ack(ISN + MSS);
+
+	/* The clock can tick while the ACK is processed */
+	rtt = tcp.srtt >> 3;
+	zassert_true(rtt >= 1000U && rtt <= 1001U, "srtt %u", rtt);
+	zassert_equal(tcp.rttvar, rtt << 1, "rttvar %u", tcp.rttvar >> 2);
+	zassert_equal(net_tcp_cc_rto(&tcp), 3 * rtt, "rto %u",
+		      net_tcp_cc_rto(&tcp));
+
+	/* Section 2.3, next measurement of R' = 0.5 s:
+	 * RTTVAR = 3/4 * 500 + 1/4 * |1000 - 500| = 500
+	 * SRTT = 7/8 * 1000 + 1/8 * 500 = 937.5
+	 */
+	send_segments(1);
+	tcp.rtt_start -= 500U;
+	ack(ISN + 2 * MSS);
+
+	srtt = tcp.srtt >> 3;
+	rto = net_tcp_cc_rto(&tcp);
+	zassert_true(srtt >= 937U && srtt <= 938U, "srtt %u", srtt);
+	zassert_true(tcp.rttvar >= 1999U && tcp.rttvar <= 2003U,
+		     "rttvar %u", tcp.rttvar >> 2);
+	zassert_true(rto >= 2936U && rto <= 2941U, "rto %u", rto);
+
+	/* Karn's algorithm, no sample from retransmitted data */
+	send_segments(1);
+	tcp.rtt_start -= 5000U;
+	net_tcp_cc_retransmitted(&tcp);
+	ack(ISN + 3 * MSS);
+	zassert_equal(tcp.srtt >> 3, srtt, "sample taken");
+	zassert_equal(net_tcp_cc_rto(&tcp), rto, "rto changed");
+
+	/* Section 2.4, RTO is never below the minimum */
+	setup(&net_tcp_cc_newreno);
+	send_segments(1);
+	tcp.rtt_start -= 10U;
+	ack(ISN + MSS);
+	zassert_equal(net_tcp_cc_rto(&tcp), RTO_MIN, "rto %u",
+		      net_tcp_cc_rto(&tcp));
+}
+
+static void test_rto_backoff(void)
+{
+	setup(&net_tcp_cc_newreno);
+	tcp.rto = 3000U;
+
+	/* RFC 6298 section 5.5, doubled per retransmission ... */
+	tcp.retry_timeout_shift = 1U;
+	zassert_equal(net_tcp_cc_rto(&tcp), 6000U, "first backoff");
+	tcp.retry_timeout_shift = 2U;
+	zassert_equal(net_tcp_cc_rto(&tcp), 12000U, "second backoff");
+
+	/* ... up to the 60 s maximum of section 2.5 */
+	tcp.retry_timeout_shift = 5U;
+	zassert_equal(net_tcp_cc_rto(&tcp), 60000U, "backoff not limited");
+
+	/* Section 5.7, back to the computed value once data is acked */
+	tcp.retry_timeout_shift = 0U;
+	zassert_equal(net_tcp_cc_rto(&tcp), 3000U, "backoff kept");
+}
+
+static void test_cubic(void)
+{
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	u32_t cwnd;
+
+	setup(&net_tcp_cc_cubic);
+	tcp.cwnd = 60 * MSS;
+
+	send_segments(60);
+	dup_ack();
+	dup_ack();
+	zassert_true(dup_ack(), "no fast retransmit");
+
+	/* RFC 8312 section 4.5, beta = 0.7 */
+	zassert_equal(tcp.ssthresh, 60 * MSS * 717 / 1024, "ssthresh %u",
+		      tcp.ssthresh);
+	zassert_equal(tcp.cubic.w_max, 60 * MSS, "W_max %u",
+		      tcp.cubic.w_max);
+
+	/* Leave recovery with cwnd = ssthresh, RFC 6582 option 2 */
+	ack(ISN + 60 * MSS);
+	tcp.cwnd = tcp.ssthresh;
+
+	send_segments(3);
+
+	/* The first ACK starts the epoch, with section 4.1 giving
+	 * K = cbrt(W_max * (1 - beta) / C) = cbrt(45) = 3.557 s,
+	 * and W(0) = cwnd.
+	 */
+	ack(ISN + 61 * MSS);
+	zassert_equal(tcp.cubic.k, 3556U, "K %u", tcp.cubic.k);
+	zassert_equal(tcp.cubic.origin, 60 * MSS, "origin %u",
+		      tcp.cubic.origin);
+	zassert_true(tcp.cwnd - tcp.ssthresh <= 1U, "cwnd %u", tcp.cwnd);
+
+	/* W(K) = W_max, cwnd grows by (W_max - cwnd) / cwnd per
+	 * acknowledged byte.
+	 */
+	cwnd = tcp.cwnd;
+	tcp.cubic.epoch = k_uptime_get_32() - tcp.cubic.k;
+	ack(ISN + 62 * MSS);
+	zassert_equal(tcp.cwnd - cwnd, 428U, "cwnd %u", tcp.cwnd);
+
+	/* W(K + 2 s) = W_max + C * 2^3 segments = 63200 bytes */
+	cwnd = tcp.cwnd;
+	tcp.cubic.epoch = k_uptime_get_32() - tcp.cubic.k - 2000U;
+	ack(ISN + 63 * MSS);
+	zassert_equal(tcp.cwnd - cwnd, 489U, "cwnd %u", tcp.cwnd);
+#else
+	ztest_test_skip();
+#endif
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_cc,
+			 ztest_unit_test(test_slow_start),
+			 ztest_unit_test(test_congestion_avoidance),
+			 ztest_unit_test(test_fast_recovery),
+			 ztest_unit_test(test_timeout),
+			 ztest_unit_test(test_rtt),
+			 ztest_unit_test(test_rto_backoff),
+			 ztest_unit_test(test_cubic));
+
+	ztest_run_test_suite(net_tcp_cc);
+}
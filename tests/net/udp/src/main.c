@@ -423,7 +423,7 @@ void test_udp(void)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface = net_if_get_default();
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud_listen;
 	int ret, i = 0;
 	bool st;
 
@@ -633,6 +633,17 @@ void test_udp(void)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 
+	/* Listening and connected handlers on the same local port are in
+	 * different lookup tiers, the connected one must win for its peer.
+	 */
+	ud_listen = REGISTER(AF_INET6, NULL, &my_addr6, 0, 5683);
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 2000, 5683);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 2000, 5683);
+	TEST_IPV6_OK(ud_listen, &in6addr_peer, &in6addr_my, 2001, 5683);
+	UNREGISTER(ud);
+	TEST_IPV6_OK(ud_listen, &in6addr_peer, &in6addr_my, 2000, 5683);
+	UNREGISTER(ud_listen);
+
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
 	REGISTER(AF_INET, &my_addr4, NULL, 1234, 4242);
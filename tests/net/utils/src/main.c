@@ -830,11 +830,104 @@ void test_addr_parse(void)
 #endif
 }
 
+/* Reference checksum, summing the data byte after byte */
+static u32_t chksum_ref(u32_t sum, const u8_t *data, size_t len,
+			size_t *offset)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++, (*offset)++) {
+		sum += (*offset % 2) ? data[i] : data[i] << 8;
+	}
+
+	return sum;
+}
+
+static u16_t chksum_ref_pkt(struct net_pkt *pkt, u8_t proto)
+{
+	struct net_buf *frag = pkt->buffer;
+	size_t offset = 0;
+	u32_t sum;
+
+	/* Pseudo header: addresses, protocol and length */
+	sum = chksum_ref(0U, frag->data + NET_IPV4H_LEN - 8, 8, &offset);
+	sum += proto + net_pkt_get_len(pkt) - NET_IPV4H_LEN;
+
+	offset = 0;
+	sum = chksum_ref(sum, frag->data + NET_IPV4H_LEN,
+			 frag->len - NET_IPV4H_LEN, &offset);
+
+	for (frag = frag->frags; frag; frag = frag->frags) {
+		sum = chksum_ref(sum, frag->data, frag->len, &offset);
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~htons(sum);
+}
+
+void test_chksum(void)
+{
+	/* IPv4 header and payload split in fragments of odd lengths, so
+	 * that the payload is summed from both odd and even addresses.
+	 */
+	static const size_t lens[] = { NET_IPV4H_LEN + 7, 61, 100, 1 };
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	u16_t chksum;
+	u32_t old_val;
+	u8_t *field;
+	int i, j;
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	for (i = 0; i < ARRAY_SIZE(lens); i++) {
+		frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+		zassert_not_null(frag, "Cannot allocate frag");
+
+		for (j = 0; j < lens[i]; j++) {
+			net_buf_add_u8(frag, (u8_t)(i * 37 + j * 13 + 1));
+		}
+
+		net_pkt_frag_add(pkt, frag);
+	}
+
+	chksum = net_calc_chksum(pkt, IPPROTO_UDP);
+	zassert_equal(chksum, chksum_ref_pkt(pkt, IPPROTO_UDP),
+		      "Wrong checksum");
+
+	/* Rewrite 16 and 32-bit fields at even payload offsets and
+	 * update the checksum incrementally.
+	 */
+	field = pkt->buffer->data + NET_IPV4H_LEN + 2;
+	old_val = sys_get_be16(field);
+	sys_put_be16(0xfedc, field);
+	chksum = net_chksum_update_u16(chksum, old_val, 0xfedc);
+	zassert_equal(chksum, net_calc_chksum(pkt, IPPROTO_UDP),
+		      "Wrong 16-bit checksum update");
+
+	field = pkt->buffer->frags->data + 1;
+	old_val = sys_get_be32(field);
+	sys_put_be32(0x01234567, field);
+	chksum = net_chksum_update_u32(chksum, old_val, 0x01234567);
+	zassert_equal(chksum, net_calc_chksum(pkt, IPPROTO_UDP),
+		      "Wrong 32-bit checksum update");
+
+	net_pkt_unref(pkt);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum));
 
 	ztest_run_test_suite(test_utils_fn);
 }
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <flash.h>
+#include <nvs/nvs.h>
+
+#define SECTOR_COUNT 3
+#define ID_COUNT 64
+#define LATENCY_ROUNDS 32
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+#define CACHE_SIZE CONFIG_NVS_LOOKUP_CACHE_SIZE
+#else
+#define CACHE_SIZE 128
+#endif
+
+/* An id above ID_COUNT that falls in the same lookup cache bucket as id */
+#define ALIAS(id) ((id) + CACHE_SIZE * (ID_COUNT / CACHE_SIZE + 1))
+
+static struct nvs_fs fs;
+
+static void mount(void)
+{
+	int rc;
+
+	rc = nvs_init(&fs, DT_FLASH_DEV_NAME);
+	zassert_equal(rc, 0, "nvs_init failed: %d", rc);
+}
+
+static void test_nvs_init(void)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	fs.offset = DT_FLASH_AREA_STORAGE_OFFSET;
+	rc = flash_get_page_info_by_offs(device_get_binding(DT_FLASH_DEV_NAME),
+					 fs.offset, &info);
+	zassert_equal(rc, 0, "Unable to get page info");
+
+	fs.sector_size = info.size;
+	fs.sector_count = SECTOR_COUNT;
+
+	mount();
+	rc = nvs_clear(&fs);
+	zassert_equal(rc, 0, "nvs_clear failed: %d", rc);
+	mount();
+}
+
+static void write_u32(u16_t id, u32_t value)
+{
+	ssize_t len;
+
+	len = nvs_write(&fs, id, &value, sizeof(value));
+	zassert_true(len == sizeof(value) || len == 0,
+		     "nvs_write failed: %d", len);
+}
+
+static void check_u32(u16_t id, u32_t expected)
+{
+	u32_t value;
+	ssize_t len;
+
+	len = nvs_read(&fs, id, &value, sizeof(value));
+	zassert_equal(len, sizeof(value), "nvs_read %u failed: %d", id, len);
+	zassert_equal(value, expected, "id %u: %u instead of %u", id, value,
+		      expected);
+}
+
+static void test_nvs_write_read(void)
+{
+	u32_t value;
+	ssize_t len;
+
+	for (u16_t id = 1; id <= ID_COUNT; id++) {
+		write_u32(id, id);
+	}
+
+	for (u16_t id = 1; id <= ID_COUNT; id++) {
+		check_u32(id, id);
+	}
+
+	/* ids never written */
+	len = nvs_read(&fs, ID_COUNT + 1, &value, sizeof(value));
+	zassert_equal(len, -ENOENT, "unexpected entry: %d", len);
+	len = nvs_read(&fs, 1000, &value, sizeof(value));
+	zassert_equal(len, -ENOENT, "unexpected entry: %d", len);
+
+	write_u32(1, 100);
+	check_u32(1, 100);
+
+	len = nvs_read_hist(&fs, 1, &value, sizeof(value), 1);
+	zassert_equal(len, sizeof(value), "nvs_read_hist failed: %d", len);
+	zassert_equal(value, 1, "wrong history value %u", value);
+
+	zassert_equal(nvs_delete(&fs, 2), 0, "nvs_delete failed");
+	len = nvs_read(&fs, 2, &value, sizeof(value));
+	zassert_equal(len, -ENOENT, "deleted entry found: %d", len);
+
+	/* ids sharing a cache bucket with a stored and a deleted id */
+	len = nvs_read(&fs, ALIAS(1), &value, sizeof(value));
+	zassert_equal(len, -ENOENT, "unexpected entry: %d", len);
+
+	write_u32(ALIAS(1), 200);
+	write_u32(ALIAS(2), 300);
+	check_u32(ALIAS(1), 200);
+	check_u32(ALIAS(2), 300);
+	check_u32(1, 100);
+	len = nvs_read(&fs, 2, &value, sizeof(value));
+	zassert_equal(len, -ENOENT, "deleted entry found: %d", len);
+}
+
+static void test_nvs_gc(void)
+{
+	u32_t rounds;
+
+	/* rewrite all ids until every sector was garbage collected twice */
+	rounds = 2 * SECTOR_COUNT * fs.sector_size / (ID_COUNT * 8) + 1;
+
+	for (u32_t r = 1; r <= rounds; r++) {
+		for (u16_t id = 3; id <= ID_COUNT; id++) {
+			write_u32(id, id + (r << 16));
+		}
+	}
+
+	/* entries written once have been moved by gc */
+	check_u32(1, 100);
+	check_u32(ALIAS(1), 200);
+	check_u32(ALIAS(2), 300);
+
+	for (u16_t id = 3; id <= ID_COUNT; id++) {
+		check_u32(id, id + (rounds << 16));
+	}
+
+	/* remount, rebuilding any RAM state */
+	mount();
+	check_u32(1, 100);
+	check_u32(ALIAS(1), 200);
+	check_u32(ALIAS(2), 300);
+	for (u16_t id = 3; id <= ID_COUNT; id++) {
+		check_u32(id, id + (rounds << 16));
+	}
+}
+
+static void test_nvs_read_latency(void)
+{
+	u32_t start, cycles, value;
+
+	/* id 1 is the oldest entry, the worst case for a walk */
+	start = k_cycle_get_32();
+	for (int i = 0; i < LATENCY_ROUNDS; i++) {
+		(void)nvs_read(&fs, 1, &value, sizeof(value));
+	}
+	cycles = (k_cycle_get_32() - start) / LATENCY_ROUNDS;
+
+	TC_PRINT("nvs_read of oldest of %d ids: %u cycles (%u us)\n",
+		 ID_COUNT, cycles, SYS_CLOCK_HW_CYCLES_TO_NS(cycles) / 1000U);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < LATENCY_ROUNDS; i++) {
+		(void)nvs_read(&fs, ID_COUNT, &value, sizeof(value));
+	}
+	cycles = (k_cycle_get_32() - start) / LATENCY_ROUNDS;
+
+	TC_PRINT("nvs_read of newest of %d ids: %u cycles (%u us)\n",
+		 ID_COUNT, cycles, SYS_CLOCK_HW_CYCLES_TO_NS(cycles) / 1000U);
+}
+
+static void test_nvs_gc_stats(void)
+{
+	struct nvs_gc_stats stats;
+	int rc;
+
+	rc = nvs_gc_stats_get(&fs, &stats);
+	zassert_equal(rc, 0, "nvs_gc_stats_get failed: %d", rc);
+
+	/* counters restarted with the remount in test_nvs_gc */
+	for (u32_t r = 1; stats.sectors < 2 * SECTOR_COUNT; r++) {
+		for (u16_t id = 3; id <= ID_COUNT; id++) {
+			write_u32(id, id + (r << 8));
+		}
+		rc = nvs_gc_stats_get(&fs, &stats);
+		zassert_equal(rc, 0, "nvs_gc_stats_get failed: %d", rc);
+	}
+
+	zassert_true(stats.moved > 0, "no entry moved");
+	zassert_true(stats.max_stall_us <= stats.stall_us, "");
+
+	if (IS_ENABLED(CONFIG_NVS_INCREMENTAL_GC)) {
+		for (int i = 0; stats.active && i < 100; i++) {
+			k_sleep(K_MSEC(10));
+			rc = nvs_gc_stats_get(&fs, &stats);
+			zassert_equal(rc, 0, "nvs_gc_stats_get failed: %d", rc);
+		}
+		zassert_false(stats.active, "gc did not complete");
+		zassert_equal(stats.remaining, 0, "");
+	} else {
+		/* every sector collection is a stall */
+		zassert_true(stats.stalls >= stats.sectors, "");
+	}
+
+	TC_PRINT("gc: %u sectors, %u moved, %u stalls, %u us total, "
+		 "%u us max\n", stats.sectors, stats.moved, stats.stalls,
+		 stats.stall_us, stats.max_stall_us);
+
+	check_u32(1, 100);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_nvs,
+			 ztest_unit_test(test_nvs_init),
+			 ztest_unit_test(test_nvs_write_read),
+			 ztest_unit_test(test_nvs_gc),
+			 ztest_unit_test(test_nvs_gc_stats),
+			 ztest_unit_test(test_nvs_read_latency));
+
+	ztest_run_test_suite(test_nvs);
+}
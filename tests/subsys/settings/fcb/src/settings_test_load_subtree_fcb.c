@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "settings_test.h"
+#include "settings/settings_fcb.h"
+
+void test_config_load_subtree_fcb(void)
+{
+	int rc;
+	struct settings_fcb cf;
+
+	config_wipe_srcs();
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	cf.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf.cf_fcb.f_sectors = fcb_sectors;
+	cf.cf_fcb.f_sector_cnt = ARRAY_SIZE(fcb_sectors);
+
+	rc = settings_fcb_src(&cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+
+	rc = settings_fcb_dst(&cf);
+	zassert_true(rc == 0,
+			 "can't register FCB as configuration destination");
+
+	val8 = 55U;
+	val32 = 0x12345678;
+	rc = settings_save();
+	zassert_true(rc == 0, "fcb write error");
+
+	val8 = 0U;
+	val32 = 0U;
+
+	/* A prefix of a subtree name is not that subtree */
+	ctest_clear_call_state();
+	rc = settings_load_subtree("myfo");
+	zassert_true(rc != 0, "no handler for subtree expected");
+	zassert_true(test_set_called == 0, "handler called");
+
+	ctest_clear_call_state();
+	rc = settings_load_subtree("myfoo");
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(test_set_called == 1, "set handler not called");
+	zassert_true(test_commit_called == 1, "commit handler not called");
+	zassert_true(val8 == 55U, "bad value read");
+	zassert_true(val32 == 0U, "other subtree loaded");
+
+	val8 = 0U;
+	ctest_clear_call_state();
+	rc = settings_load_subtree("myfoo/mybar");
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val8 == 55U, "bad value read");
+
+	rc = settings_load_subtree("3");
+	zassert_true(rc == 0, "fcb read error");
+	zassert_true(val32 == 0x12345678, "bad value read");
+}